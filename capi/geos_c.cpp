@@ -17,6 +17,9 @@
 
 #include <geos/geom/prep/PreparedGeometryFactory.h> 
 #include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/MappedSTRtree.h>
+#include <geos/index/rtree/RStarTree.h>
+#include <geos/index/kdtree/KdTree.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTWriter.h>
@@ -35,6 +38,9 @@
 #define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSSTRtree geos::index::strtree::STRtree
+#define GEOSMappedSTRtree geos::index::strtree::MappedSTRtree
+#define GEOSRStarTree geos::index::rtree::RStarTree
+#define GEOSKdTree geos::index::kdtree::KdTree
 #define GEOSWKTReader_t geos::io::WKTReader
 #define GEOSWKTWriter_t geos::io::WKTWriter
 #define GEOSWKBReader_t geos::io::WKBReader
@@ -266,6 +272,48 @@ GEOSHausdorffDistanceDensify(const Geometry *g1, const Geometry *g2, double dens
     return GEOSHausdorffDistanceDensify_r( handle, g1, g2, densifyFrac, dist );
 }
 
+char
+GEOSDWithin(const Geometry *g1, const Geometry *g2, double dist)
+{
+    return GEOSDWithin_r( handle, g1, g2, dist );
+}
+
+char
+GEOSHausdorffDistanceWithin(const Geometry *g1, const Geometry *g2, double threshold)
+{
+    return GEOSHausdorffDistanceWithin_r( handle, g1, g2, threshold );
+}
+
+char
+GEOSHausdorffDistanceDensifyWithin(const Geometry *g1, const Geometry *g2, double densifyFrac, double threshold)
+{
+    return GEOSHausdorffDistanceDensifyWithin_r( handle, g1, g2, densifyFrac, threshold );
+}
+
+int
+GEOSFrechetDistance(const Geometry *g1, const Geometry *g2, double *dist)
+{
+    return GEOSFrechetDistance_r( handle, g1, g2, dist );
+}
+
+int
+GEOSFrechetDistanceDensify(const Geometry *g1, const Geometry *g2, double densifyFrac, double *dist)
+{
+    return GEOSFrechetDistanceDensify_r( handle, g1, g2, densifyFrac, dist );
+}
+
+char
+GEOSFrechetDistanceWithin(const Geometry *g1, const Geometry *g2, double threshold)
+{
+    return GEOSFrechetDistanceWithin_r( handle, g1, g2, threshold );
+}
+
+char
+GEOSFrechetDistanceDensifyWithin(const Geometry *g1, const Geometry *g2, double densifyFrac, double threshold)
+{
+    return GEOSFrechetDistanceDensifyWithin_r( handle, g1, g2, densifyFrac, threshold );
+}
+
 int
 GEOSArea(const Geometry *g, double *area)
 {
@@ -1058,6 +1106,13 @@ GEOSPreparedWithin(const geos::geom::prep::PreparedGeometry *pg1, const Geometry
     return GEOSPreparedWithin_r( handle, pg1, g2 );
 }
 
+int
+GEOSPreparedLocatePoints(const geos::geom::prep::PreparedGeometry *pg,
+                         const double *xy, unsigned int n, int *locations)
+{
+    return GEOSPreparedLocatePoints_r( handle, pg, xy, n, locations );
+}
+
 STRtree *
 GEOSSTRtree_create (size_t nodeCapacity)
 {
@@ -1072,6 +1127,12 @@ GEOSSTRtree_insert (geos::index::strtree::STRtree *tree,
     GEOSSTRtree_insert_r( handle, tree, g, item );
 }
 
+int
+GEOSSTRtree_build (geos::index::strtree::STRtree *tree)
+{
+    return GEOSSTRtree_build_r( handle, tree );
+}
+
 void
 GEOSSTRtree_query (geos::index::strtree::STRtree *tree,
                    const geos::geom::Geometry *g, 
@@ -1081,6 +1142,42 @@ GEOSSTRtree_query (geos::index::strtree::STRtree *tree,
     GEOSSTRtree_query_r( handle, tree, g, cb, userdata );
 }
 
+int
+GEOSSTRtree_query_many (geos::index::strtree::STRtree *tree,
+                        const geos::geom::Geometry *const *geoms,
+                        unsigned int n,
+                        GEOSQueryManyCallback cb,
+                        void *userdata,
+                        size_t *count)
+{
+    return GEOSSTRtree_query_many_r( handle, tree, geoms, n, cb, userdata,
+                                     count );
+}
+
+int
+GEOSSTRtree_query_statistics (geos::index::strtree::STRtree *tree,
+                              const geos::geom::Geometry *g,
+                              GEOSQueryCallback cb,
+                              void *userdata,
+                              unsigned int *nodesVisited,
+                              unsigned int *leavesTested)
+{
+    return GEOSSTRtree_query_statistics_r( handle, tree, g, cb, userdata,
+                                           nodesVisited, leavesTested );
+}
+
+int
+GEOSSTRtree_statistics (geos::index::strtree::STRtree *tree,
+                        unsigned int *depth,
+                        unsigned int *numNodes,
+                        double *fillFactor,
+                        double *overlapArea,
+                        size_t *memorySize)
+{
+    return GEOSSTRtree_statistics_r( handle, tree, depth, numNodes,
+                                     fillFactor, overlapArea, memorySize );
+}
+
 void 
 GEOSSTRtree_iterate(geos::index::strtree::STRtree *tree,
                     GEOSQueryCallback callback,
@@ -1097,12 +1194,134 @@ GEOSSTRtree_remove (geos::index::strtree::STRtree *tree,
     return GEOSSTRtree_remove_r( handle, tree, g, item );
 }
 
+int
+GEOSSTRtree_nearest (geos::index::strtree::STRtree *tree,
+                     const void *item,
+                     const geos::geom::Geometry *g,
+                     unsigned int k,
+                     GEOSDistanceCallback distancefn,
+                     GEOSQueryCallback callback,
+                     void *userdata)
+{
+    return GEOSSTRtree_nearest_r( handle, tree, item, g, k, distancefn,
+                                  callback, userdata );
+}
+
 void
 GEOSSTRtree_destroy (geos::index::strtree::STRtree *tree)
 {
     GEOSSTRtree_destroy_r( handle, tree );
 }
 
+int
+GEOSSTRtree_write (geos::index::strtree::STRtree *tree,
+                   const char *filename,
+                   GEOSItemIdCallback idfn,
+                   void *userdata)
+{
+    return GEOSSTRtree_write_r( handle, tree, filename, idfn, userdata );
+}
+
+geos::index::strtree::MappedSTRtree *
+GEOSMappedSTRtree_open (const char *filename)
+{
+    return GEOSMappedSTRtree_open_r( handle, filename );
+}
+
+int
+GEOSMappedSTRtree_query (const geos::index::strtree::MappedSTRtree *tree,
+                         const geos::geom::Geometry *g,
+                         GEOSItemIdQueryCallback callback,
+                         void *userdata)
+{
+    return GEOSMappedSTRtree_query_r( handle, tree, g, callback, userdata );
+}
+
+void
+GEOSMappedSTRtree_destroy (geos::index::strtree::MappedSTRtree *tree)
+{
+    GEOSMappedSTRtree_destroy_r( handle, tree );
+}
+
+GEOSRStarTree *
+GEOSRStarTree_create (size_t nodeCapacity)
+{
+    return GEOSRStarTree_create_r( handle, nodeCapacity );
+}
+
+void
+GEOSRStarTree_insert (geos::index::rtree::RStarTree *tree,
+                      const geos::geom::Geometry *g,
+                      void *item)
+{
+    GEOSRStarTree_insert_r( handle, tree, g, item );
+}
+
+void
+GEOSRStarTree_query (geos::index::rtree::RStarTree *tree,
+                     const geos::geom::Geometry *g,
+                     GEOSQueryCallback cb,
+                     void *userdata)
+{
+    GEOSRStarTree_query_r( handle, tree, g, cb, userdata );
+}
+
+char
+GEOSRStarTree_remove (geos::index::rtree::RStarTree *tree,
+                      const geos::geom::Geometry *g,
+                      void *item)
+{
+    return GEOSRStarTree_remove_r( handle, tree, g, item );
+}
+
+void
+GEOSRStarTree_destroy (geos::index::rtree::RStarTree *tree)
+{
+    GEOSRStarTree_destroy_r( handle, tree );
+}
+
+GEOSKdTree *
+GEOSKdTree_create (double tolerance)
+{
+    return GEOSKdTree_create_r( handle, tolerance );
+}
+
+unsigned int
+GEOSKdTree_insert (geos::index::kdtree::KdTree *tree,
+                   double x, double y,
+                   void *item)
+{
+    return GEOSKdTree_insert_r( handle, tree, x, y, item );
+}
+
+int
+GEOSKdTree_query (geos::index::kdtree::KdTree *tree,
+                  const geos::geom::Geometry *g,
+                  GEOSKdTreeQueryCallback cb,
+                  void *userdata)
+{
+    return GEOSKdTree_query_r( handle, tree, g, cb, userdata );
+}
+
+void
+GEOSKdTree_destroy (geos::index::kdtree::KdTree *tree)
+{
+    GEOSKdTree_destroy_r( handle, tree );
+}
+
+int
+GEOSSpatialJoin (const geos::geom::Geometry *const *geoms1,
+                 unsigned int ngeoms1,
+                 const geos::geom::Geometry *const *geoms2,
+                 unsigned int ngeoms2,
+                 int predicate,
+                 GEOSJoinCallback callback,
+                 void *userdata)
+{
+    return GEOSSpatialJoin_r( handle, geoms1, ngeoms1, geoms2, ngeoms2,
+                              predicate, callback, userdata );
+}
+
 double
 GEOSProject (const geos::geom::Geometry *g,
              const geos::geom::Geometry *p)
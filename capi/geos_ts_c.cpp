@@ -20,6 +20,8 @@
 #include <geos/geom/Geometry.h> 
 #include <geos/geom/prep/PreparedGeometry.h> 
 #include <geos/geom/prep/PreparedGeometryFactory.h> 
+#include <geos/geom/prep/PreparedPolygon.h>
+#include <geos/algorithm/locate/PointOnGeometryLocator.h>
 #include <geos/geom/GeometryCollection.h> 
 #include <geos/geom/Polygon.h> 
 #include <geos/geom/Point.h> 
@@ -35,11 +37,23 @@
 #include <geos/geom/IntersectionMatrix.h> 
 #include <geos/geom/Envelope.h> 
 #include <geos/index/strtree/STRtree.h> 
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/strtree/BatchQueryVisitor.h>
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/MappedSTRtree.h>
+#include <geos/index/rtree/RStarTree.h>
+#include <geos/index/kdtree/KdTree.h>
+#include <geos/index/kdtree/KdNode.h>
+#include <geos/index/kdtree/KdNodeVisitor.h>
 #include <geos/index/ItemVisitor.h>
+#include <geos/index/IndexStatistics.h>
+#include <geos/index/QueryStatistics.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTWriter.h>
 #include <geos/io/WKBWriter.h>
+#include <geos/algorithm/distance/DiscreteFrechetDistance.h>
 #include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
 #include <geos/algorithm/CGAlgorithms.h>
 #include <geos/algorithm/BoundaryNodeRule.h>
@@ -54,9 +68,12 @@
 #include <geos/operation/buffer/BufferParameters.h>
 #include <geos/operation/buffer/BufferBuilder.h>
 #include <geos/operation/relate/RelateOp.h>
+#include <geos/operation/distance/DistanceOp.h>
 #include <geos/operation/sharedpaths/SharedPathsOp.h>
+#include <geos/operation/predicate/SpatialJoin.h>
 #include <geos/linearref/LengthIndexedLine.h>
 #include <geos/geom/BinaryOp.h>
+#include <geos/util/GEOSException.h>
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/util/UniqueCoordinateArrayFilter.h>
 #include <geos/util/Machine.h>
@@ -72,6 +89,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <memory>
 
 #ifdef _MSC_VER
@@ -85,6 +103,9 @@
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSBufferParams geos::operation::buffer::BufferParameters
 #define GEOSSTRtree geos::index::strtree::STRtree
+#define GEOSMappedSTRtree geos::index::strtree::MappedSTRtree
+#define GEOSRStarTree geos::index::rtree::RStarTree
+#define GEOSKdTree geos::index::kdtree::KdTree
 #define GEOSWKTReader_t geos::io::WKTReader
 #define GEOSWKTWriter_t geos::io::WKTWriter
 #define GEOSWKBReader_t geos::io::WKBReader
@@ -123,6 +144,7 @@ using geos::operation::geounion::CascadedPolygonUnion;
 using geos::operation::buffer::BufferParameters;
 using geos::operation::buffer::BufferBuilder;
 using geos::util::IllegalArgumentException;
+using geos::algorithm::distance::DiscreteFrechetDistance;
 using geos::algorithm::distance::DiscreteHausdorffDistance;
 
 typedef std::auto_ptr<Geometry> GeomAutoPtr;
@@ -149,6 +171,91 @@ class CAPI_ItemVisitor : public geos::index::ItemVisitor {
     void visitItem (void *item) { callback(item, userdata); }
 };
 
+// CAPI_ItemDistance is used internally by GEOSSTRtree_nearest_r,
+// for the same reason.
+class CAPI_ItemDistance : public geos::index::strtree::ItemDistance {
+    GEOSDistanceCallback distancefn;
+    void *userdata;
+  public:
+    CAPI_ItemDistance (GEOSDistanceCallback fn, void *ud)
+        : distancefn(fn), userdata(ud) {}
+    double distance (const geos::index::strtree::ItemBoundable* item1,
+                     const geos::index::strtree::ItemBoundable* item2)
+    {
+        double d;
+        if ( 0 == distancefn(item1->getItem(), item2->getItem(),
+                             &d, userdata) )
+        {
+            throw geos::util::GEOSException("Failed to compute distance");
+        }
+        return d;
+    }
+};
+
+
+// CAPI_ItemIdentifier is used internally by GEOSSTRtree_write_r,
+// for the same reason.
+class CAPI_ItemIdentifier
+    : public geos::index::strtree::MappedSTRtree::ItemIdentifier {
+    GEOSItemIdCallback idfn;
+    void *userdata;
+  public:
+    CAPI_ItemIdentifier (GEOSItemIdCallback fn, void *ud)
+        : idfn(fn), userdata(ud) {}
+    int64 getId (void *item) { return idfn(item, userdata); }
+};
+
+// CAPI_BatchQueryVisitor is used internally by GEOSSTRtree_query_many_r,
+// for the same reason.
+class CAPI_BatchQueryVisitor
+    : public geos::index::strtree::BatchQueryVisitor {
+    GEOSQueryManyCallback callback;
+    void *userdata;
+  public:
+    std::size_t count;
+    CAPI_BatchQueryVisitor (GEOSQueryManyCallback cb, void *ud)
+        : callback(cb), userdata(ud), count(0) {}
+    void visitItem (std::size_t queryIndex, void *item)
+    {
+        ++count;
+        callback(static_cast<unsigned int>(queryIndex), item, userdata);
+    }
+};
+
+// CAPI_JoinVisitor is used internally by GEOSSpatialJoin_r,
+// for the same reason.
+class CAPI_JoinVisitor
+    : public geos::operation::predicate::SpatialJoin::PairVisitor {
+    GEOSJoinCallback callback;
+    void *userdata;
+  public:
+    CAPI_JoinVisitor (GEOSJoinCallback cb, void *ud)
+        : callback(cb), userdata(ud) {}
+    void visitPair (std::size_t index1, std::size_t index2)
+    {
+        callback(static_cast<unsigned int>(index1),
+                 static_cast<unsigned int>(index2), userdata);
+    }
+};
+
+// CAPI_KdNodeVisitor is used internally by GEOSKdTree_query_r,
+// for the same reason.
+class CAPI_KdNodeVisitor : public geos::index::kdtree::KdNodeVisitor {
+    GEOSKdTreeQueryCallback callback;
+    void *userdata;
+  public:
+    std::size_t count;
+    CAPI_KdNodeVisitor (GEOSKdTreeQueryCallback cb, void *ud)
+        : callback(cb), userdata(ud), count(0) {}
+    void visit (geos::index::kdtree::KdNode *node)
+    {
+        ++count;
+        callback(node->getX(), node->getY(),
+                 static_cast<unsigned int>(node->getCount()),
+                 node->getData(), userdata);
+    }
+};
+
 
 //## PROTOTYPES #############################################
 
@@ -1075,6 +1182,235 @@ GEOSHausdorffDistanceDensify_r(GEOSContextHandle_t extHandle, const Geometry *g1
     return 0;
 }
 
+char
+GEOSDWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double dist)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        using geos::operation::distance::DistanceOp;
+        bool result = DistanceOp::isWithinDistance(*g1, *g2, dist);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
+char
+GEOSHausdorffDistanceWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double threshold)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = DiscreteHausdorffDistance::isHausdorffWithin(*g1, *g2, threshold);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
+char
+GEOSHausdorffDistanceDensifyWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double densifyFrac, double threshold)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = DiscreteHausdorffDistance::isHausdorffWithin(*g1, *g2, densifyFrac, threshold);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
+int
+GEOSFrechetDistance_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double *dist)
+{
+    assert(0 != dist);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        *dist = DiscreteFrechetDistance::distance(*g1, *g2);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 0;
+}
+
+int
+GEOSFrechetDistanceDensify_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double densifyFrac, double *dist)
+{
+    assert(0 != dist);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        *dist = DiscreteFrechetDistance::distance(*g1, *g2, densifyFrac);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 0;
+}
+
+char
+GEOSFrechetDistanceWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double threshold)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = DiscreteFrechetDistance::isFrechetWithin(*g1, *g2, threshold);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
+char
+GEOSFrechetDistanceDensifyWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double densifyFrac, double threshold)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = DiscreteFrechetDistance::isFrechetWithin(*g1, *g2, densifyFrac, threshold);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
 int
 GEOSArea_r(GEOSContextHandle_t extHandle, const Geometry *g, double *area)
 {
@@ -5382,14 +5718,17 @@ GEOSPreparedWithin_r(GEOSContextHandle_t extHandle,
     return 2;
 }
 
-//-----------------------------------------------------------------
-// STRtree
-//-----------------------------------------------------------------
-
-geos::index::strtree::STRtree *
-GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
-                                  size_t nodeCapacity)
+int
+GEOSPreparedLocatePoints_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg,
+        const double *xy, unsigned int n, int *locations)
 {
+    using geos::geom::prep::PreparedPolygon;
+
+    assert(0 != pg);
+    assert(0 != xy || 0 == n);
+    assert(0 != locations || 0 == n);
+
     if ( 0 == extHandle )
     {
         return 0;
@@ -5402,7 +5741,52 @@ GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
         return 0;
     }
 
-    geos::index::strtree::STRtree *tree = 0;
+    try
+    {
+        const PreparedPolygon *prepPoly =
+            dynamic_cast<const PreparedPolygon*>(pg);
+        if ( ! prepPoly )
+        {
+            handle->ERROR_MESSAGE("Prepared geometry must be polygonal");
+            return 0;
+        }
+        if ( n > 0 )
+            prepPoly->getPointLocator()->locateAll(xy, n, locations);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------
+// STRtree
+//-----------------------------------------------------------------
+
+geos::index::strtree::STRtree *
+GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
+                                  size_t nodeCapacity)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    geos::index::strtree::STRtree *tree = 0;
 
     try
     {
@@ -5466,6 +5850,41 @@ GEOSSTRtree_insert_r(GEOSContextHandle_t extHandle,
     }
 }
 
+int
+GEOSSTRtree_build_r(GEOSContextHandle_t extHandle,
+                    geos::index::strtree::STRtree *tree)
+{
+    assert(tree != 0);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        tree->build();
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
 void 
 GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
                     geos::index::strtree::STRtree *tree,
@@ -5481,7 +5900,16 @@ GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
     try
     {
         CAPI_ItemVisitor visitor(callback, userdata);
-        tree->query(g->getEnvelopeInternal(), visitor);
+        if ( tree->isBuilt() )
+        {
+            // read-only, for concurrent queries
+            const geos::index::strtree::STRtree& builtTree = *tree;
+            builtTree.query(g->getEnvelopeInternal(), visitor);
+        }
+        else
+        {
+            tree->query(g->getEnvelopeInternal(), visitor);
+        }
     }
     catch (const std::exception &e)
     {
@@ -5515,6 +5943,154 @@ GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
     }
 }
 
+int
+GEOSSTRtree_query_many_r(GEOSContextHandle_t extHandle,
+                         geos::index::strtree::STRtree *tree,
+                         const geos::geom::Geometry *const *geoms,
+                         unsigned int n,
+                         GEOSQueryManyCallback callback,
+                         void *userdata,
+                         size_t *count)
+{
+    assert(tree != 0);
+    assert(callback != 0);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        std::vector<geos::geom::Envelope> envs(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            // a null envelope for NULL geometries
+            if ( geoms[i] ) envs[i] = *(geoms[i]->getEnvelopeInternal());
+        }
+
+        CAPI_BatchQueryVisitor visitor(callback, userdata);
+        if ( n ) tree->queryMany(&envs[0], n, visitor);
+        if ( count ) *count = visitor.count;
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+int
+GEOSSTRtree_query_statistics_r(GEOSContextHandle_t extHandle,
+                               geos::index::strtree::STRtree *tree,
+                               const geos::geom::Geometry *g,
+                               GEOSQueryCallback callback,
+                               void *userdata,
+                               unsigned int *nodesVisited,
+                               unsigned int *leavesTested)
+{
+    assert(tree != 0);
+    assert(g != 0);
+    assert(callback != 0);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        if ( ! tree->isBuilt() ) tree->build();
+
+        CAPI_ItemVisitor visitor(callback, userdata);
+        geos::index::QueryStatistics stats;
+        const geos::index::strtree::STRtree& builtTree = *tree;
+        builtTree.query(g->getEnvelopeInternal(), visitor, stats);
+
+        if ( nodesVisited )
+            *nodesVisited = static_cast<unsigned int>(stats.numNodesVisited);
+        if ( leavesTested )
+            *leavesTested = static_cast<unsigned int>(stats.numLeavesTested);
+        return static_cast<int>(stats.numItemsReturned);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
+int
+GEOSSTRtree_statistics_r(GEOSContextHandle_t extHandle,
+                         geos::index::strtree::STRtree *tree,
+                         unsigned int *depth,
+                         unsigned int *numNodes,
+                         double *fillFactor,
+                         double *overlapArea,
+                         size_t *memorySize)
+{
+    assert(tree != 0);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        geos::index::IndexStatistics stats = tree->getStatistics();
+
+        if ( depth ) *depth = static_cast<unsigned int>(stats.depth);
+        if ( numNodes ) *numNodes = static_cast<unsigned int>(stats.numNodes);
+        if ( fillFactor ) *fillFactor = stats.fillFactor;
+        if ( overlapArea ) *overlapArea = stats.overlapArea;
+        if ( memorySize ) *memorySize = stats.memorySize;
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
 void 
 GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
                     geos::index::strtree::STRtree *tree,
@@ -5600,6 +6176,57 @@ GEOSSTRtree_remove_r(GEOSContextHandle_t extHandle,
     return 2;
 }
 
+int
+GEOSSTRtree_nearest_r(GEOSContextHandle_t extHandle,
+                      geos::index::strtree::STRtree *tree,
+                      const void *item,
+                      const geos::geom::Geometry *g,
+                      unsigned int k,
+                      GEOSDistanceCallback distancefn,
+                      GEOSQueryCallback callback,
+                      void *userdata)
+{
+    assert(0 != tree);
+    assert(0 != g);
+    assert(0 != distancefn);
+    assert(0 != callback);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        CAPI_ItemDistance itemDist(distancefn, userdata);
+        std::vector<void*> found;
+        tree->nearestNeighbour(g->getEnvelopeInternal(), item, k,
+                               itemDist, found);
+        for (std::size_t i = 0; i < found.size(); ++i)
+        {
+            callback(found[i], userdata);
+        }
+        return static_cast<int>(found.size());
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
 void
 GEOSSTRtree_destroy_r(GEOSContextHandle_t extHandle,
                       geos::index::strtree::STRtree *tree)
@@ -5642,6 +6269,590 @@ GEOSSTRtree_destroy_r(GEOSContextHandle_t extHandle,
     }
 }
 
+int
+GEOSSTRtree_write_r(GEOSContextHandle_t extHandle,
+                    geos::index::strtree::STRtree *tree,
+                    const char *filename,
+                    GEOSItemIdCallback idfn,
+                    void *userdata)
+{
+    using geos::index::strtree::FrozenSTRtree;
+    using geos::index::strtree::MappedSTRtree;
+
+    assert(0 != tree);
+    assert(0 != filename);
+    assert(0 != idfn);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        FrozenSTRtree frozen(*tree);
+        CAPI_ItemIdentifier itemIds(idfn, userdata);
+        MappedSTRtree::write(frozen, itemIds, std::string(filename));
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+geos::index::strtree::MappedSTRtree *
+GEOSMappedSTRtree_open_r(GEOSContextHandle_t extHandle,
+                         const char *filename)
+{
+    assert(0 != filename);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        return new geos::index::strtree::MappedSTRtree(std::string(filename));
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+int
+GEOSMappedSTRtree_query_r(GEOSContextHandle_t extHandle,
+                          const geos::index::strtree::MappedSTRtree *tree,
+                          const geos::geom::Geometry *g,
+                          GEOSItemIdQueryCallback callback,
+                          void *userdata)
+{
+    assert(0 != tree);
+    assert(0 != g);
+    assert(0 != callback);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        std::vector<int64> found;
+        tree->query(g->getEnvelopeInternal(), found);
+        for (std::size_t i = 0; i < found.size(); ++i)
+        {
+            callback(found[i], userdata);
+        }
+        return static_cast<int>(found.size());
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
+void
+GEOSMappedSTRtree_destroy_r(GEOSContextHandle_t extHandle,
+                            geos::index::strtree::MappedSTRtree *tree)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete tree;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+geos::index::rtree::RStarTree *
+GEOSRStarTree_create_r(GEOSContextHandle_t extHandle,
+                       size_t nodeCapacity)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    geos::index::rtree::RStarTree *tree = 0;
+
+    try
+    {
+        tree = new geos::index::rtree::RStarTree(nodeCapacity);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return tree;
+}
+
+void
+GEOSRStarTree_insert_r(GEOSContextHandle_t extHandle,
+                       geos::index::rtree::RStarTree *tree,
+                       const geos::geom::Geometry *g,
+                       void *item)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+    assert(tree != 0);
+    assert(g != 0);
+
+    try
+    {
+        tree->insert(g->getEnvelopeInternal(), item);
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+void 
+GEOSRStarTree_query_r(GEOSContextHandle_t extHandle,
+                      geos::index::rtree::RStarTree *tree,
+                      const geos::geom::Geometry *g,
+                      GEOSQueryCallback callback,
+                      void *userdata)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+    assert(tree != 0);
+    assert(g != 0);
+    assert(callback != 0);
+
+    try
+    {
+        CAPI_ItemVisitor visitor(callback, userdata);
+        tree->query(g->getEnvelopeInternal(), visitor);
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+char
+GEOSRStarTree_remove_r(GEOSContextHandle_t extHandle,
+                       geos::index::rtree::RStarTree *tree,
+                       const geos::geom::Geometry *g,
+                       void *item)
+{
+    assert(0 != tree);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = tree->remove(g->getEnvelopeInternal(), item);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+void
+GEOSRStarTree_destroy_r(GEOSContextHandle_t extHandle,
+                        geos::index::rtree::RStarTree *tree)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete tree;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+geos::index::kdtree::KdTree *
+GEOSKdTree_create_r(GEOSContextHandle_t extHandle,
+                    double tolerance)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    geos::index::kdtree::KdTree *tree = 0;
+
+    try
+    {
+        tree = new geos::index::kdtree::KdTree(tolerance);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return tree;
+}
+
+unsigned int
+GEOSKdTree_insert_r(GEOSContextHandle_t extHandle,
+                    geos::index::kdtree::KdTree *tree,
+                    double x, double y,
+                    void *item)
+{
+    assert(tree != 0);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        geos::index::kdtree::KdNode *node =
+            tree->insert(geos::geom::Coordinate(x, y), item);
+        return static_cast<unsigned int>(node->getCount());
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+int
+GEOSKdTree_query_r(GEOSContextHandle_t extHandle,
+                   geos::index::kdtree::KdTree *tree,
+                   const geos::geom::Geometry *g,
+                   GEOSKdTreeQueryCallback callback,
+                   void *userdata)
+{
+    assert(tree != 0);
+    assert(g != 0);
+    assert(callback != 0);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        CAPI_KdNodeVisitor visitor(callback, userdata);
+        tree->query(*(g->getEnvelopeInternal()), visitor);
+        return static_cast<int>(visitor.count);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
+void
+GEOSKdTree_destroy_r(GEOSContextHandle_t extHandle,
+                     geos::index::kdtree::KdTree *tree)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete tree;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+int
+GEOSSpatialJoin_r(GEOSContextHandle_t extHandle,
+                  const geos::geom::Geometry *const *geoms1,
+                  unsigned int ngeoms1,
+                  const geos::geom::Geometry *const *geoms2,
+                  unsigned int ngeoms2,
+                  int predicate,
+                  GEOSJoinCallback callback,
+                  void *userdata)
+{
+    using geos::operation::predicate::SpatialJoin;
+
+    assert(0 != callback);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        if ( predicate < GEOSJOIN_INTERSECTS || predicate > GEOSJOIN_OVERLAPS )
+        {
+            handle->ERROR_MESSAGE("Invalid join predicate");
+            return -1;
+        }
+
+        std::vector<const Geometry*> g1(geoms1, geoms1 + ngeoms1);
+        std::vector<const Geometry*> g2(geoms2, geoms2 + ngeoms2);
+        SpatialJoin join(g1, g2);
+        CAPI_JoinVisitor visitor(callback, userdata);
+        std::size_t count = join.join(
+            static_cast<SpatialJoin::Predicate>(predicate), visitor);
+        return static_cast<int>(count);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
 double
 GEOSProject_r(GEOSContextHandle_t extHandle,
               const Geometry *g,
@@ -106,14 +106,19 @@ public:
 
 	/// Force computed intersection to be rounded to a given precision model.
 	//
-	/// No getter is provided, because the precision model is not required
-	/// to be specified.
+	/// The precision model is not required to be specified,
+	/// getPrecisionModel() returns NULL when it is not.
 	/// @param precisionModel the PrecisionModel to use for rounding
 	///
 	void setPrecisionModel(const geom::PrecisionModel *newPM) {
 		precisionModel=newPM;
 	}
 
+	/// Returns the precision model used for rounding, or NULL if none
+	const geom::PrecisionModel* getPrecisionModel() const {
+		return precisionModel;
+	}
+
 	/// Compute the intersection of a point p and the line p1-p2.
 	//
 	/// This function computes the boolean value of the hasIntersection test.
@@ -0,0 +1,101 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_ALGORITHM_SEGMENTINTERSECTIONBATCH_H
+#define GEOS_ALGORITHM_SEGMENTINTERSECTIONBATCH_H
+
+#include <geos/export.h>
+#include <cstddef>
+
+#include <geos/geom/Coordinate.h>
+
+namespace geos {
+namespace algorithm { // geos::algorithm
+
+/** \brief
+ * A batch of segment pairs, filtered all at once for the pairs
+ * which may intersect.
+ *
+ * The ordinates are kept in separate arrays and the filters run
+ * as branch-free loops over the whole batch, which compilers can
+ * vectorize. A pair is discarded only if LineIntersector would
+ * find no intersection for it: either the envelopes of its segments
+ * are disjoint, or a floating-point orientation test, whose sign is
+ * trusted only when the rounding error cannot affect it, puts both
+ * ends of a segment on the same side of the other one.
+ *
+ * The pairs which are left, as well as those the orientation test
+ * cannot decide on, are to be handed to LineIntersector.
+ */
+class GEOS_DLL SegmentIntersectionBatch {
+
+public:
+
+	/// Maximum number of pairs in a batch
+	static const std::size_t CAPACITY = 128;
+
+	SegmentIntersectionBatch();
+
+	/** \brief
+	 * Adds the pair of segments p0-p1 and q0-q1.
+	 *
+	 * Must not be called on a full batch.
+	 *
+	 * @return the index of the pair in the batch
+	 */
+	std::size_t add(const geom::Coordinate& p0, const geom::Coordinate& p1,
+	                const geom::Coordinate& q0, const geom::Coordinate& q1);
+
+	std::size_t size() const { return n; }
+
+	bool isEmpty() const { return n == 0; }
+
+	bool isFull() const { return n == CAPACITY; }
+
+	/// Removes all pairs
+	void clear() { n = nCandidates = 0; }
+
+	/** \brief
+	 * Filters the pairs added so far.
+	 *
+	 * @return the number of pairs which may intersect,
+	 *         whose indexes are then given by getCandidate
+	 */
+	std::size_t filter();
+
+	/// @return the index of the i-th pair which may intersect,
+	///         in ascending order
+	std::size_t getCandidate(std::size_t i) const { return candidates[i]; }
+
+private:
+
+	double p0x[CAPACITY], p0y[CAPACITY], p1x[CAPACITY], p1y[CAPACITY];
+	double q0x[CAPACITY], q0y[CAPACITY], q1x[CAPACITY], q1y[CAPACITY];
+
+	/// Set by filter() for the pairs which may intersect
+	unsigned char keep[CAPACITY];
+
+	std::size_t candidates[CAPACITY];
+
+	std::size_t n;
+
+	std::size_t nCandidates;
+
+	// Declare type as noncopyable
+	SegmentIntersectionBatch(const SegmentIntersectionBatch& other);
+	SegmentIntersectionBatch& operator=(const SegmentIntersectionBatch& rhs);
+};
+
+} // namespace geos::algorithm
+} // namespace geos
+
+#endif // GEOS_ALGORITHM_SEGMENTINTERSECTIONBATCH_H
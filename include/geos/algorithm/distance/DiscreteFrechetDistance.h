@@ -0,0 +1,174 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_ALGORITHM_DISTANCE_DISCRETEFRECHETDISTANCE_H
+#define GEOS_ALGORITHM_DISTANCE_DISCRETEFRECHETDISTANCE_H
+
+#include <geos/export.h>
+#include <geos/algorithm/distance/PointPairDistance.h> // for composition
+#include <geos/geom/Coordinate.h> // for composition
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+}
+
+namespace geos {
+namespace algorithm { // geos::algorithm
+namespace distance { // geos::algorithm::distance
+
+/** \brief
+ * An algorithm for computing the discrete Frechet distance between
+ * the sequences of points of two geometries.
+ *
+ * Unlike the Hausdorff distance, the Frechet distance follows the
+ * order of the points: it is the shortest leash allowing to walk
+ * both sequences from their first to their last points, each step
+ * advancing along one or both of them. The points are the
+ * coordinates of the geometries in order, components following
+ * each other, or the segments densified by a given fraction.
+ *
+ * The distances of all pairs of points are swept along the
+ * anti-diagonals of their matrix, keeping the last two, so the
+ * memory used is linear in the number of points. Every walk goes
+ * through one of any two consecutive anti-diagonals, so testing the
+ * distance against a threshold stops at the first two with no pair
+ * reached by a walk within it.
+ *
+ * Also determines the two points separated by the computed distance.
+ */
+class GEOS_DLL DiscreteFrechetDistance
+{
+public:
+
+	static double distance(const geom::Geometry& g0,
+	                       const geom::Geometry& g1);
+
+	static double distance(const geom::Geometry& g0,
+	                       const geom::Geometry& g1, double densifyFrac);
+
+	/**
+	 * Tests whether the discrete Frechet distance between
+	 * g0 and g1 is no more than threshold.
+	 */
+	static bool isFrechetWithin(const geom::Geometry& g0,
+	                            const geom::Geometry& g1, double threshold);
+
+	static bool isFrechetWithin(const geom::Geometry& g0,
+	                            const geom::Geometry& g1, double densifyFrac,
+	                            double threshold);
+
+	DiscreteFrechetDistance(const geom::Geometry& g0,
+	                        const geom::Geometry& g1)
+		:
+		g0(g0),
+		g1(g1),
+		ptDist(),
+		densifyFrac(0.0)
+	{}
+
+	/**
+	 * Sets the fraction by which to densify each segment.
+	 * Each segment will be (virtually) split into a number of equal-length
+	 * subsegments, whose fraction of the total length is closest
+	 * to the given fraction.
+	 *
+	 * @param dFrac
+	 * @throws IllegalArgumentException if dFrac is not in (0, 1]
+	 */
+	void setDensifyFraction(double dFrac);
+
+	/**
+	 * Computes the distance.
+	 *
+	 * @throws IllegalArgumentException if a geometry is empty
+	 */
+	double distance();
+
+	/**
+	 * Tests whether the distance is no more than threshold,
+	 * stopping at the first two consecutive anti-diagonals with no
+	 * pair of points reached by a walk within threshold.
+	 *
+	 * The points separated by the distance are not computed.
+	 *
+	 * @throws IllegalArgumentException if a geometry is empty
+	 */
+	bool isFrechetWithin(double threshold);
+
+	/// The points of g0 and g1 separated by the computed distance
+	const std::vector<geom::Coordinate>& getCoordinates() const
+	{
+		return ptDist.getCoordinates();
+	}
+
+private:
+
+	/// The distance of the best walk to a pair of points, and the
+	/// indices of its farthest pair
+	struct Cell
+	{
+		double distance;
+		std::size_t i;
+		std::size_t j;
+	};
+
+	/**
+	 * Sweeps the anti-diagonals, leaving in result the cell of the
+	 * last points. With a threshold no less than 0, the pairs
+	 * farther than it are not walked through, and returns false at
+	 * the first two consecutive anti-diagonals with no pair left.
+	 */
+	bool compute(double threshold, Cell& result);
+
+	void getPoints(const geom::Geometry& g,
+	               std::vector<geom::Coordinate>& pts) const;
+
+	const geom::Geometry& g0;
+
+	const geom::Geometry& g1;
+
+	PointPairDistance ptDist;
+
+	/// Value of 0.0 indicates that no densification should take place
+	double densifyFrac;
+
+	/// The points of g0 and g1
+	std::vector<geom::Coordinate> pts0;
+	std::vector<geom::Coordinate> pts1;
+
+	/// The last three anti-diagonals, indexed by the point of g0
+	std::vector<Cell> diagonals[3];
+
+	// Declare type as noncopyable
+	DiscreteFrechetDistance(const DiscreteFrechetDistance& other);
+	DiscreteFrechetDistance& operator=(const DiscreteFrechetDistance& rhs);
+};
+
+} // geos::algorithm::distance
+} // geos::algorithm
+} // geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_ALGORITHM_DISTANCE_DISCRETEFRECHETDISTANCE_H
@@ -96,6 +96,11 @@ namespace distance { // geos::algorithm::distance
  *   DHD(A, B) = 22.360679774997898
  *   HD(A, B) ~= 47.8
  * </pre>
+ *
+ * The segments of each geometry are indexed in an STRtree to find
+ * the nearest to the points of the other. Points which cannot be
+ * farther from the other geometry than the distance found so far
+ * are skipped, so that most of them are not searched for.
  */
 class GEOS_DLL DiscreteHausdorffDistance
 {
@@ -107,6 +112,17 @@ public:
 	static double distance(const geom::Geometry& g0,
 	                       const geom::Geometry& g1, double densifyFrac);
 
+	/**
+	 * Tests whether the discrete Hausdorff distance between
+	 * g0 and g1 is no more than threshold.
+	 */
+	static bool isHausdorffWithin(const geom::Geometry& g0,
+	                              const geom::Geometry& g1, double threshold);
+
+	static bool isHausdorffWithin(const geom::Geometry& g0,
+	                              const geom::Geometry& g1, double densifyFrac,
+	                              double threshold);
+
 	DiscreteHausdorffDistance(const geom::Geometry& g0,
 	                          const geom::Geometry& g1)
 		:
@@ -147,6 +163,19 @@ public:
 		return ptDist.getDistance();
 	}
 
+	/**
+	 * Tests whether the distance is no more than threshold,
+	 * stopping at the first point found farther than threshold
+	 * from the other geometry.
+	 *
+	 * The points separated by the distance are not computed.
+	 */
+	bool isHausdorffWithin(double threshold)
+	{
+		return isOrientedWithin(g0, g1, threshold) &&
+		       isOrientedWithin(g1, g0, threshold);
+	}
+
 	const std::vector<geom::Coordinate> getCoordinates() const
 	{
 		return ptDist.getCoordinates();
@@ -232,6 +261,9 @@ private:
 	                             const geom::Geometry& geom,
 	                             PointPairDistance& ptDist);
 
+	bool isOrientedWithin(const geom::Geometry& discreteGeom,
+	                      const geom::Geometry& geom, double threshold);
+
 	const geom::Geometry& g0;
 
 	const geom::Geometry& g1;
@@ -0,0 +1,119 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_ALGORITHM_LOCATE_GRIDPOINTINAREALOCATOR_H
+#define GEOS_ALGORITHM_LOCATE_GRIDPOINTINAREALOCATOR_H
+
+#include <geos/algorithm/locate/PointOnGeometryLocator.h> // inherited
+#include <geos/geom/Envelope.h> // composition
+#include <geos/geom/LineSegment.h> // composition
+
+#include <vector> // composition
+#include <cstddef>
+
+namespace geos {
+	namespace geom {
+		class Geometry;
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace algorithm { // geos::algorithm
+namespace locate { // geos::algorithm::locate
+
+/** \brief
+ * Determines the {@link Location} of {@link Coordinate}s relative to
+ * a {@link Polygon} or {@link MultiPolygon} geometry, using a uniform
+ * grid over its envelope.
+ *
+ * The grid has about as many cells as the geometry has segments.
+ * Each cell is classified once, on construction: a cell crossed by
+ * no segment lies wholly in the interior or in the exterior, and
+ * points in it are located in constant time. Points in the other,
+ * boundary cells are located by counting the crossings of a ray
+ * with the segments of the cells on their right, up to the first
+ * cell which is not a boundary cell.
+ *
+ * It pays over IndexedPointInAreaLocator when many points are
+ * tested against a large area, most of them away from its boundary.
+ */
+class GridPointInAreaLocator : public PointOnGeometryLocator
+{
+private:
+	enum CellState {
+		CELL_EXTERIOR,
+		CELL_INTERIOR,
+		CELL_BOUNDARY
+	};
+
+	geom::Envelope extent;
+	double cellWidth;
+	double cellHeight;
+	std::size_t numCellsX;
+	std::size_t numCellsY;
+
+	std::vector< geom::LineSegment > segments;
+
+	/// A CellState for each cell, row by row
+	std::vector< unsigned char > cellStates;
+
+	/// The segments of cell i are cellSegments[cellStarts[i], cellStarts[i+1])
+	std::vector< std::size_t > cellStarts;
+	std::vector< std::size_t > cellSegments;
+
+	void init( const geom::Geometry & g);
+	void indexSegments();
+	void classifyCells();
+
+	std::size_t column( double x) const;
+	std::size_t row( double y) const;
+
+	/// The columns of the cells of a row a segment may cross
+	void getColumns( const geom::LineSegment & seg, std::size_t row,
+	                 std::size_t & minColumn, std::size_t & maxColumn) const;
+
+    // Declare type as noncopyable
+    GridPointInAreaLocator(const GridPointInAreaLocator& other);
+    GridPointInAreaLocator& operator=(const GridPointInAreaLocator& rhs);
+
+public:
+	/**
+	 * Creates a new locator for a given {@link Geometry}
+	 * @param g the Geometry to locate in
+	 * @throws util::IllegalArgumentException if g is not polygonal
+	 */
+	GridPointInAreaLocator( const geom::Geometry & g);
+
+	~GridPointInAreaLocator();
+
+	/**
+	 * Determines the {@link Location} of a point in an areal {@link Geometry}.
+	 *
+	 * @param p the point to test
+	 * @return the location of the point in the geometry
+	 */
+	int locate( const geom::Coordinate * /*const*/ p);
+
+	std::size_t getNumCellsX() const { return numCellsX; }
+
+	std::size_t getNumCellsY() const { return numCellsY; }
+
+	/// @return the number of cells crossed by segments
+	std::size_t getNumBoundaryCells() const;
+};
+
+} // geos::algorithm::locate
+} // geos::algorithm
+} // geos
+
+#endif // GEOS_ALGORITHM_LOCATE_GRIDPOINTINAREALOCATOR_H
@@ -17,7 +17,7 @@
 #define GEOS_ALGORITHM_LOCATE_INDEXEDPOINTINAREALOCATOR_H
 
 #include <geos/algorithm/locate/PointOnGeometryLocator.h> // inherited
-#include <geos/index/ItemVisitor.h> // inherited
+#include <geos/geom/LineSegment.h> // composition
 
 #include <vector> // composition
 
@@ -29,7 +29,6 @@ namespace geos {
 		class Geometry;
 		class Coordinate; 
 		class CoordinateSequence; 
-		class LineSegment;
 	}
 	namespace index {
 		namespace intervalrtree {
@@ -48,6 +47,9 @@ namespace locate { // geos::algorithm::locate
  *
  * This algorithm is suitable for use in cases where
  * many points will be tested against a given area.
+ *
+ * The index is built on construction and not modified by queries,
+ * so points may be located from several threads at a time.
  * 
  * @author Martin Davis
  *
@@ -55,6 +57,20 @@ namespace locate { // geos::algorithm::locate
 class IndexedPointInAreaLocator : public PointOnGeometryLocator 
 {
 private:
+	class SegmentVisitor
+	{
+	private:
+		algorithm::RayCrossingCounter * counter;
+
+	public:
+		SegmentVisitor( algorithm::RayCrossingCounter * counter) 
+		:	counter( counter)
+		{ }
+
+		void operator()( void * item);
+	};
+
+
 	class IntervalIndexedGeometry
 	{
 	private:
@@ -63,31 +79,27 @@ private:
 		void init( const geom::Geometry & g);
 		void addLine( geom::CoordinateSequence * pts);
 
-		// To keep track of allocated LineSegments
-		std::vector< geom::LineSegment* > allocatedSegments;
+		// The indexed segments, stored once all are added
+		std::vector< geom::LineSegment > segments;
+
+		// Declare type as noncopyable
+		IntervalIndexedGeometry(const IntervalIndexedGeometry& other);
+		IntervalIndexedGeometry& operator=(const IntervalIndexedGeometry& rhs);
 
 	public:
 		IntervalIndexedGeometry( const geom::Geometry & g);
 		~IntervalIndexedGeometry();
 
-		void query(double min, double max, index::ItemVisitor * visitor);
-	};
+		void query(double min, double max, SegmentVisitor & visitor);
 
+		/// Adds to segs the segments whose extent in y intersects [min, max]
+		void query(double min, double max,
+		           std::vector< const geom::LineSegment * > & segs);
 
-	class SegmentVisitor : public index::ItemVisitor
-	{
-	private:
-		algorithm::RayCrossingCounter * counter;
-
-	public:
-		SegmentVisitor( algorithm::RayCrossingCounter * counter) 
-		:	counter( counter)
-		{ }
-		
-		~SegmentVisitor() 
-		{ }
-
-		void visitItem( void * item);
+		const std::vector< geom::LineSegment > & getSegments() const
+		{
+			return segments;
+		}
 	};
 
 
@@ -117,6 +129,32 @@ public:
 	 */
 	int locate( const geom::Coordinate * /*const*/ p);
 
+	/**
+	 * Determines the {@link Location} of n points, given as
+	 * consecutive x and y values in xy, into locations.
+	 *
+	 * Points outside the envelope of the geometry are exterior.
+	 * The others are bucket sorted into horizontal stripes of the
+	 * envelope, about one per segment, and the segments of each
+	 * stripe are queried from the index once for all its points.
+	 *
+	 * The points can be split into numParts contiguous ranges,
+	 * located by as many calls with part from 0 to numParts-1;
+	 * part k sets the locations of the points from n*k/numParts
+	 * up to n*(k+1)/numParts. The calls only read the locator,
+	 * so they may run on different threads.
+	 *
+	 * @param xy the 2 * n coordinates of the points
+	 * @param n the number of points
+	 * @param locations the n locations, in the order of the points
+	 * @param part the part of the points to locate
+	 * @param numParts the number of parts
+	 * @throws util::IllegalArgumentException if part is not less
+	 *         than numParts
+	 */
+	void locateAll( const double * xy, std::size_t n, int * locations,
+	                std::size_t part=0, std::size_t numParts=1);
+
 };
 
 } // geos::algorithm::locate
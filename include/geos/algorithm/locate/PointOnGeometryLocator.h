@@ -16,6 +16,8 @@
 #ifndef GEOS_ALGORITHM_LOCATE_POINTONGEOMETRYLOCATOR_H
 #define GEOS_ALGORITHM_LOCATE_POINTONGEOMETRYLOCATOR_H
 
+#include <cstddef>
+
 namespace geos {
 	namespace geom {
 		class Coordinate; 
@@ -47,6 +49,29 @@ public:
 	 * @return the location of the point in the geometry  
 	 */
 	virtual int locate( const geom::Coordinate * /*const*/ p) =0;
+
+	/**
+	 * Determines the {@link Location} of n points, given as
+	 * consecutive x and y values in xy, into locations.
+	 *
+	 * The default calls locate for each point in turn.
+	 *
+	 * The points can be split into numParts contiguous ranges,
+	 * located by as many calls with part from 0 to numParts-1;
+	 * part k sets the locations of the points from n*k/numParts
+	 * up to n*(k+1)/numParts.
+	 *
+	 * @param xy the 2 * n coordinates of the points
+	 * @param n the number of points
+	 * @param locations the n locations, in the order of the points
+	 * @param part the part of the points to locate
+	 * @param numParts the number of parts
+	 * @throws util::IllegalArgumentException if part is not less
+	 *         than numParts
+	 */
+	virtual void locateAll( const double * xy, std::size_t n,
+	                        int * locations,
+	                        std::size_t part=0, std::size_t numParts=1);
 };
 
 } // geos::algorithm::locate
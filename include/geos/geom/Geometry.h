@@ -53,6 +53,9 @@ namespace geos {
 		class PrecisionModel;
 		class Point;
 	}
+	namespace geomgraph {
+		class SelfNodingCache;
+	}
 	namespace io { // geos.io
 		class Unload;
 	} // namespace geos.io
@@ -218,6 +221,24 @@ public:
 	*/
 	void* getUserData() { return userData; }
 
+	/** \brief
+	 * Enables or disables keeping the self-noding computed for
+	 * this Geometry by relate, validity, simplicity and overlay
+	 * operations, for reuse by later operations on it.
+	 *
+	 * Disabled by default. Disabling drops what has been kept,
+	 * as does geometryChanged().
+	 *
+	 * Operations involving a Geometry with caching enabled
+	 * update it, so must not run concurrently.
+	 */
+	void setSelfNodingCacheEnabled(bool enable);
+
+	/// The self-noding cache, or NULL if disabled
+	geomgraph::SelfNodingCache* getSelfNodingCache() const {
+		return selfNodingCache.get();
+	}
+
 	/*
 	 * \brief
 	 * Returns the ID of the Spatial Reference System used by the
@@ -712,7 +733,8 @@ public:
 	 * @param geom the Geometry to check the distance to
 	 * @param cDistance the distance value to compare
 	 * @return <code>true</code> if the geometries are less than
-	 *  <code>distance</code> apart.
+	 *  <code>distance</code> apart, <code>false</code> if either
+	 *  is empty.
 	 *
 	 * @todo doesn't seem to need being virtual, make it concrete
 	 */
@@ -852,6 +874,9 @@ private:
 	static const GeometryFactory* INTERNAL_GEOMETRY_FACTORY;
 
 	void* userData;
+
+	/// Owned, NULL unless enabled
+	std::auto_ptr<geomgraph::SelfNodingCache> selfNodingCache;
 };
 
 /// \brief
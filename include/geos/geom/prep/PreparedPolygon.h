@@ -47,8 +47,18 @@ namespace prep { // geos::geom::prep
  */
 class PreparedPolygon : public BasicPreparedGeometry 
 {
+public:
+	/// The PointOnGeometryLocator implementations PreparedPolygon can use
+	enum PointLocatorType {
+		/// algorithm::locate::IndexedPointInAreaLocator, the default
+		INDEXED_LOCATOR,
+		/// algorithm::locate::GridPointInAreaLocator
+		GRID_LOCATOR
+	};
+
 private:
 	bool isRectangle;
+	PointLocatorType ptOnGeomLocType;
 	mutable noding::FastSegmentSetIntersectionFinder * segIntFinder;
 	mutable algorithm::locate::PointOnGeometryLocator * ptOnGeomLoc;
 	mutable noding::SegmentString::ConstVect segStrings;
@@ -60,6 +70,20 @@ public:
   
 	noding::FastSegmentSetIntersectionFinder * getIntersectionFinder() const;
 	algorithm::locate::PointOnGeometryLocator * getPointLocator() const;
+
+	/** \brief
+	 * Sets the PointOnGeometryLocator the predicates locate points
+	 * with.
+	 *
+	 * GRID_LOCATOR pays for large polygons against which many
+	 * points are tested. The locator is built on first use.
+	 */
+	void setPointLocatorType( PointLocatorType type);
+
+	PointLocatorType getPointLocatorType() const
+	{
+		return ptOnGeomLocType;
+	}
 	
 	bool contains( const geom::Geometry* g) const;
 	bool containsProperly( const geom::Geometry* g) const;
@@ -74,6 +74,16 @@ class GEOS_DLL GeometryGraph: public PlanarGraph
 using PlanarGraph::add;
 using PlanarGraph::findEdge;
 
+public:
+
+	/// The EdgeSetIntersector implementations GeometryGraph can use
+	enum EdgeSetIntersectorType {
+		/// index::SimpleMCSweepLineIntersector, the default
+		SWEEPLINE_INTERSECTOR,
+		/// index::STRtreeEdgeSetIntersector
+		STRTREE_INTERSECTOR
+	};
+
 private:
 
 	const geom::Geometry* parentGeom;
@@ -112,6 +122,8 @@ private:
 
 	geom::Coordinate invalidPoint; 
 
+	EdgeSetIntersectorType edgeSetIntersectorType;
+
 	/// Allocates a new EdgeSetIntersector. Remember to delete it!
 	index::EdgeSetIntersector* createEdgeSetIntersector();
 
@@ -143,6 +155,9 @@ private:
 
 	void addSelfIntersectionNodes(int argIndex);
 
+	/// Tells whether any edge has intersections added already
+	bool hasEdgeIntersections() const;
+
 	/** \brief
 	 * Add a node for a self-intersection.
 	 *
@@ -207,6 +222,10 @@ public:
 	 * @param computeRingSelfNodes if <false>, intersection checks are
 	 *	optimized to not test rings for self-intersection
 	 *
+	 * When the parent geometry has its SelfNodingCache enabled,
+	 * a self-noding computed earlier with the same parameters is
+	 * reused, and one computed here is recorded.
+	 *
 	 * @return the SegmentIntersector used, containing information about
 	 *	the intersections found
 	 */
@@ -220,9 +239,24 @@ public:
 			algorithm::LineIntersector& li,
 			bool computeRingSelfNodes);
 
+	/**
+	 * Computes the intersections of the edges of this graph with
+	 * the ones of g, using the EdgeSetIntersector of this graph.
+	 */
 	index::SegmentIntersector* computeEdgeIntersections(GeometryGraph *g,
 		algorithm::LineIntersector *li, bool includeProper);
 
+	/** \brief
+	 * Sets the EdgeSetIntersector used by computeSelfNodes and
+	 * computeEdgeIntersections of this graph.
+	 *
+	 * Meant for comparing the implementations on actual data;
+	 * SWEEPLINE_INTERSECTOR is used by default.
+	 */
+	void setEdgeSetIntersectorType(EdgeSetIntersectorType type);
+
+	EdgeSetIntersectorType getEdgeSetIntersectorType() const;
+
 	std::vector<Edge*> *getEdges();
 
 	bool hasTooFewPoints();
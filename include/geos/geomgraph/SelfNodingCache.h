@@ -0,0 +1,114 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOMGRAPH_SELFNODINGCACHE_H
+#define GEOS_GEOMGRAPH_SELFNODINGCACHE_H
+
+#include <geos/export.h>
+
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace algorithm {
+		class LineIntersector;
+	}
+	namespace geomgraph {
+		class Edge;
+		namespace index {
+			class SegmentIntersector;
+		}
+	}
+}
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+
+/** \brief
+ * The self-noding of a Geometry, as computed by
+ * GeometryGraph::computeSelfNodes, kept for reuse by the
+ * GeometryGraphs of later operations on the same Geometry.
+ *
+ * What is kept are the self-intersections found on each edge
+ * and the findings of the SegmentIntersector. An entry is kept
+ * for each of the two ways of computing the self-noding
+ * (with or without testing rings against themselves), and is
+ * only reused with the same rounding precision model.
+ *
+ * Enable it with geom::Geometry::setSelfNodingCacheEnabled.
+ */
+class GEOS_DLL SelfNodingCache {
+
+public:
+
+	SelfNodingCache();
+
+	~SelfNodingCache();
+
+	/** \brief
+	 * Adds the recorded self-intersections to the given edges,
+	 * and the recorded findings to the given SegmentIntersector.
+	 *
+	 * @param edges the edges of a new GeometryGraph of the
+	 *        cached Geometry, with no intersections added yet
+	 * @param li the LineIntersector which would be used to
+	 *        compute the self-noding
+	 * @param testAllSegments whether rings would be tested
+	 *        against themselves
+	 * @param si the SegmentIntersector to update
+	 *
+	 * @return false if nothing matching was recorded, in which
+	 *         case neither the edges nor si have been touched
+	 */
+	bool restore(std::vector<Edge*>& edges,
+	             const algorithm::LineIntersector& li,
+	             bool testAllSegments,
+	             index::SegmentIntersector& si) const;
+
+	/** \brief
+	 * Records the self-noding just computed on the given edges.
+	 *
+	 * Parameters are as for restore().
+	 */
+	void store(std::vector<Edge*>& edges,
+	           const algorithm::LineIntersector& li,
+	           bool testAllSegments,
+	           index::SegmentIntersector& si);
+
+	/// Forgets everything recorded
+	void clear();
+
+private:
+
+	class Entry;
+
+	/// Owned, NULL when missing; indexed by testAllSegments
+	Entry* entries[2];
+
+	// Declare type as noncopyable
+	SelfNodingCache(const SelfNodingCache& other);
+	SelfNodingCache& operator=(const SelfNodingCache& rhs);
+};
+
+} // namespace geos.geomgraph
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ifndef GEOS_GEOMGRAPH_SELFNODINGCACHE_H
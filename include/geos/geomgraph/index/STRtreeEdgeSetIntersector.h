@@ -0,0 +1,143 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOMGRAPH_INDEX_STRTREEEDGESETINTERSECTOR_H
+#define GEOS_GEOMGRAPH_INDEX_STRTREEEDGESETINTERSECTOR_H
+
+#include <geos/export.h>
+#include <vector>
+#include <cstddef>
+
+#include <geos/geomgraph/index/EdgeSetIntersector.h> // for inheritance
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geomgraph {
+		class Edge;
+		namespace index {
+			class SegmentIntersector;
+			class MonotoneChainEdge;
+		}
+	}
+}
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+namespace index { // geos.geomgraph.index
+
+/** \brief
+ * Finds all intersections in one or two sets of edges,
+ * using a packed STR R-tree of the envelopes of the edges'
+ * monotone chains.
+ *
+ * Chains and tree nodes are stored by value in contiguous arrays,
+ * built once per computation by Sort-Tile-Recursive packing.
+ * Unlike SimpleMCSweepLineIntersector, candidate pairs are pruned
+ * on both axes, which pays off when many chains have long
+ * x-extents (latitude bands, long coastlines).
+ *
+ * Every pair of overlapping chains is tested once, in the same
+ * order the sweep line would use, so results match those of
+ * SimpleMCSweepLineIntersector.
+ */
+class GEOS_DLL STRtreeEdgeSetIntersector: public EdgeSetIntersector {
+
+public:
+
+	/**
+	 * @param nodeCapacity maximum number of children of a tree node
+	 */
+	STRtreeEdgeSetIntersector(std::size_t nodeCapacity=DEFAULT_NODE_CAPACITY);
+
+	virtual ~STRtreeEdgeSetIntersector();
+
+	void computeIntersections(std::vector<Edge*> *edges,
+			SegmentIntersector *si, bool testAllSegments);
+
+	void computeIntersections(std::vector<Edge*> *edges0,
+			std::vector<Edge*> *edges1,
+			SegmentIntersector *si);
+
+	/// Number of chain pairs tested by the last computation
+	int getNumOverlaps() const { return nOverlaps; }
+
+	static const std::size_t DEFAULT_NODE_CAPACITY = 8;
+
+private:
+
+	/// A monotone chain, with its envelope
+	struct Chain {
+		double minX, minY, maxX, maxY;
+		MonotoneChainEdge* mce;
+		int chainIndex;
+		/// Chains in the same non-NULL set are not tested together
+		const void* edgeSet;
+		/// Insertion order, breaking ties in the testing order
+		std::size_t id;
+	};
+
+	/// A tree node, covering a range of chains or of lower nodes
+	struct Node {
+		double minX, minY, maxX, maxY;
+		std::size_t childStart, childEnd;
+	};
+
+	std::size_t nodeCapacity;
+
+	std::vector<Chain> chains;
+
+	/// Nodes of all levels, leaves first and the root last
+	std::vector<Node> nodes;
+
+	/// Children of nodes before leafEnd are chains, others are nodes
+	std::size_t leafEnd;
+
+	/// Scratch space for query()
+	std::vector<std::size_t> stack;
+	std::vector<const Chain*> candidates;
+
+	int nOverlaps;
+
+	void add(std::vector<Edge*> *edges, const void* edgeSet);
+
+	void add(Edge *edge, const void* edgeSet);
+
+	void build();
+
+	void computeIntersections(SegmentIntersector *si);
+
+	/// Collects into candidates the chains qc is to be tested against
+	void query(const Chain& qc);
+
+	static bool precedes(const Chain& c0, const Chain& c1);
+
+	static bool precedesPtr(const Chain* c0, const Chain* c1);
+
+	// Declare type as noncopyable
+	STRtreeEdgeSetIntersector(const STRtreeEdgeSetIntersector& other);
+	STRtreeEdgeSetIntersector& operator=(const STRtreeEdgeSetIntersector& rhs);
+};
+
+} // namespace geos.geomgraph.index
+} // namespace geos.geomgraph
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_GEOMGRAPH_INDEX_STRTREEEDGESETINTERSECTOR_H
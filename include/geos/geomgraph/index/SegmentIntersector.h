@@ -34,6 +34,7 @@ namespace geos {
 	namespace geomgraph {
 		class Node;
 		class Edge;
+		class SelfNodingCache;
 	}
 }
 
@@ -44,6 +45,9 @@ namespace index { // geos::geomgraph::index
 
 class GEOS_DLL SegmentIntersector{
 
+	/// Saves and restores the findings of self-noding
+	friend class geomgraph::SelfNodingCache;
+
 private:
 
 	/**
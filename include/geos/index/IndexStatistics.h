@@ -0,0 +1,72 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_INDEXSTATISTICS_H
+#define GEOS_INDEX_INDEXSTATISTICS_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace index {
+
+/** \brief
+ * The shape of a tree index, as reported by its getStatistics().
+ */
+struct GEOS_DLL IndexStatistics {
+
+	/// The number of levels of nodes
+	std::size_t depth;
+
+	/// The number of nodes, the root included
+	std::size_t numNodes;
+
+	/// The number of items
+	std::size_t numItems;
+
+	/**
+	 * The mean share of the child slots of the nodes in use: out
+	 * of the node capacity in an STRtree, where the children of
+	 * the leaves are items, of the 4 quadrants in a Quadtree and
+	 * of the 2 halves in a Bintree.
+	 */
+	double fillFactor;
+
+	/**
+	 * The total area of the intersections of the bounds of the
+	 * nodes with those of their sibling nodes. The quadrants of
+	 * a Quadtree, and the halves of a Bintree, never overlap.
+	 */
+	double overlapArea;
+
+	/**
+	 * An estimate of the memory held by the index, in bytes,
+	 * without the items and the bounds given by the caller.
+	 */
+	std::size_t memorySize;
+
+	IndexStatistics()
+		:
+		depth(0),
+		numNodes(0),
+		numItems(0),
+		fillFactor(0),
+		overlapArea(0),
+		memorySize(0)
+	{}
+};
+
+} // namespace geos.index
+} // namespace geos
+
+#endif // GEOS_INDEX_INDEXSTATISTICS_H
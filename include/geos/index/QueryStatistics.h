@@ -0,0 +1,70 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_QUERYSTATISTICS_H
+#define GEOS_INDEX_QUERYSTATISTICS_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace index {
+
+/** \brief
+ * The work done by the queries of a tree index given one.
+ *
+ * The counts of each query are added to those already there, so
+ * that one QueryStatistics may sum up a series of queries.
+ */
+struct GEOS_DLL QueryStatistics {
+
+	/// The number of nodes entered, whose bounds matched the query
+	std::size_t numNodesVisited;
+
+	/// The number of nodes holding items whose items were scanned
+	std::size_t numLeavesTested;
+
+	/// The number of items passed to the caller
+	std::size_t numItemsReturned;
+
+	QueryStatistics()
+		:
+		numNodesVisited(0),
+		numLeavesTested(0),
+		numItemsReturned(0)
+	{}
+
+	void reset() { *this = QueryStatistics(); }
+
+	/// @name Counting, called by the traversals of the queries
+	//@{
+	void visitNode() { ++numNodesVisited; }
+	void testLeaf() { ++numLeavesTested; }
+	void returnItems(std::size_t n) { numItemsReturned += n; }
+	//@}
+};
+
+/** \brief
+ * The counting of QueryStatistics doing nothing, for the traversals
+ * of the queries collecting no statistics.
+ */
+struct NoQueryStatistics {
+	void visitNode() {}
+	void testLeaf() {}
+	void returnItems(std::size_t) {}
+};
+
+} // namespace geos.index
+} // namespace geos
+
+#endif // GEOS_INDEX_QUERYSTATISTICS_H
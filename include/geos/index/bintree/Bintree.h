@@ -16,6 +16,7 @@
 #define GEOS_IDX_BINTREE_BINTREE_H
 
 #include <geos/export.h>
+#include <geos/index/IndexStatistics.h> // for return by value
 #include <vector>
 
 #ifdef _MSC_VER
@@ -26,6 +27,7 @@
 // Forward declarations
 namespace geos {
 	namespace index { 
+		struct QueryStatistics;
 		namespace bintree { 
 			class Interval;
 			class Root;
@@ -97,6 +99,14 @@ public:
 	void query(Interval *interval,
 			std::vector<void*> *foundItems);
 
+	/// As above, adding the nodes visited, the nodes whose items
+	/// were returned and the items returned to stats
+	void query(Interval *interval,
+			std::vector<void*> *foundItems, QueryStatistics& stats);
+
+	/// Reports the shape of the tree
+	IndexStatistics getStatistics();
+
 private:
 
 	std::vector<Interval *>newIntervals;
@@ -17,10 +17,13 @@
 
 #include <geos/export.h>
 #include <vector>
+#include <cstddef>
 
 // Forward declarations
 namespace geos {
 	namespace index { 
+		struct IndexStatistics;
+		struct QueryStatistics;
 		namespace bintree { 
 			class Node;
 			class Interval;
@@ -35,6 +38,14 @@ namespace bintree { // geos::index::bintree
 /// The base class for nodes in a Bintree.
 class GEOS_DLL NodeBase {
 
+private:
+
+	/// The items of addAllItemsFromOverlapping, counting the work
+	/// done in stats
+	template <class Stats>
+	void collectOverlapping(Interval *interval,
+			std::vector<void*> *resultItems, Stats& stats);
+
 public:
 
 	static int getSubnodeIndex(Interval *interval, double centre);
@@ -52,6 +63,14 @@ public:
 	virtual std::vector<void*>* addAllItemsFromOverlapping(Interval *interval,
 			std::vector<void*> *resultItems);
 
+	/// As above, adding the work done to stats
+	void addAllItemsFromOverlapping(Interval *interval,
+			std::vector<void*> *resultItems, QueryStatistics& stats);
+
+	/// Adds the levels, nodes and items of this subtree to stats,
+	/// with the memory of the item lists of its nodes.
+	void addStatistics(IndexStatistics& stats, std::size_t nodeDepth=1);
+
 	virtual int depth();
 
 	virtual int size();
@@ -16,7 +16,8 @@
 #ifndef GEOS_INDEX_INTERVALRTREE_SORTEDPACKEDINTERVALRTREE_H
 #define GEOS_INDEX_INTERVALRTREE_SORTEDPACKEDINTERVALRTREE_H
 
-#include <geos/index/intervalrtree/IntervalRTreeNode.h>
+#include <vector>
+#include <cstddef>
 
 // forward declarations
 namespace geos {
@@ -43,21 +44,47 @@ namespace intervalrtree {
  * The advantage of this characteristic is that the index performance 
  * can be optimized based on a fixed set of items.
  * 
+ * The intervals are kept in contiguous arrays rather than in a node
+ * object each: the leaves, sorted by midpoint, then each level of
+ * the binary tree above them up to the root, the children of the
+ * i-th node of a level being the nodes 2i and 2i+1 of the level below.
+ * Queries walk the tree without recursion nor a stack.
+ * 
  * @author Martin Davis
  *
  */
 class SortedPackedIntervalRTree 
 {
 private:
-	IntervalRTreeNode::ConstVect * leaves;
-	const IntervalRTreeNode * root;
-	int level;
+	struct Interval
+	{
+		double min;
+		double max;
+	};
+
+	/// The leaves, then each level of branch nodes up to the root
+	std::vector<Interval> bounds;
+
+	/// The items of the leaves, in the same order
+	std::vector<void*> items;
+
+	/// The offset in bounds of each level, and then bounds.size()
+	std::vector<std::size_t> levelStarts;
+
+	bool built;
 
 	void init();
-	void buildLevel( IntervalRTreeNode::ConstVect * src, IntervalRTreeNode::ConstVect * dest);
-	const IntervalRTreeNode * buildTree();
+	void buildTree();
+
+	std::size_t levelSize(std::size_t level) const
+	{
+		return levelStarts[level + 1] - levelStarts[level];
+	}
+
+	// Declare type as noncopyable
+	SortedPackedIntervalRTree(const SortedPackedIntervalRTree& other);
+	SortedPackedIntervalRTree& operator=(const SortedPackedIntervalRTree& rhs);
 
-protected:
 public:
 	SortedPackedIntervalRTree();
 	
@@ -70,9 +97,17 @@ public:
 	 * @param max the upper bound of the item interval
 	 * @param item the item to insert, ownership left to caller
 	 * 
-	 * @throw IllegalStateException if the index has already been queried
+	 * @throw UnsupportedOperationException if the index has already
+	 *        been queried
 	 */
 	void insert( double min, double max, void * item);
+
+	/**
+	 * Builds the tree, as the first query otherwise does.
+	 * Queries do not modify a built tree, and may then be
+	 * run from several threads at a time.
+	 */
+	void build() { init(); }
  
 	/**
 	 * Search for intervals in the index which intersect the given closed interval
@@ -84,6 +119,56 @@ public:
 	 */
 	void query( double min, double max, index::ItemVisitor * visitor);
 
+	/**
+	 * Search for intervals in the index which intersect the given
+	 * closed interval and call visitor with their items.
+	 *
+	 * The visitor is any object callable with a void pointer;
+	 * it is called inline rather than through ItemVisitor.
+	 *
+	 * @param min the lower bound of the query interval
+	 * @param max the upper bound of the query interval
+	 * @param visitor the visitor to pass any matched items to
+	 */
+	template <class Visitor>
+	void query( double min, double max, Visitor & visitor)
+	{
+		init();
+		if ( items.empty() ) return;
+
+		std::size_t const rootLevel = levelStarts.size() - 2;
+		std::size_t level = rootLevel;
+		std::size_t i = 0;
+		for (;;)
+		{
+			const Interval & node = bounds[ levelStarts[ level ] + i ];
+			if ( node.min <= max && node.max >= min )
+			{
+				if ( level == 0 )
+				{
+					visitor( items[ i ] );
+				}
+				else
+				{
+					// descend to the first child
+					--level;
+					i *= 2;
+					continue;
+				}
+			}
+
+			// move to the next sibling, climbing up from last children
+			while ( level < rootLevel &&
+			        ( ( i & 1 ) || i + 1 == levelSize( level ) ) )
+			{
+				++level;
+				i /= 2;
+			}
+			if ( level == rootLevel ) return;
+			++i;
+		}
+	}
+
 };
 
 } // geos::intervalrtree
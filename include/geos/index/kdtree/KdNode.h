@@ -0,0 +1,88 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_KDTREE_KDNODE_H
+#define GEOS_INDEX_KDTREE_KDNODE_H
+
+#include <geos/export.h>
+#include <geos/geom/Coordinate.h> // for composition
+
+#include <cstddef>
+
+namespace geos {
+namespace index { // geos::index
+namespace kdtree { // geos::index::kdtree
+
+class KdTree;
+
+/**
+ * \brief
+ * A node of a KdTree, holding a distinct point, the data given
+ * with it, and the number of points snapped to it.
+ */
+class GEOS_DLL KdNode {
+
+public:
+
+	KdNode(const geom::Coordinate& pt, void* nodeData)
+		:
+		p(pt),
+		data(nodeData),
+		left(0),
+		right(0),
+		count(1),
+		subtreeSize(1)
+	{}
+
+	double getX() const { return p.x; }
+
+	double getY() const { return p.y; }
+
+	/// @return the point of the node, the first inserted
+	const geom::Coordinate& getCoordinate() const { return p; }
+
+	/// @return the data given with the first point inserted
+	void* getData() const { return data; }
+
+	KdNode* getLeft() const { return left; }
+
+	KdNode* getRight() const { return right; }
+
+	/// @return the number of points inserted in this node
+	std::size_t getCount() const { return count; }
+
+	/// @return whether more than one point was inserted in this node
+	bool isRepeated() const { return count > 1; }
+
+private:
+
+	friend class KdTree;
+
+	geom::Coordinate p;
+
+	void* data;
+
+	KdNode* left;
+
+	KdNode* right;
+
+	std::size_t count;
+
+	/// The number of nodes in the subtree rooted here
+	std::size_t subtreeSize;
+};
+
+} // namespace geos::index::kdtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_KDTREE_KDNODE_H
@@ -0,0 +1,41 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_KDTREE_KDNODEVISITOR_H
+#define GEOS_INDEX_KDTREE_KDNODEVISITOR_H
+
+#include <geos/export.h>
+
+namespace geos {
+namespace index { // geos::index
+namespace kdtree { // geos::index::kdtree
+
+class KdNode;
+
+/**
+ * \brief
+ * A visitor for the nodes found by a KdTree query.
+ */
+class GEOS_DLL KdNodeVisitor {
+
+public:
+
+	virtual void visit(KdNode* node)=0;
+
+	virtual ~KdNodeVisitor() {}
+};
+
+} // namespace geos::index::kdtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_KDTREE_KDNODEVISITOR_H
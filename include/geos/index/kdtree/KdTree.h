@@ -0,0 +1,160 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_KDTREE_KDTREE_H
+#define GEOS_INDEX_KDTREE_KDTREE_H
+
+#include <geos/export.h>
+#include <geos/index/kdtree/KdNode.h> // for composition
+
+#include <deque>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		namespace kdtree {
+			class KdNodeVisitor;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace kdtree { // geos::index::kdtree
+
+/**
+ * \brief
+ * A 2D KD-tree of points, which snaps the points inserted within
+ * a tolerance of a point already in the tree to its node.
+ *
+ * A point is snapped to the nearest node within the tolerance,
+ * which then counts one more point; with a zero tolerance, only
+ * equal points (in 2D) are. The nodes keep the coordinate and the
+ * data of the first point inserted in them.
+ *
+ * The nodes split the plane alternately by x and y, and are
+ * allocated in blocks held by the tree. The tree does not depend
+ * on the order of the insertions being random: when an insertion
+ * makes a path too deep, the smallest unbalanced subtree on it is
+ * rebuilt around medians, as in a scapegoat tree, so that the
+ * depth stays logarithmic in the number of nodes.
+ */
+class GEOS_DLL KdTree {
+
+public:
+
+	/**
+	 * Constructs an empty tree.
+	 *
+	 * @param tolerance the distance within which points are snapped
+	 *        to a node, 0 to snap only equal points
+	 */
+	KdTree(double tolerance=0.0);
+
+	~KdTree();
+
+	/**
+	 * Inserts a point, snapping it to the nearest node within
+	 * the tolerance if any.
+	 *
+	 * @param p the point
+	 * @param data the data of a new node, ignored if p is snapped
+	 * @return the node p was snapped to, or the new node made for it;
+	 *         owned by the tree
+	 */
+	KdNode* insert(const geom::Coordinate& p, void* data=0);
+
+	/**
+	 * Calls visitor with every node whose point lies in queryEnv,
+	 * boundary included.
+	 */
+	void query(const geom::Envelope& queryEnv, KdNodeVisitor& visitor) const;
+
+	/**
+	 * Appends to result every node whose point lies in queryEnv,
+	 * boundary included.
+	 */
+	void query(const geom::Envelope& queryEnv,
+	           std::vector<KdNode*>& result) const;
+
+	/// @return the root, or 0 if the tree is empty
+	KdNode* getRoot() const { return root; }
+
+	/// @return the number of nodes, that is of distinct points
+	std::size_t size() const { return nodes.size(); }
+
+	bool isEmpty() const { return nodes.empty(); }
+
+	double getTolerance() const { return tolerance; }
+
+	/**
+	 * Appends the points of some nodes to a vector.
+	 *
+	 * @param includeRepeated whether to append the point of a node
+	 *        as many times as points were inserted in it
+	 */
+	static void toCoordinates(const std::vector<KdNode*>& kdnodes,
+	                          std::vector<geom::Coordinate>& coords,
+	                          bool includeRepeated=false);
+
+private:
+
+	/// A node to visit, and whether it splits by x
+	typedef std::pair<KdNode*, bool> StackEntry;
+
+	double tolerance;
+
+	KdNode* root;
+
+	/// The nodes, whose addresses do not change as it grows
+	std::deque<KdNode> nodes;
+
+	/// The nodes on the path of the last insertion
+	std::vector<KdNode*> path;
+
+	/// Scratch space for rebuilding subtrees
+	std::vector<KdNode*> rebuildNodes;
+
+	/// Scratch space for the searches of insert
+	std::vector<StackEntry> stack;
+
+	KdNode* findBestMatch(const geom::Coordinate& p);
+
+	void rebalance(std::size_t depth);
+
+	KdNode* buildBalanced(std::size_t begin, std::size_t end, bool splitX);
+
+	// Declare type as noncopyable
+	KdTree(const KdTree& other);
+	KdTree& operator=(const KdTree& rhs);
+};
+
+} // namespace geos::index::kdtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_KDTREE_KDTREE_H
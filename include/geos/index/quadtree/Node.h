@@ -20,9 +20,10 @@
 #define GEOS_IDX_QUADTREE_NODE_H
 
 #include <geos/export.h>
+
 #include <geos/index/quadtree/NodeBase.h> // for inheritance
 #include <geos/geom/Coordinate.h> // for composition
-#include <geos/geom/Envelope.h> // for inline
+#include <geos/geom/Envelope.h> // for composition
 
 #include <string>
 #include <memory>
@@ -34,9 +35,10 @@
 
 // Forward declarations
 namespace geos {
-	namespace geom {
-		//class Coordinate;
-		class Envelope;
+	namespace index {
+		namespace quadtree {
+			class NodePool;
+		}
 	}
 }
 
@@ -51,24 +53,42 @@ namespace quadtree { // geos::index::quadtree
  * Nodes contain items which have a spatial extent corresponding to
  * the node's position in the quadtree.
  *
+ * The nodes of a Quadtree are allocated from, and owned by, the
+ * NodePool of the tree. A node created on its own, by the constructors
+ * or the factories not taking a pool, owns its subnodes instead, and
+ * may only be given subnodes by the methods not taking a pool.
  */
 class GEOS_DLL Node: public NodeBase {
 
+	friend class NodePool;
+
 private:
 
-	/// Owned by this class
-	std::auto_ptr<geom::Envelope> env;
+	geom::Envelope env;
 
 	geom::Coordinate centre;
 
 	int level;
 
+	/// Whether the subnodes are deleted with this node,
+	/// rather than owned by a NodePool
+	bool ownsSubnodes;
+
+	/// Makes this an empty node of the given extent and level
+	void init(const geom::Envelope& nenv, int nlevel);
+
+	/// The extent of the subquad for the index
+	geom::Envelope getSubnodeEnvelope(int index) const;
+
 	/**
 	 * Get the subquad for the index.
-	 * If it doesn't exist, create it.
-	 * 
-	 * Ownership of the returned object belongs to this class.
+	 * If it doesn't exist, create it from the pool.
 	 */
+	Node* getSubnode(int index, NodePool& pool);
+
+	Node* createSubnode(int index, NodePool& pool);
+
+	/// As above, the subquad being owned by this node
 	Node* getSubnode(int index);
 
 	std::auto_ptr<Node> createSubnode(int index);
@@ -76,42 +96,66 @@ private:
 protected:
 
 	bool isSearchMatch(const geom::Envelope& searchEnv) const {
-		return env->intersects(searchEnv);
+		return env.intersects(searchEnv);
 	}
 
 public:
 
 	// Create a node computing level from given envelope
-	static std::auto_ptr<Node> createNode(const geom::Envelope& env);
+	static Node* createNode(const geom::Envelope& env, NodePool& pool);
 
 	/// Create a node containing the given node and envelope
 	//
 	/// @param node if not null, will be inserted to the returned node
 	/// @param addEnv minimum envelope to use for the node
+	/// @param pool the pool to take the new nodes from
 	///
+	static Node* createExpanded(Node* node, const geom::Envelope& addEnv,
+			NodePool& pool);
+
+	/// Create a node owning its subnodes, computing level from
+	/// given envelope
+	static std::auto_ptr<Node> createNode(const geom::Envelope& env);
+
+	/// Create a node owning its subnodes, containing the given node
+	/// and envelope
 	static std::auto_ptr<Node> createExpanded(std::auto_ptr<Node> node,
 			const geom::Envelope& addEnv);
 
-	Node(std::auto_ptr<geom::Envelope> nenv, int nlevel)
+	Node(const geom::Envelope& nenv, int nlevel)
 		:
 		env(nenv),
-		centre((env->getMinX()+env->getMaxX())/2,
-			(env->getMinY()+env->getMaxY())/2),
-		level(nlevel)
+		centre((env.getMinX()+env.getMaxX())/2,
+			(env.getMinY()+env.getMaxY())/2),
+		level(nlevel),
+		ownsSubnodes(true)
 	{
 	}
 
-	virtual ~Node() {}
+	Node(std::auto_ptr<geom::Envelope> nenv, int nlevel)
+		:
+		env(*nenv),
+		centre((env.getMinX()+env.getMaxX())/2,
+			(env.getMinY()+env.getMaxY())/2),
+		level(nlevel),
+		ownsSubnodes(true)
+	{
+	}
+
+	virtual ~Node();
 
 	/// Return Envelope associated with this node
 	/// ownership retained by this object
-	geom::Envelope* getEnvelope() { return env.get(); }
+	geom::Envelope* getEnvelope() { return &env; }
 
 	/** \brief
 	 * Returns the subquad containing the envelope.
-	 * Creates the subquad if
+	 * Creates the subquad from the pool if
 	 * it does not already exist.
 	 */
+	Node* getNode(const geom::Envelope *searchEnv, NodePool& pool);
+
+	/// As above, for a node owning its subnodes
 	Node* getNode(const geom::Envelope *searchEnv);
 
 	/** \brief
@@ -120,6 +164,9 @@ public:
 	 */
 	NodeBase* find(const geom::Envelope *searchEnv);
 
+	void insertNode(Node* node, NodePool& pool);
+
+	/// As above, for a node owning its subnodes, taking ownership of node
 	void insertNode(std::auto_ptr<Node> node);
 
 	std::string toString() const;
@@ -36,8 +36,11 @@ namespace geos {
 	}
 	namespace index {
 		class ItemVisitor;
+		struct IndexStatistics;
+		struct QueryStatistics;
 		namespace quadtree {
 			class Node;
+			class NodePool;
 		}
 	}
 }
@@ -50,14 +53,32 @@ namespace quadtree { // geos::index::quadtree
  * \brief
  * The base class for nodes in a Quadtree.
  *
+ * The traversals of the subtree of a node are iterative, keeping
+ * the nodes left to visit on an explicit stack.
  */
 class GEOS_DLL NodeBase {
 
+public:
+
+	/// The nodes left to visit by a traversal
+	typedef std::vector<const NodeBase*> NodeStack;
+
 private:
 
-	void visitItems(const geom::Envelope* searchEnv,
-			ItemVisitor& visitor);
-	
+	/**
+	 * Calls action with the items of the nodes of this subtree
+	 * matching searchEnv, or of all of them if searchEnv is null,
+	 * parents first, counting the work done in stats.
+	 */
+	template <class ItemAction, class Stats>
+	void traverse(const geom::Envelope* searchEnv, NodeStack& stack,
+			ItemAction& action, Stats& stats) const;
+
+	/// Removes item, giving the nodes left empty back to pool,
+	/// or deleting them if pool is null
+	bool removeItem(const geom::Envelope* itemEnv, void* item,
+			NodePool* pool);
+
 public:
 
 	static int getSubnodeIndex(const geom::Envelope *env,
@@ -79,6 +100,10 @@ public:
 	virtual void addAllItemsFromOverlapping(const geom::Envelope& searchEnv,
 			std::vector<void*>& resultItems) const;
 
+	/// Same as above, with the scratch space of the traversal
+	void addAllItemsFromOverlapping(const geom::Envelope& searchEnv,
+			std::vector<void*>& resultItems, NodeStack& stack) const;
+
 	unsigned int depth() const;
 
 	unsigned int size() const;
@@ -87,15 +112,35 @@ public:
 
 	virtual std::string toString() const;
 
-	virtual void visit(const geom::Envelope* searchEnv, ItemVisitor& visitor);
+	virtual void visit(const geom::Envelope* searchEnv,
+			ItemVisitor& visitor) const;
+
+	/// Same as above, with the scratch space of the traversal
+	void visit(const geom::Envelope* searchEnv, ItemVisitor& visitor,
+			NodeStack& stack) const;
+
+	/// Same as above, adding the work done to stats
+	void visit(const geom::Envelope* searchEnv, ItemVisitor& visitor,
+			NodeStack& stack, QueryStatistics& stats) const;
+
+	/**
+	 * Adds the levels, nodes and items of this subtree to stats,
+	 * with the memory of the item lists of its nodes.
+	 */
+	void addStatistics(IndexStatistics& stats) const;
 
 	/**
 	 * Removes a single item from this subtree.
 	 *
 	 * @param searchEnv the envelope containing the item
 	 * @param item the item to remove
+	 * @param pool the pool taking back the nodes left empty
 	 * @return <code>true</code> if the item was found and removed
 	 */
+	bool remove(const geom::Envelope* itemEnv, void* item, NodePool& pool);
+
+	/// As above, deleting the nodes left empty, for a subtree of
+	/// nodes owning their subnodes
 	bool remove(const geom::Envelope* itemEnv, void* item);
  
 	bool hasItems() const;
@@ -117,7 +162,7 @@ protected:
 	 *  0 | 1
 	 * </pre>
 	 *
-	 * Nodes are owned by this class 
+	 * Nodes are owned by the NodePool of the tree
 	 */
 	Node* subnode[4];
 
@@ -0,0 +1,95 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IDX_QUADTREE_NODEPOOL_H
+#define GEOS_IDX_QUADTREE_NODEPOOL_H
+
+#include <geos/export.h>
+#include <geos/index/quadtree/Node.h> // for composition
+
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace quadtree { // geos::index::quadtree
+
+/**
+ * \brief
+ * The storage of the nodes of a Quadtree.
+ *
+ * Nodes are allocated in blocks and all released together when the
+ * pool is cleared or destroyed. Nodes pruned from the tree are kept
+ * for reuse, as are all nodes, with the capacity of their item
+ * lists, after a clear().
+ */
+class GEOS_DLL NodePool {
+private:
+	std::deque<Node> nodes;
+
+	/// nodes[0, numUsed) have been handed out since the last clear
+	std::size_t numUsed;
+
+	/// Nodes handed out and released since
+	std::vector<Node*> freeNodes;
+
+	// Declare type as noncopyable
+	NodePool(const NodePool& other);
+	NodePool& operator=(const NodePool& rhs);
+
+public:
+	NodePool();
+
+	~NodePool();
+
+	/// Returns an empty node of the given extent and level,
+	/// owned by this pool
+	Node* create(const geom::Envelope& env, int level);
+
+	/// Takes back a node no longer linked into the tree
+	void release(Node* node);
+
+	/// Takes back all nodes, keeping their storage for reuse
+	void clear();
+
+	/// Returns the number of nodes handed out and not taken back
+	std::size_t size() const { return numUsed - freeNodes.size(); }
+
+	/// Returns the memory held by the pool, in bytes
+	std::size_t getMemorySize() const {
+		return nodes.size() * sizeof(Node)
+			+ freeNodes.capacity() * sizeof(Node*);
+	}
+};
+
+} // namespace geos::index::quadtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_IDX_QUADTREE_NODEPOOL_H
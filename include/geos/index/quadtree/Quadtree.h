@@ -22,6 +22,7 @@
 #include <geos/export.h>
 #include <geos/index/SpatialIndex.h> // for inheritance
 #include <geos/index/quadtree/Root.h> // for composition
+#include <geos/index/IndexStatistics.h> // for return by value
 
 #include <vector>
 #include <string>
@@ -37,6 +38,7 @@ namespace geos {
 		class Envelope;
 	}
 	namespace index {
+		struct QueryStatistics;
 		namespace quadtree {
 			// class Root; 
 		}
@@ -168,6 +170,18 @@ public:
 		root.visit(searchEnv, visitor);
 	}
 
+	/**
+	 * As above, adding the nodes visited, the nodes whose items were
+	 * returned and the items returned to stats. Queries without
+	 * statistics do no counting at all.
+	 */
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor,
+	           QueryStatistics& stats)
+	{
+		NodeBase::NodeStack stack;
+		root.visit(searchEnv, visitor, stack, stats);
+	}
+
 	/**
 	 * Removes a single item from the tree.
 	 *
@@ -180,6 +194,18 @@ public:
 	/// Return a list of all items in the Quadtree
 	std::vector<void*>* queryAll();
 
+	/**
+	 * Removes all items from the tree.
+	 *
+	 * The storage of the nodes is kept for the items inserted next,
+	 * so that a tree may be filled and emptied repeatedly without
+	 * allocating its nodes again.
+	 */
+	void clear();
+
+	/// Reports the shape of the tree
+	IndexStatistics getStatistics() const;
+
 	std::string toString() const;
 
 };
@@ -21,14 +21,21 @@
 
 #include <geos/export.h>
 #include <geos/index/quadtree/NodeBase.h> // for inheritance
+#include <geos/index/quadtree/NodePool.h> // for composition
 #include <geos/geom/Coordinate.h> // for composition
 
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
 // Forward declarations
 namespace geos {
 	namespace geom {
 		class Envelope;
 	}
 	namespace index {
+		struct IndexStatistics;
 		namespace quadtree {
 			class Node;
 		}
@@ -45,6 +52,8 @@ namespace quadtree { // geos::index::quadtree
  * \brief
  * QuadRoot is the root of a single Quadtree.  It is centred at the origin,
  * and does not have a defined extent.
+ *
+ * The root owns the pool the nodes of the tree are taken from.
  */
 class GEOS_DLL Root: public NodeBase {
 //friend class Unload;
@@ -53,6 +62,8 @@ private:
 
 	static const geom::Coordinate origin;
 
+	NodePool pool;
+
 	/**
 	 * insert an item which is known to be contained in the tree rooted at
 	 * the given QuadNode root.  Lower levels of the tree will be created
@@ -72,6 +83,25 @@ public:
 	 */
 	void insert(const geom::Envelope *itemEnv, void* item);
 
+	/**
+	 * Removes a single item from the quadtree this is the root of.
+	 *
+	 * @return <code>true</code> if the item was found and removed
+	 */
+	bool remove(const geom::Envelope* itemEnv, void* item);
+
+	/**
+	 * Removes all items and nodes, keeping the storage of the nodes
+	 * for the items inserted next.
+	 */
+	void clear();
+
+	/**
+	 * Adds the shape of the quadtree this is the root of to stats,
+	 * with the memory of its nodes.
+	 */
+	void addStatistics(IndexStatistics& stats) const;
+
 protected:
 
 	bool isSearchMatch(const geom::Envelope& /* searchEnv */) const {
@@ -84,6 +114,10 @@ protected:
 } // namespace geos::index
 } // namespace geos
 
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 #endif // GEOS_IDX_QUADTREE_ROOT_H
 
 /**********************************************************************
@@ -0,0 +1,161 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_RTREE_RSTARTREE_H
+#define GEOS_INDEX_RTREE_RSTARTREE_H
+
+#include <geos/export.h>
+#include <geos/index/SpatialIndex.h> // for inheritance
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		class ItemVisitor;
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace rtree { // geos::index::rtree
+
+/**
+ * \brief
+ * A dynamic R-tree, kept balanced under inserts and removes
+ * with the heuristics of the R*-tree.
+ *
+ * Unlike STRtree, items can be inserted and removed at any time,
+ * between queries. An item is added to the node whose envelope
+ * needs the least enlargement, or, just above the leaves, the
+ * one whose overlap with its siblings grows the least. A node
+ * overflowing for the first time at its level during an insertion
+ * gives up the entries farthest from its centre, which are inserted
+ * again; other overflowing nodes are split along the axis and at
+ * the position where the two halves have the smallest margins and
+ * overlap. Nodes left with too few entries by a removal are
+ * dissolved, and their entries inserted again.
+ *
+ * See N. Beckmann, H.-P. Kriegel, R. Schneider, B. Seeger,
+ * "The R*-tree: an efficient and robust access method for points
+ * and rectangles", SIGMOD 1990.
+ */
+class GEOS_DLL RStarTree : public SpatialIndex {
+
+public:
+
+	/**
+	 * Constructs an empty tree.
+	 *
+	 * @param nodeCapacity the maximum number of children of a node,
+	 *        at least 2
+	 * @throws util::IllegalArgumentException if it is less
+	 */
+	RStarTree(std::size_t nodeCapacity=16);
+
+	~RStarTree();
+
+	/**
+	 * Adds an item. Items with a null envelope are left out,
+	 * as by STRtree.
+	 */
+	void insert(const geom::Envelope *itemEnv, void* item);
+
+	/**
+	 * Appends to matches the items whose envelope intersects searchEnv.
+	 */
+	void query(const geom::Envelope *searchEnv, std::vector<void*>& matches);
+
+	/**
+	 * Visits the items whose envelope intersects searchEnv.
+	 */
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor);
+
+	/**
+	 * Removes an item, found by its envelope.
+	 *
+	 * @return <code>true</code> if the item was found
+	 */
+	bool remove(const geom::Envelope* itemEnv, void* item);
+
+	/// @return the number of items in the tree
+	std::size_t size() const { return numItems; }
+
+	/// @return the number of levels of nodes, 1 for a single leaf
+	std::size_t depth() const;
+
+private:
+
+	class Node;
+
+	/// A child of a node: another node, or an item in a leaf
+	struct Entry;
+
+	Node* root;
+
+	std::size_t numItems;
+
+	std::size_t maxEntries;
+
+	std::size_t minEntries;
+
+	/// The number of entries given up by a node for reinsertion
+	std::size_t reinsertCount;
+
+	/// Inserts an entry in a node at the given level, 0 for leaves
+	void insert(const Entry& entry, std::size_t level);
+
+	Node* insert(Node* node, const Entry& entry, std::size_t level,
+	             std::vector<bool>& overflowed, std::vector<Entry>& reinserts);
+
+	Node* overflow(Node* node, std::vector<bool>& overflowed,
+	               std::vector<Entry>& reinserts);
+
+	std::size_t chooseSubtree(const Node& node, const geom::Envelope& env) const;
+
+	Node* split(Node* node) const;
+
+	bool remove(Node* node, const geom::Envelope& env, void* item,
+	            std::vector<Node*>& orphans);
+
+	/// Inserts again the entries of a node removed from the tree
+	void reinsertOrphan(Node* orphan);
+
+	template <class Visit>
+	void query(const Node& node, const geom::Envelope& searchEnv,
+	           Visit& visit) const;
+
+	static void deleteTree(Node* node);
+
+	// Declare type as noncopyable
+	RStarTree(const RStarTree& other);
+	RStarTree& operator=(const RStarTree& rhs);
+};
+
+} // namespace geos::index::rtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_RTREE_RSTARTREE_H
@@ -73,7 +73,7 @@ public:
 	 */  
 	const void* getBounds() const;
 
-	int getLevel();
+	int getLevel() const;
 
 	void addChildBoundable(Boundable *childBoundable);
 
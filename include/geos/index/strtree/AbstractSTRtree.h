@@ -205,6 +205,11 @@ protected:
 		return root;
 	}
 
+	/// Builds the tree, unless already built
+	void ensureBuilt() {
+		if (!built) build();
+	}
+
 	///  Also builds the tree, if necessary.
 	virtual void insert(const void* bounds,void* item);
 
@@ -269,12 +274,19 @@ public:
 
 	/**
 	 * Creates parent nodes, grandparent nodes, and so forth up to the root
-	 * node, for the data that has been inserted into the tree. Can only be
-	 * called once, and thus can be called only after all of the data has been
-	 * inserted into the tree.
+	 * node, for the data that has been inserted into the tree. Does
+	 * nothing if the tree is already built; no more data can be
+	 * inserted afterwards.
+	 *
+	 * The bounds of all the nodes are computed here, so that once
+	 * built the tree is not modified by queries, and may be queried
+	 * from several threads at a time (but not have items removed).
 	 */
 	virtual void build();
 
+	/// @return whether build has been called, explicitly or by a query
+	bool isBuilt() const { return built; }
+
 	/**
 	 * Returns the maximum number of child nodes that a node may have
 	 */
@@ -0,0 +1,46 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_BATCHQUERYVISITOR_H
+#define GEOS_INDEX_STRTREE_BATCHQUERYVISITOR_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * A visitor for the items found by a batch of queries,
+ * such as STRtree::queryMany.
+ */
+class GEOS_DLL BatchQueryVisitor {
+
+public:
+
+	/**
+	 * @param queryIndex the index of the query envelope
+	 * @param item an item whose envelope intersects it
+	 */
+	virtual void visitItem(std::size_t queryIndex, void* item)=0;
+
+	virtual ~BatchQueryVisitor() {}
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_BATCHQUERYVISITOR_H
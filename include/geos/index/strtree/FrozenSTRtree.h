@@ -0,0 +1,144 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_FROZENSTRTREE_H
+#define GEOS_INDEX_STRTREE_FROZENSTRTREE_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		class ItemVisitor;
+		namespace strtree {
+			class STRtree;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * An immutable copy of a built STRtree, laid out in flat arrays
+ * for fast queries.
+ *
+ * The nodes and items of the tree are numbered level by level,
+ * from the root down to the items, and their envelopes are stored
+ * contiguously in that order, as minX, minY, maxX, maxY quadruples.
+ * The children of a node are consecutive entries, addressed by
+ * the index of the first one; the items come last.
+ *
+ * Queries run as a loop over these arrays, without virtual calls
+ * or casts, and visit the items in the same order as STRtree.
+ * The frozen tree does not depend on the STRtree it was copied from,
+ * which can be deleted; the items are not owned by either.
+ *
+ * A frozen tree can also be bulk-loaded from an array of items,
+ * without building an STRtree first.
+ */
+class GEOS_DLL FrozenSTRtree {
+
+friend class MappedSTRtree;
+
+public:
+
+	/**
+	 * Copies the given tree, building it if necessary.
+	 */
+	explicit FrozenSTRtree(STRtree& tree);
+
+	/** \brief
+	 * Bulk-loads a tree with the Sort-Tile-Recursive algorithm.
+	 *
+	 * Each level is packed in place in a single array: sorted by
+	 * the x of the envelope centres, cut into vertical slices, each
+	 * slice sorted by the y of the centres, then grouped into nodes.
+	 * Items with a null envelope are left out, as by STRtree.
+	 * All the sorting runs on the calling thread.
+	 *
+	 * @param entries the items, each with its envelope
+	 * @param nodeCapacity the maximum number of children of a node
+	 */
+	explicit FrozenSTRtree(
+		const std::vector< std::pair<geom::Envelope, void*> >& entries,
+		std::size_t nodeCapacity=10);
+
+	/**
+	 * Appends to matches the items whose envelope intersects searchEnv.
+	 */
+	void query(const geom::Envelope *searchEnv,
+	           std::vector<void*>& matches) const;
+
+	/**
+	 * Visits the items whose envelope intersects searchEnv.
+	 */
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor) const;
+
+	/// @return the number of items in the tree
+	std::size_t size() const { return items.size(); }
+
+	/// @return the number of nodes in the tree, not counting the items
+	std::size_t getNumNodes() const { return firstItem; }
+
+	/// @return the number of bytes taken by the tree arrays
+	std::size_t getMemorySize() const;
+
+private:
+
+	/// minX, minY, maxX, maxY of each entry, nodes first then items
+	std::vector<double> bounds;
+
+	/// Index of the first child of each node, plus the number
+	/// of entries at the end
+	std::vector<std::size_t> childStart;
+
+	/// The item of each entry from firstItem on
+	std::vector<void*> items;
+
+	/// Index of the first item entry, equal to the number of nodes
+	std::size_t firstItem;
+
+	/// Bound on the number of nodes pending during a query
+	std::size_t maxPending;
+
+	template <class Visit>
+	void query(const geom::Envelope& searchEnv, Visit& visit) const;
+
+	// Declare type as noncopyable
+	FrozenSTRtree(const FrozenSTRtree& other);
+	FrozenSTRtree& operator=(const FrozenSTRtree& rhs);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_FROZENSTRTREE_H
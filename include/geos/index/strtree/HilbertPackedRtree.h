@@ -0,0 +1,88 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_HILBERTPACKEDRTREE_H
+#define GEOS_INDEX_STRTREE_HILBERTPACKEDRTREE_H
+
+#include <geos/export.h>
+#include <geos/index/strtree/STRtree.h> // for inheritance
+
+#include <memory>
+#include <cstddef>
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * A query-only R-tree packed in the order of the Hilbert curve,
+ * usable wherever an STRtree is.
+ *
+ * Each level of the tree is sorted by the Hilbert index of the
+ * centres of the envelopes, on a 65536 x 65536 grid over their
+ * extent, and cut into runs of nodeCapacity children.
+ * Unlike the vertical slices of STR packing, this keeps nodes
+ * compact when the data is skewed, such as clustered points or
+ * long thin envelopes.
+ *
+ * Described in: I. Kamel and C. Faloutsos. On Packing R-trees.
+ * CIKM 1993.
+ */
+class GEOS_DLL HilbertPackedRtree: public STRtree
+{
+
+public:
+
+	/**
+	 * Constructs a tree with the given maximum number of
+	 * children that a node may have.
+	 */
+	HilbertPackedRtree(std::size_t nodeCapacity=10);
+
+	~HilbertPackedRtree();
+
+	/**
+	 * Computes the index of a cell along the Hilbert curve
+	 * filling a 65536 x 65536 grid.
+	 *
+	 * @param x the column of the cell, less than 65536
+	 * @param y the row of the cell, less than 65536
+	 * @return the position of the cell along the curve
+	 */
+	static unsigned int hilbertIndex(unsigned int x, unsigned int y);
+
+	/**
+	 * Computes the Hilbert index of the centre of an envelope,
+	 * on the 65536 x 65536 grid covering an extent.
+	 *
+	 * @param env a non-null envelope, within extent
+	 * @param extent the extent of the grid
+	 * @return the position of the cell of the centre along the curve
+	 */
+	static unsigned int hilbertIndex(const geom::Envelope& env,
+	                                 const geom::Envelope& extent);
+
+private:
+
+	std::auto_ptr<BoundableList> createParentBoundables(
+			BoundableList* childBoundables, int newLevel);
+
+	/// Sorts by the Hilbert index of the centres of the envelopes
+	std::auto_ptr<BoundableList> sortBoundables(const BoundableList* input);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_HILBERTPACKEDRTREE_H
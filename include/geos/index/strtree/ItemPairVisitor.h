@@ -0,0 +1,44 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_ITEMPAIRVISITOR_H
+#define GEOS_INDEX_STRTREE_ITEMPAIRVISITOR_H
+
+#include <geos/export.h>
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * A visitor for the pairs of items found by a traversal of
+ * two STRtrees, such as STRtree::intersectingPairs.
+ */
+class GEOS_DLL ItemPairVisitor {
+
+public:
+
+	/**
+	 * @param item1 an item of the first tree
+	 * @param item2 an item of the second tree
+	 */
+	virtual void visitPair(void* item1, void* item2)=0;
+
+	virtual ~ItemPairVisitor() {}
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_ITEMPAIRVISITOR_H
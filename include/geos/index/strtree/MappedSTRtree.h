@@ -0,0 +1,176 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_MAPPEDSTRTREE_H
+#define GEOS_INDEX_STRTREE_MAPPEDSTRTREE_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for int64
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		namespace strtree {
+			class FrozenSTRtree;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * A FrozenSTRtree saved to a file, queried in place.
+ *
+ * The file holds the arrays of a FrozenSTRtree, with each item
+ * replaced by a 64-bit id. All values are little-endian: a 32 byte
+ * header made of the magic "GEOSSTRT", the 32-bit format version,
+ * 32 reserved bits, the number of nodes and the number of items
+ * as 64-bit integers; then the envelopes as minX, minY, maxX, maxY
+ * doubles, the index of the first child of each node followed by
+ * the number of entries, and the ids, as 64-bit integers.
+ *
+ * On little-endian machines, the file is memory-mapped read-only
+ * and queried without being read, so that processes opening it
+ * share its pages. Elsewhere, or where mapping is not available,
+ * it is read into memory instead.
+ */
+class GEOS_DLL MappedSTRtree {
+
+public:
+
+	/// The format version written by this class
+	static const int VERSION = 1;
+
+	/// Gives the id to save for each item of a tree
+	class GEOS_DLL ItemIdentifier {
+	public:
+		virtual int64 getId(void* item)=0;
+		virtual ~ItemIdentifier() {}
+	};
+
+	/**
+	 * Writes a tree in the format read by this class.
+	 *
+	 * @param tree the tree to write
+	 * @param ids gives the id of each item
+	 * @param os the stream to write to, opened in binary mode
+	 * @throws util::GEOSException if the stream fails
+	 */
+	static void write(const FrozenSTRtree& tree, ItemIdentifier& ids,
+	                  std::ostream& os);
+
+	/**
+	 * Writes a tree to the named file, which is replaced.
+	 *
+	 * @throws util::GEOSException if the file cannot be written
+	 */
+	static void write(const FrozenSTRtree& tree, ItemIdentifier& ids,
+	                  const std::string& filename);
+
+	/**
+	 * Opens a tree written to the named file.
+	 *
+	 * The structure of the tree is checked, in time linear in
+	 * the number of nodes, so that queries cannot fail on it.
+	 *
+	 * @throws util::GEOSException if the file cannot be read
+	 *         or is not a valid tree
+	 */
+	explicit MappedSTRtree(const std::string& filename);
+
+	/**
+	 * Uses an image of a file in memory, which must outlive this
+	 * object, unless it has to be copied, on big-endian machines.
+	 *
+	 * @param data the image, aligned on 8 bytes
+	 * @param size the size of the image, in bytes
+	 * @throws util::GEOSException if the image is not a valid tree
+	 */
+	MappedSTRtree(const void* data, std::size_t size);
+
+	~MappedSTRtree();
+
+	/**
+	 * Appends to ids the ids of the items whose envelope
+	 * intersects searchEnv, in the order of FrozenSTRtree::query.
+	 */
+	void query(const geom::Envelope *searchEnv,
+	           std::vector<int64>& ids) const;
+
+	/// @return the number of items in the tree
+	std::size_t size() const { return numItems; }
+
+	/// @return the number of nodes in the tree, not counting the items
+	std::size_t getNumNodes() const { return numNodes; }
+
+	/// @return whether the file is memory-mapped
+	bool isMapped() const { return mapping != 0; }
+
+private:
+
+	/// The memory-mapped file, or 0
+	void* mapping;
+
+	std::size_t mappingSize;
+
+	/// The arrays read into memory, when not used in place
+	std::vector<double> boundsCopy;
+	std::vector<int64> indexCopy;
+
+	const double* bounds;
+
+	const int64* childStart;
+
+	const int64* ids;
+
+	std::size_t numNodes;
+
+	std::size_t numItems;
+
+	std::size_t maxPending;
+
+	void open(const std::string& filename);
+
+	/// Checks the image and points the arrays into it,
+	/// or into a copy if asked or needed
+	void attach(const void* data, std::size_t size, bool copy);
+
+	// Declare type as noncopyable
+	MappedSTRtree(const MappedSTRtree& other);
+	MappedSTRtree& operator=(const MappedSTRtree& rhs);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_MAPPEDSTRTREE_H
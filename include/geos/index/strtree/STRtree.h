@@ -22,9 +22,11 @@
 #include <geos/export.h>
 #include <geos/index/strtree/AbstractSTRtree.h> // for inheritance
 #include <geos/index/SpatialIndex.h> // for inheritance
+#include <geos/index/IndexStatistics.h> // for return by value
 #include <geos/geom/Envelope.h> // for inlines
 
 #include <vector>
+#include <utility> // for std::pair
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -34,8 +36,12 @@
 // Forward declarations
 namespace geos {
 	namespace index { 
+		struct QueryStatistics;
 		namespace strtree { 
 			class Boundable;
+			class ItemDistance;
+			class ItemPairVisitor;
+			class BatchQueryVisitor;
 		}
 	}
 }
@@ -64,6 +70,8 @@ class GEOS_DLL STRtree: public AbstractSTRtree, public SpatialIndex
 using AbstractSTRtree::insert;
 using AbstractSTRtree::query;
 
+friend class FrozenSTRtree;
+
 private:
 	class GEOS_DLL STRIntersectsOp: public AbstractSTRtree::IntersectsOp {
 		public:
@@ -92,12 +100,20 @@ private:
 	/**
 	 * @param childBoundables Must be sorted by the x-value of
 	 *        the envelope midpoints
+	 * @param sliceCount the number of slices to cut, each a whole
+	 *        number of nodes; fewer are returned if the last ones
+	 *        would be empty
 	 * @return
 	 */
 	std::vector<BoundableList*>* verticalSlices(
 			BoundableList* childBoundables,
 			size_t sliceCount);
 
+	/// The const queries, counting their work in stats
+	template <class Stats>
+	void queryTree(const geom::Envelope *searchEnv, ItemVisitor& visitor,
+	               Stats& stats) const;
+
 
 protected:
 
@@ -119,12 +135,14 @@ public:
 
 	void insert(const geom::Envelope *itemEnv,void* item);
 
-	//static double centreX(const geom::Envelope *e);
-
 	static double avg(double a, double b) {
 		return (a + b) / 2.0;
 	}
 
+	static double centreX(const geom::Envelope *e) {
+		return STRtree::avg(e->getMinX(), e->getMaxX());
+	}
+
 	static double centreY(const geom::Envelope *e) {
 		return STRtree::avg(e->getMinY(), e->getMaxY());
 	}
@@ -137,9 +155,138 @@ public:
 		return AbstractSTRtree::query(searchEnv, visitor);
 	}
 
+	/**
+	 * \brief
+	 * Finds the items whose envelopes intersect searchEnv, without
+	 * modifying the tree.
+	 *
+	 * The tree must have been built (see build()). Several threads
+	 * may then query it at the same time, with no locking, as long
+	 * as none removes items.
+	 *
+	 * @throws util::IllegalStateException if the tree is not built
+	 */
+	void query(const geom::Envelope *searchEnv,
+	           std::vector<void*>& matches) const;
+
+	/// As above, passing the items to a visitor
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor) const;
+
+	/**
+	 * As above, adding the nodes visited, the leaves whose items
+	 * were tested and the items found to stats. Queries without
+	 * statistics do no counting at all.
+	 *
+	 * @throws util::IllegalStateException if the tree is not built
+	 */
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor,
+	           QueryStatistics& stats) const;
+
+	/**
+	 * Reports the shape of the tree, in which the overlap is the
+	 * one of sibling nodes, not of the items of a leaf.
+	 * Also builds the tree, if necessary.
+	 */
+	IndexStatistics getStatistics();
+
 	bool remove(const geom::Envelope *itemEnv, void* item) {
 		return AbstractSTRtree::remove(itemEnv, item);
 	}
+
+	/**
+	 * \brief
+	 * Finds the k items of this tree nearest to the given item,
+	 * which need not be in the tree.
+	 *
+	 * The tree is searched best-first, visiting nodes in order of
+	 * the distance of their envelopes, so only the nodes closer
+	 * than the k-th nearest item are expanded.
+	 * Also builds the tree, if necessary.
+	 *
+	 * @param env the envelope of the query item
+	 * @param item the query item, passed to itemDist
+	 * @param k the number of items to find
+	 * @param itemDist the distance between items
+	 * @param result the nearest items are appended here,
+	 *        by increasing distance; fewer than k if the tree
+	 *        does not have as many
+	 */
+	void nearestNeighbour(const geom::Envelope *env, const void* item,
+	                      std::size_t k, ItemDistance& itemDist,
+	                      std::vector<void*>& result);
+
+	/**
+	 * \brief
+	 * Finds the k pairs of items, one from this tree and one from
+	 * the given tree, with the smallest distance.
+	 *
+	 * Pairs of nodes are expanded best-first, as for the search
+	 * of the nearest neighbours of a single item.
+	 * Also builds both trees, if necessary.
+	 *
+	 * @param tree the other tree
+	 * @param k the number of pairs to find
+	 * @param itemDist the distance between items, given an item
+	 *        of this tree first
+	 * @param result the nearest pairs are appended here, by
+	 *        increasing distance, each with the item of this tree
+	 *        first; fewer than k if there are not as many
+	 */
+	void nearestNeighbour(STRtree& tree, std::size_t k,
+	                      ItemDistance& itemDist,
+	                      std::vector< std::pair<void*, void*> >& result);
+
+	/**
+	 * \brief
+	 * Visits the pairs of items, one from this tree and one from
+	 * the given tree, whose envelopes intersect.
+	 *
+	 * Both trees are walked together, depth-first, so a pair of
+	 * nodes is only expanded if their envelopes intersect, and
+	 * pairs are passed to the visitor as they are found.
+	 * Also builds both trees, if necessary.
+	 *
+	 * The pairs can be split into numParts parts, found by as
+	 * many calls with part from 0 to numParts-1, which may run on
+	 * different threads once both trees have been built.
+	 *
+	 * @param tree the other tree
+	 * @param visitor given the pairs, the item of this tree first
+	 * @param part the part of the pairs to visit
+	 * @param numParts the number of parts
+	 * @throws util::IllegalArgumentException if part is not less
+	 *         than numParts
+	 */
+	void intersectingPairs(STRtree& tree, ItemPairVisitor& visitor,
+	                       std::size_t part=0, std::size_t numParts=1);
+
+	/**
+	 * \brief
+	 * Finds the items whose envelopes intersect each of many query
+	 * envelopes.
+	 *
+	 * The queries are sorted along the Hilbert curve and grouped,
+	 * and each group walks the tree once, carrying down each node
+	 * the queries intersecting it, so the upper levels are not
+	 * traversed again for every query.
+	 * The pairs are passed to the visitor in no particular order.
+	 * Also builds the tree, if necessary.
+	 *
+	 * The groups can be split into numParts parts, queried by as
+	 * many calls with part from 0 to numParts-1, which may run on
+	 * different threads once the tree has been built.
+	 *
+	 * @param searchEnvs the query envelopes; null ones find nothing
+	 * @param numEnvs the number of query envelopes
+	 * @param visitor given the index of a query and an item found
+	 * @param part the part of the queries to run
+	 * @param numParts the number of parts
+	 * @throws util::IllegalArgumentException if part is not less
+	 *         than numParts
+	 */
+	void queryMany(const geom::Envelope* searchEnvs, std::size_t numEnvs,
+	               BatchQueryVisitor& visitor,
+	               std::size_t part=0, std::size_t numParts=1);
 };
 
 } // namespace geos::index::strtree
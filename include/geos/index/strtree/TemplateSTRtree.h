@@ -0,0 +1,562 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_TEMPLATESTRTREE_H
+#define GEOS_INDEX_STRTREE_TEMPLATESTRTREE_H
+
+#include <geos/index/SpatialIndex.h> // for inheritance
+#include <geos/index/ItemVisitor.h> // for TemplateSTRtreeSpatialIndex
+#include <geos/geom/Envelope.h> // for BoundsTraits<Envelope>
+#include <geos/util/UnsupportedOperationException.h>
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * The operations TemplateSTRtree needs on the bounds of its items.
+ *
+ * Specialise it for other bounds types. The centres are only
+ * compared, and may be scaled.
+ */
+template <class BoundsType>
+struct BoundsTraits;
+
+template <>
+struct BoundsTraits<geom::Envelope>
+{
+	static bool isNull(const geom::Envelope& b)
+	{
+		return b.isNull();
+	}
+
+	/// For non-null bounds
+	static bool intersects(const geom::Envelope& a, const geom::Envelope& b)
+	{
+		return a.getMinX() <= b.getMaxX() && a.getMaxX() >= b.getMinX() &&
+		       a.getMinY() <= b.getMaxY() && a.getMaxY() >= b.getMinY();
+	}
+
+	static void expandToInclude(geom::Envelope& a, const geom::Envelope& b)
+	{
+		a.expandToInclude(&b);
+	}
+
+	static double getCentreX(const geom::Envelope& b)
+	{
+		return b.getMinX() + b.getMaxX();
+	}
+
+	static double getCentreY(const geom::Envelope& b)
+	{
+		return b.getMinY() + b.getMaxY();
+	}
+};
+
+/**
+ * \brief
+ * An STRtree of items of a given type, stored by value, with the
+ * query visitors called inline.
+ *
+ * Items are added with their bounds, then the tree is packed with
+ * the Sort-Tile-Recursive algorithm on the first query, or by
+ * build(), after which no more items can be added. The nodes and
+ * the items are kept in two arrays, the children of a node being
+ * consecutive entries.
+ *
+ * A visitor is any object callable with a const ItemType&; unlike
+ * an ItemVisitor, it is not called through a virtual function nor
+ * given a void pointer.
+ *
+ * @tparam ItemType the type of the items, copyable
+ * @tparam BoundsType the type of the bounds, with a BoundsTraits
+ *         specialisation
+ */
+template <class ItemType, class BoundsType = geom::Envelope>
+class TemplateSTRtree {
+
+public:
+
+	typedef BoundsTraits<BoundsType> Traits;
+
+	/**
+	 * Constructs an empty tree.
+	 *
+	 * @param nNodeCapacity the maximum number of children of a node
+	 */
+	TemplateSTRtree(std::size_t nNodeCapacity=10)
+		:
+		nodeCapacity(nNodeCapacity),
+		numLeafNodes(0),
+		built(false)
+	{
+		assert(nodeCapacity > 1);
+	}
+
+	/**
+	 * Adds an item, unless its bounds are null.
+	 * The tree must not have been built.
+	 */
+	void insert(const BoundsType& bounds, const ItemType& item)
+	{
+		assert(!built);
+		if ( Traits::isNull(bounds) ) return;
+		entries.push_back(Entry(bounds, item));
+	}
+
+	/**
+	 * Packs the tree, if not already done.
+	 */
+	void build()
+	{
+		if ( built ) return;
+		built = true;
+		if ( entries.empty() ) return;
+
+		packLevel(entries, nodes);
+		numLeafNodes = nodes.size();
+
+		std::size_t levelStart = 0;
+		std::vector<Node> parents;
+		while ( nodes.size() - levelStart > 1 )
+		{
+			std::size_t levelEnd = nodes.size();
+			parents.clear();
+			packLevel(nodes, levelStart, levelEnd, parents);
+			nodes.insert(nodes.end(), parents.begin(), parents.end());
+			levelStart = levelEnd;
+		}
+	}
+
+	/**
+	 * Calls visitor with each item whose bounds intersect
+	 * searchBounds, building the tree if necessary.
+	 */
+	template <class Visitor>
+	void query(const BoundsType& searchBounds, Visitor& visitor)
+	{
+		build();
+		if ( nodes.empty() || Traits::isNull(searchBounds) ) return;
+
+		std::size_t root = nodes.size() - 1;
+		if ( Traits::intersects(nodes[root].bounds, searchBounds) )
+			query(root, searchBounds, visitor);
+	}
+
+	/**
+	 * Appends to matches the items whose bounds intersect
+	 * searchBounds, building the tree if necessary.
+	 */
+	void query(const BoundsType& searchBounds, std::vector<ItemType>& matches)
+	{
+		MatchesCollector collector(matches);
+		query(searchBounds, collector);
+	}
+
+	/**
+	 * Finds the item nearest to a target, building the tree if
+	 * necessary.
+	 *
+	 * The metric gives the distances from the target, that to
+	 * bounds being no more than that to any item within them:
+	 *
+	 *     double boundsDistance(const BoundsType& bounds);
+	 *     double itemDistance(const ItemType& item);
+	 *
+	 * Nodes are searched nearest bounds first, skipping those
+	 * farther than the nearest item found so far or than
+	 * maxDistance. The search stops at the first item found no
+	 * farther than stopDistance, which may not be the nearest.
+	 *
+	 * @param distance set to the distance of the item found
+	 * @return the item found, or 0 if none is within maxDistance
+	 */
+	template <class Metric>
+	const ItemType* nearest(Metric& metric, double& distance,
+	        double maxDistance = std::numeric_limits<double>::infinity(),
+	        double stopDistance = -1)
+	{
+		build();
+		distance = maxDistance;
+		if ( nodes.empty() ) return 0;
+
+		typedef std::pair<double, std::size_t> QueueEntry;
+		std::priority_queue< QueueEntry, std::vector<QueueEntry>,
+		                     std::greater<QueueEntry> > queue;
+
+		const ItemType* found = 0;
+		std::size_t root = nodes.size() - 1;
+		double d = metric.boundsDistance(nodes[root].bounds);
+		if ( d <= distance ) queue.push(QueueEntry(d, root));
+
+		while ( ! queue.empty() )
+		{
+			QueueEntry top = queue.top();
+			queue.pop();
+			if ( isBeyond(top.first, distance, found) ) break;
+
+			const Node& node = nodes[top.second];
+			std::size_t end = node.first + node.count;
+			if ( top.second < numLeafNodes )
+			{
+				for (std::size_t i=node.first; i<end; ++i)
+				{
+					const Entry& e = entries[i];
+					if ( isBeyond(metric.boundsDistance(e.bounds), distance, found) )
+						continue;
+					d = metric.itemDistance(e.item);
+					if ( isBeyond(d, distance, found) ) continue;
+					found = &e.item;
+					distance = d;
+					if ( distance <= stopDistance ) return found;
+				}
+				continue;
+			}
+
+			for (std::size_t i=node.first; i<end; ++i)
+			{
+				d = metric.boundsDistance(nodes[i].bounds);
+				if ( ! isBeyond(d, distance, found) )
+					queue.push(QueueEntry(d, i));
+			}
+		}
+		return found;
+	}
+
+	/**
+	 * Finds the nearest pair of an item of this tree and one of
+	 * other, building the trees if necessary.
+	 *
+	 * The metric gives the distances between the bounds and the
+	 * items of the two trees, that between bounds being no more
+	 * than that between any items within them:
+	 *
+	 *     double boundsDistance(const BoundsType& b0, const BoundsType& b1);
+	 *     double itemDistance(const ItemType& item0, const ItemType& item1);
+	 *
+	 * Pairs of nodes are searched nearest first, as by nearest(),
+	 * splitting both nodes of a pair, or the one which is not a
+	 * leaf, into the pairs of their children.
+	 *
+	 * @param distance set to the distance of the pair found
+	 * @return the pair found, or two null pointers if none is
+	 *         within maxDistance
+	 */
+	template <class Metric>
+	std::pair<const ItemType*, const ItemType*>
+	nearestPair(TemplateSTRtree& other, Metric& metric, double& distance,
+	        double maxDistance = std::numeric_limits<double>::infinity(),
+	        double stopDistance = -1)
+	{
+		build();
+		other.build();
+		distance = maxDistance;
+		std::pair<const ItemType*, const ItemType*> found(0, 0);
+		if ( nodes.empty() || other.nodes.empty() ) return found;
+
+		typedef std::pair<std::size_t, std::size_t> NodePair;
+		typedef std::pair<double, NodePair> QueueEntry;
+		std::priority_queue< QueueEntry, std::vector<QueueEntry>,
+		                     std::greater<QueueEntry> > queue;
+
+		NodePair roots(nodes.size() - 1, other.nodes.size() - 1);
+		double d = metric.boundsDistance(nodes[roots.first].bounds,
+		                                 other.nodes[roots.second].bounds);
+		if ( d <= distance ) queue.push(QueueEntry(d, roots));
+
+		while ( ! queue.empty() )
+		{
+			QueueEntry top = queue.top();
+			queue.pop();
+			if ( isBeyond(top.first, distance, found.first) ) break;
+
+			std::size_t n0 = top.second.first;
+			std::size_t n1 = top.second.second;
+			bool isLeaf0 = n0 < numLeafNodes;
+			bool isLeaf1 = n1 < other.numLeafNodes;
+			const Node& node0 = nodes[n0];
+			const Node& node1 = other.nodes[n1];
+
+			if ( isLeaf0 && isLeaf1 )
+			{
+				for (std::size_t i=node0.first; i<node0.first+node0.count; ++i)
+				{
+					const Entry& e0 = entries[i];
+					for (std::size_t j=node1.first; j<node1.first+node1.count; ++j)
+					{
+						const Entry& e1 = other.entries[j];
+						d = metric.boundsDistance(e0.bounds, e1.bounds);
+						if ( isBeyond(d, distance, found.first) ) continue;
+						d = metric.itemDistance(e0.item, e1.item);
+						if ( isBeyond(d, distance, found.first) ) continue;
+						found.first = &e0.item;
+						found.second = &e1.item;
+						distance = d;
+						if ( distance <= stopDistance ) return found;
+					}
+				}
+				continue;
+			}
+
+			// a leaf stands for itself among the pairs of children
+			std::size_t begin0 = isLeaf0 ? n0 : node0.first;
+			std::size_t end0 = isLeaf0 ? n0 + 1 : node0.first + node0.count;
+			std::size_t begin1 = isLeaf1 ? n1 : node1.first;
+			std::size_t end1 = isLeaf1 ? n1 + 1 : node1.first + node1.count;
+			for (std::size_t i=begin0; i<end0; ++i)
+			{
+				for (std::size_t j=begin1; j<end1; ++j)
+				{
+					d = metric.boundsDistance(nodes[i].bounds,
+					                          other.nodes[j].bounds);
+					if ( ! isBeyond(d, distance, found.first) )
+						queue.push(QueueEntry(d, NodePair(i, j)));
+				}
+			}
+		}
+		return found;
+	}
+
+	/**
+	 * Calls visitor with every item, building the tree if necessary.
+	 */
+	template <class Visitor>
+	void iterate(Visitor& visitor)
+	{
+		build();
+		for (std::size_t i=0; i<entries.size(); ++i)
+			visitor(entries[i].item);
+	}
+
+	/// @return the number of items in the tree
+	std::size_t size() const { return entries.size(); }
+
+	/// @return whether the tree has no item
+	bool isEmpty() const { return entries.empty(); }
+
+	/// @return the number of nodes in the tree, not counting the items
+	std::size_t getNumNodes() const { return nodes.size(); }
+
+private:
+
+	struct Entry
+	{
+		Entry(const BoundsType& b, const ItemType& i) : bounds(b), item(i) {}
+		BoundsType bounds;
+		ItemType item;
+	};
+
+	/// Its children are the entries [first, first+count) of the level below
+	struct Node
+	{
+		BoundsType bounds;
+		std::size_t first;
+		std::size_t count;
+	};
+
+	struct MatchesCollector
+	{
+		MatchesCollector(std::vector<ItemType>& m) : matches(m) {}
+		void operator()(const ItemType& item) { matches.push_back(item); }
+		std::vector<ItemType>& matches;
+	};
+
+	template <class E>
+	struct LessCentreX
+	{
+		bool operator()(const E& a, const E& b) const
+		{
+			return Traits::getCentreX(a.bounds) < Traits::getCentreX(b.bounds);
+		}
+	};
+
+	template <class E>
+	struct LessCentreY
+	{
+		bool operator()(const E& a, const E& b) const
+		{
+			return Traits::getCentreY(a.bounds) < Traits::getCentreY(b.bounds);
+		}
+	};
+
+	std::size_t nodeCapacity;
+
+	/// The items, in the order of their leaves once built
+	std::vector<Entry> entries;
+
+	/// The nodes, level by level from the leaves up to the root
+	std::vector<Node> nodes;
+
+	/// The number of nodes whose children are items
+	std::size_t numLeafNodes;
+
+	bool built;
+
+	template <class E>
+	void packLevel(std::vector<E>& children, std::vector<Node>& parents)
+	{
+		packLevel(children, 0, children.size(), parents);
+	}
+
+	/*
+	 * Sorts the children [begin, end) as STR does, and appends to
+	 * parents the nodes grouping them: sorted by the x of their
+	 * centres, cut into vertical slices, each slice sorted by the y
+	 * of the centres, then grouped.
+	 */
+	template <class E>
+	void packLevel(std::vector<E>& children, std::size_t begin,
+	               std::size_t end, std::vector<Node>& parents)
+	{
+		typedef typename std::vector<E>::iterator Iter;
+		std::size_t n = end - begin;
+		Iter first = children.begin() + begin;
+		std::sort(first, first + n, LessCentreX<E>());
+
+		std::size_t minLeafCount = (n + nodeCapacity - 1) / nodeCapacity;
+		std::size_t sliceCount =
+			std::size_t(std::ceil(std::sqrt(double(minLeafCount))));
+		// whole nodes per slice, as in STRtree::verticalSlices
+		std::size_t sliceCapacity = nodeCapacity *
+			((minLeafCount + sliceCount - 1) / sliceCount);
+
+		for (std::size_t slice=begin; slice<end; slice+=sliceCapacity)
+		{
+			std::size_t sliceEnd = std::min(slice + sliceCapacity, end);
+			std::sort(children.begin() + slice, children.begin() + sliceEnd,
+			          LessCentreY<E>());
+
+			for (std::size_t i=slice; i<sliceEnd; i+=nodeCapacity)
+			{
+				Node node;
+				node.bounds = children[i].bounds;
+				node.first = i;
+				node.count = std::min(i + nodeCapacity, sliceEnd) - i;
+				for (std::size_t j=i+1; j<i+node.count; ++j)
+					Traits::expandToInclude(node.bounds, children[j].bounds);
+				parents.push_back(node);
+			}
+		}
+	}
+
+	/// Whether nothing at distance d can be nearer than what was found
+	static bool isBeyond(double d, double distance, const ItemType* found)
+	{
+		return found ? d >= distance : d > distance;
+	}
+
+	/// Visits the subtree of a node intersecting searchBounds
+	template <class Visitor>
+	void query(std::size_t nodeIndex, const BoundsType& searchBounds,
+	           Visitor& visitor) const
+	{
+		const Node& node = nodes[nodeIndex];
+		std::size_t end = node.first + node.count;
+		if ( nodeIndex < numLeafNodes )
+		{
+			for (std::size_t i=node.first; i<end; ++i)
+			{
+				const Entry& e = entries[i];
+				if ( Traits::intersects(e.bounds, searchBounds) )
+					visitor(e.item);
+			}
+			return;
+		}
+
+		for (std::size_t i=node.first; i<end; ++i)
+		{
+			if ( Traits::intersects(nodes[i].bounds, searchBounds) )
+				query(i, searchBounds, visitor);
+		}
+	}
+};
+
+/**
+ * \brief
+ * A SpatialIndex over a TemplateSTRtree of pointers, for the code
+ * written against SpatialIndex.
+ *
+ * Items go through void pointers, and are visited through
+ * ItemVisitor, as for STRtree. Items cannot be removed.
+ */
+template <class T>
+class TemplateSTRtreeSpatialIndex : public SpatialIndex {
+
+public:
+
+	typedef TemplateSTRtree<T*> Tree;
+
+	TemplateSTRtreeSpatialIndex(Tree& t) : tree(t) {}
+
+	void insert(const geom::Envelope *itemEnv, void *item)
+	{
+		tree.insert(*itemEnv, static_cast<T*>(item));
+	}
+
+	void query(const geom::Envelope* searchEnv, std::vector<void*>& matches)
+	{
+		MatchesCollector collector(matches);
+		tree.query(*searchEnv, collector);
+	}
+
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor)
+	{
+		VisitorCaller caller(visitor);
+		tree.query(*searchEnv, caller);
+	}
+
+	/// @throws util::UnsupportedOperationException always
+	bool remove(const geom::Envelope*, void*)
+	{
+		throw util::UnsupportedOperationException(
+			"TemplateSTRtree does not support remove");
+	}
+
+private:
+
+	struct MatchesCollector
+	{
+		MatchesCollector(std::vector<void*>& m) : matches(m) {}
+		void operator()(T* item) { matches.push_back(item); }
+		std::vector<void*>& matches;
+	};
+
+	struct VisitorCaller
+	{
+		VisitorCaller(ItemVisitor& v) : visitor(v) {}
+		void operator()(T* item) { visitor.visitItem(item); }
+		ItemVisitor& visitor;
+	};
+
+	Tree& tree;
+
+	// Declare type as noncopyable
+	TemplateSTRtreeSpatialIndex(const TemplateSTRtreeSpatialIndex& other);
+	TemplateSTRtreeSpatialIndex& operator=(const TemplateSTRtreeSpatialIndex& rhs);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_TEMPLATESTRTREE_H
@@ -23,6 +23,8 @@
 #include <geos/noding/SegmentString.h>
 #include <geos/noding/MCIndexSegmentSetMutualIntersector.h>
 
+#include <vector>
+
 
 //forward declarations
 namespace geos {
@@ -72,6 +74,36 @@ public:
 	bool intersects( SegmentString::ConstVect * segStrings);
 	bool intersects( SegmentString::ConstVect * segStrings, SegmentIntersectionDetector * intDetector);
 
+	/**
+	 * Tests each of the given SegmentStrings against the base set
+	 * on its own.
+	 *
+	 * Cheaper than calling intersects() once per string, as
+	 * the scratch space for monotone chains and index query
+	 * results is shared by the whole batch.
+	 *
+	 * The strings can be split into numParts contiguous ranges,
+	 * tested by as many calls with part from 0 to numParts-1, each
+	 * with its own results vector, which may run on different
+	 * threads once a first call has returned and so built the index
+	 * of the base set.
+	 *
+	 * @param segStrings the SegmentStrings to test
+	 * @param results set to the size of the range of the part, the
+	 *        element at each position telling whether the
+	 *        SegmentString there, counting from the start of the
+	 *        range, intersects the base set
+	 * @param part the part of the strings to test
+	 * @param numParts the number of parts; part k tests the strings
+	 *        from n*k/numParts up to n*(k+1)/numParts, n being the
+	 *        size of segStrings
+	 * @throws util::IllegalArgumentException if part is not less
+	 *         than numParts
+	 */
+	void intersects( const SegmentString::ConstVect& segStrings,
+	                 std::vector<bool>& results,
+	                 std::size_t part=0, std::size_t numParts=1);
+
 };
 
 } // geos::noding
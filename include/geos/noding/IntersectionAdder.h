@@ -94,7 +94,7 @@ public:
 	int numInteriorIntersections;
 	int numProperIntersections;
 
-	// testing only
+	// testing only; pairs left out by the noder are not counted
 	int numTests;
 
 	IntersectionAdder(algorithm::LineIntersector& newLi)
@@ -173,6 +173,11 @@ public:
 	virtual bool isDone() const {
 		return false;
 	}
+
+	/// Only intersecting segments are recorded
+	virtual bool ignoresDisjointSegments() const {
+		return true;
+	}
 };
  
 
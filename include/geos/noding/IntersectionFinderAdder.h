@@ -95,6 +95,11 @@ public:
 		return false;
 	}
 
+	/// Only interior intersections are recorded
+	virtual bool ignoresDisjointSegments() const {
+		return true;
+	}
+
 private:
 	algorithm::LineIntersector& li;
 	std::vector<geom::Coordinate>& interiorIntersections;
@@ -25,11 +25,12 @@
 
 #include <geos/index/chain/MonotoneChainOverlapAction.h> // for inheritance
 #include <geos/noding/SinglePassNoder.h> // for inheritance
-#include <geos/index/strtree/STRtree.h> // for composition
+#include <geos/index/strtree/TemplateSTRtree.h> // for composition
 #include <geos/util.h>
 
 #include <vector>
 #include <iostream>
+#include <memory> // for auto_ptr
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -41,6 +42,9 @@ namespace geos {
 	namespace geom {
 		class LineSegment;
 	}
+	namespace algorithm {
+		class SegmentIntersectionBatch;
+	}
 	namespace noding {
 		class SegmentString;
 		class SegmentIntersector;
@@ -64,7 +68,9 @@ class GEOS_DLL MCIndexNoder : public SinglePassNoder {
 
 private:
 	std::vector<index::chain::MonotoneChain*> monoChains;
-	index::strtree::STRtree index;
+	index::strtree::TemplateSTRtree<index::chain::MonotoneChain*> index;
+	/// index, for getIndex()
+	index::strtree::TemplateSTRtreeSpatialIndex<index::chain::MonotoneChain> spatialIndex;
 	int idCounter;
 	std::vector<SegmentString*>* nodedSegStrings;
 	// statistics
@@ -79,6 +85,7 @@ public:
 	MCIndexNoder(SegmentIntersector *nSegInt=NULL)
 		:
 		SinglePassNoder(nSegInt),
+		spatialIndex(index),
 		idCounter(0),
 		nodedSegStrings(NULL),
 		nOverlaps(0)
@@ -89,25 +96,52 @@ public:
 	/// Return a reference to this instance's std::vector of MonotoneChains
 	std::vector<index::chain::MonotoneChain*>& getMonotoneChains() { return monoChains; }
 
+	/**
+	 * The index of the MonotoneChains, which is built by
+	 * computeNodes and does not support remove.
+	 */
 	index::SpatialIndex& getIndex();
 
 	std::vector<SegmentString*>* getNodedSubstrings() const;
 
 	void computeNodes(std::vector<SegmentString*>* inputSegmentStrings);
 
+	/**
+	 * Hands overlapping segments to a SegmentIntersector.
+	 *
+	 * If the SegmentIntersector ignores disjoint segments, the
+	 * pairs are collected into an algorithm::SegmentIntersectionBatch
+	 * and only those the batch filter keeps are processed, when the
+	 * batch is full or flush() is called.
+	 */
 	class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction {
 	public:
-		SegmentOverlapAction(SegmentIntersector& newSi)
-			:
-			index::chain::MonotoneChainOverlapAction(),
-			si(newSi)
-		{}
+		SegmentOverlapAction(SegmentIntersector& newSi);
+
+		~SegmentOverlapAction();
 
 		void overlap(index::chain::MonotoneChain& mc1, std::size_t start1,
             index::chain::MonotoneChain& mc2, std::size_t start2);
+
+		/// Processes the pairs still pending, if any
+		void flush();
+
     private:
         SegmentIntersector& si;
 
+        struct SegmentPair {
+            SegmentString* ss1;
+            std::size_t start1;
+            SegmentString* ss2;
+            std::size_t start2;
+        };
+
+        /// NULL if every pair is to be processed
+        std::auto_ptr<algorithm::SegmentIntersectionBatch> batch;
+
+        /// The pairs in batch, in the same order
+        std::vector<SegmentPair> pending;
+
         // Declare type as noncopyable
         SegmentOverlapAction(const SegmentOverlapAction& other);
         SegmentOverlapAction& operator=(const SegmentOverlapAction& rhs);
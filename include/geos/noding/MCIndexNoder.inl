@@ -31,7 +31,7 @@ namespace noding { // geos::noding
 INLINE index::SpatialIndex&
 MCIndexNoder::getIndex()
 {
-	return index;
+	return spatialIndex;
 }
 
 INLINE std::vector<SegmentString*>*
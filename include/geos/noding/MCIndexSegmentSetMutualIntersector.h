@@ -78,6 +78,29 @@ public:
 	// NOTE: re-populates the MonotoneChain vector with newly created chains
 	void process(SegmentString::ConstVect* segStrings);
 
+	/**
+	 * Computes the intersections of a single SegmentString against
+	 * the base segments, reporting them to the given SegmentIntersector
+	 * rather than to the one set on this instance.
+	 *
+	 * Processing stops as soon as the SegmentIntersector is done.
+	 * No member of this instance is touched, so once the index has
+	 * been built by a first query, calls with their own
+	 * SegmentIntersector and buffers may run on different threads.
+	 *
+	 * @param segStr the SegmentString to test
+	 * @param si receives the intersections found
+	 * @param chainBuf scratch space for the chains of segStr, which
+	 *        are allocated one by one and deleted before returning,
+	 *        even on exception; pass the same vector when processing
+	 *        many strings to reuse its storage
+	 * @param overlapBuf scratch space for index query results,
+	 *        reusable in the same way
+	 */
+	void process(SegmentString* segStr, SegmentIntersector& si,
+	             std::vector<index::chain::MonotoneChain *>& chainBuf,
+	             std::vector<void*>& overlapBuf);
+
     class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction
     {
     private:
@@ -152,6 +152,12 @@ public:
 		return _hasIntersection;
 	}
 
+	/// Only intersections are recorded
+	bool ignoresDisjointSegments() const
+	{
+		return true;
+	}
+
 	/**
 	 * This method is called by clients
 	 * of the {@link SegmentIntersector} class to process
@@ -71,6 +71,19 @@ public:
 		return false;
 	}
 
+	/**
+	 * \brief
+	 * Reports whether processIntersections does nothing for
+	 * segments which do not intersect.
+	 *
+	 * Noders may then leave out pairs of segments which a fast
+	 * filter finds disjoint. The default implementation returns
+	 * false (every pair found by the noder is processed).
+	 */
+	virtual bool ignoresDisjointSegments() const {
+		return false;
+	}
+
 	virtual ~SegmentIntersector() 
 	{ }
 
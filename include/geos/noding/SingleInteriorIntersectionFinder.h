@@ -107,6 +107,12 @@ public:
 		return !interiorIntersection.isNull();
 	}
 
+	/// Only interior intersections are recorded
+	bool ignoresDisjointSegments() const
+	{
+		return true;
+	}
+
 private:
 	algorithm::LineIntersector& li;
 	geom::Coordinate interiorIntersection;
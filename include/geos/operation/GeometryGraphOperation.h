@@ -22,6 +22,7 @@
 
 #include <geos/export.h>
 #include <geos/algorithm/LineIntersector.h> // for composition
+#include <geos/geomgraph/GeometryGraph.h> // for EdgeSetIntersectorType
 
 #include <vector>
 
@@ -39,9 +40,6 @@ namespace geos {
 		class Geometry;
 		class PrecisionModel;
 	}
-	namespace geomgraph {
-		class GeometryGraph;
-	}
 }
 
 
@@ -66,6 +64,13 @@ public:
 
 	const geom::Geometry* getArgGeometry(unsigned int i) const;
 
+	/** \brief
+	 * Sets the EdgeSetIntersector used by the graphs of the
+	 * arguments, before the operation is computed.
+	 */
+	void setEdgeSetIntersectorType(
+		geomgraph::GeometryGraph::EdgeSetIntersectorType type);
+
 protected:
 
 	algorithm::LineIntersector li;
@@ -66,9 +66,11 @@ namespace distance { // geos::operation::distance
  * the coordinate computed is a close
  * approximation to the exact point.
  * 
- * The algorithms used are straightforward O(n^2)
- * comparisons.  This worst-case performance could be improved on
- * by using Voronoi techniques or spatial indexes.
+ * Unless the geometries are small, the segments and points of each
+ * are put in an STRtree, and the pairs of nodes of the two trees are
+ * searched nearest first, skipping those farther than the nearest
+ * pair of segments found. Small geometries are compared segment by
+ * segment.
  *
  */
 class GEOS_DLL DistanceOp {
@@ -95,10 +97,17 @@ public:
 	 * Test whether two geometries lie within a given distance of
 	 * each other.
 	 *
+	 * Geometries whose envelopes are farther apart are rejected
+	 * first. Otherwise the test stops at the first vertex found
+	 * inside a polygon of the other geometry, or pair of facets
+	 * found within distance, and facets farther apart are not
+	 * searched at all.
+	 *
 	 * @param g0 a {@link Geometry}
 	 * @param g1 another {@link Geometry}
 	 * @param distance the distance to test
-	 * @return true if g0.distance(g1) <= distance
+	 * @return true if g0.distance(g1) <= distance, false if either
+	 *         geometry is empty
 	 */
 	static bool isWithinDistance(const geom::Geometry& g0,
 	                             const geom::Geometry& g1,
@@ -213,6 +222,11 @@ private:
 	std::vector<geom::Geometry const*> geom;
 	double terminateDistance; 
 
+	/// Whether facets farther apart than terminateDistance are
+	/// skipped, for isWithinDistance: the distance computed is then
+	/// only exact within terminateDistance
+	bool withinTerminateDistanceOnly;
+
 	// working 
 	algorithm::PointLocator ptLocator;
 	// TODO: use auto_ptr
@@ -226,6 +240,14 @@ private:
 	void updateMinDistance(std::vector<GeometryLocation*>& locGeom,
 	                       bool flip);
 
+	/// The distance beyond which facets need not be compared
+	double getSearchDistance() const
+	{
+		if ( withinTerminateDistanceOnly && terminateDistance < minDistance )
+			return terminateDistance;
+		return minDistance;
+	}
+
 	void computeMinDistance();
 
 	void computeContainmentDistance();
@@ -259,6 +281,18 @@ private:
 			const std::vector<const geom::Point*>& points1,
 			std::vector<GeometryLocation*>& locGeom);
 
+	/**
+	 * Computes the distance between the lines and points of each
+	 * input geometry by a search of the pairs of nodes of STRtrees
+	 * of their segments.
+	 */
+	void computeMinDistanceIndexed(
+			const std::vector<const geom::LineString*>& lines0,
+			const std::vector<const geom::Point*>& points0,
+			const std::vector<const geom::LineString*>& lines1,
+			const std::vector<const geom::Point*>& points1,
+			std::vector<GeometryLocation*>& locGeom);
+
 	void computeMinDistance(const geom::LineString *line0,
 			const geom::LineString *line1,
 			std::vector<GeometryLocation*>& locGeom);
@@ -0,0 +1,125 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_PREDICATE_SPATIALJOIN_H
+#define GEOS_OP_PREDICATE_SPATIALJOIN_H
+
+#include <geos/export.h>
+#include <geos/index/strtree/STRtree.h> // for composition
+
+#include <vector>
+#include <cstddef>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace predicate { // geos::operation::predicate
+
+/** \brief
+ * Finds the pairs of geometries, one from each of two collections,
+ * for which a spatial predicate holds.
+ *
+ * The geometries of each collection are put in an STRtree, and the
+ * pairs whose envelopes intersect are found by walking both trees
+ * together (see index::strtree::STRtree::intersectingPairs).
+ * Each of them is then tested with the predicate, using the
+ * prepared form of the geometry with more points, which is kept
+ * for its other pairs. Pairs are passed to a visitor as they are
+ * found, instead of being collected.
+ *
+ * The pairs can be split into parts, found by as many calls to
+ * join which may run on different threads.
+ *
+ * Null pointers and empty geometries are never in a pair.
+ */
+class GEOS_DLL SpatialJoin {
+
+public:
+
+	/// The predicate a pair must satisfy, with the first geometry first
+	enum Predicate {
+		INTERSECTS,
+		CONTAINS,
+		COVERS,
+		WITHIN,
+		COVERED_BY,
+		TOUCHES,
+		CROSSES,
+		OVERLAPS
+	};
+
+	/// Given the pairs found by a SpatialJoin
+	class GEOS_DLL PairVisitor {
+	public:
+		/**
+		 * @param index1 the index of a geometry of the first collection
+		 * @param index2 the index of a geometry of the second collection
+		 */
+		virtual void visitPair(std::size_t index1, std::size_t index2)=0;
+
+		virtual ~PairVisitor() {}
+	};
+
+	/**
+	 * Indexes two collections of geometries, which must be kept
+	 * alive and unchanged while this SpatialJoin is used.
+	 *
+	 * @param geoms1 the first collection
+	 * @param geoms2 the second collection
+	 */
+	SpatialJoin(const std::vector<const geom::Geometry*>& geoms1,
+	            const std::vector<const geom::Geometry*>& geoms2);
+
+	/**
+	 * Finds the pairs of geometries satisfying a predicate.
+	 *
+	 * Calls for different parts may run concurrently.
+	 *
+	 * @param predicate the predicate to test
+	 * @param visitor given the indexes of the geometries of each pair
+	 * @param part the part of the pairs to find
+	 * @param numParts the number of parts
+	 * @return the number of pairs found
+	 * @throws util::IllegalArgumentException if the predicate is
+	 *         unknown, or part is not less than numParts
+	 */
+	std::size_t join(Predicate predicate, PairVisitor& visitor,
+	                 std::size_t part=0, std::size_t numParts=1);
+
+private:
+
+	std::vector<const geom::Geometry*> geoms1;
+
+	std::vector<const geom::Geometry*> geoms2;
+
+	/// The items are pointers to the entries of geoms1
+	index::strtree::STRtree tree1;
+
+	/// The items are pointers to the entries of geoms2
+	index::strtree::STRtree tree2;
+
+	// Declare type as noncopyable
+	SpatialJoin(const SpatialJoin& other);
+	SpatialJoin& operator=(const SpatialJoin& rhs);
+};
+
+} // namespace geos::operation::predicate
+} // namespace geos::operation
+} // namespace geos
+
+#endif // GEOS_OP_PREDICATE_SPATIALJOIN_H
@@ -0,0 +1,125 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/SegmentIntersectionBatch.h>
+#include <geos/geom/Coordinate.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cassert>
+
+using geos::geom::Coordinate;
+
+namespace geos {
+namespace algorithm { // geos.algorithm
+
+namespace {
+
+/*
+ * Bound on the rounding error of dx1*dy2 - dy1*dx2, relative to
+ * |dx1*dy2| + |dy1*dx2|, with some margin. The absolute term covers
+ * products losing precision to underflow.
+ */
+const double ORIENTATION_ERROR_BOUND = 2 * DBL_EPSILON;
+const double ORIENTATION_ERROR_MIN = DBL_MIN;
+
+/*
+ * The orientation of c relative to a-b, computed from the same
+ * differences as CGAlgorithms::orientationIndex.
+ *
+ * @return 1 or -1 if the sign is certainly that of the exact
+ *         orientation, 0 if it cannot be trusted
+ */
+inline int
+certainOrientation(double ax, double ay, double bx, double by,
+	double cx, double cy)
+{
+	double dx1 = bx - ax;
+	double dy1 = by - ay;
+	double dx2 = cx - bx;
+	double dy2 = cy - by;
+	double left = dx1 * dy2;
+	double right = dy1 * dx2;
+	double det = left - right;
+	double err = ORIENTATION_ERROR_BOUND * (std::fabs(left) + std::fabs(right))
+	             + ORIENTATION_ERROR_MIN;
+	// non-finite values compare false, and are left undecided
+	return int(det > err) - int(-det > err);
+}
+
+} // anonymous namespace
+
+const std::size_t SegmentIntersectionBatch::CAPACITY;
+
+SegmentIntersectionBatch::SegmentIntersectionBatch()
+	:
+	n(0),
+	nCandidates(0)
+{
+}
+
+/*public*/
+std::size_t
+SegmentIntersectionBatch::add(const Coordinate& p0, const Coordinate& p1,
+	const Coordinate& q0, const Coordinate& q1)
+{
+	assert(n < CAPACITY);
+	p0x[n] = p0.x; p0y[n] = p0.y;
+	p1x[n] = p1.x; p1y[n] = p1.y;
+	q0x[n] = q0.x; q0y[n] = q0.y;
+	q1x[n] = q1.x; q1y[n] = q1.y;
+	return n++;
+}
+
+/*public*/
+std::size_t
+SegmentIntersectionBatch::filter()
+{
+	for (std::size_t i=0; i<n; ++i)
+	{
+		// same comparisons as Envelope::intersects(p1, p2, q1, q2)
+		double minpx = p1x[i] < p0x[i] ? p1x[i] : p0x[i];
+		double maxpx = p0x[i] < p1x[i] ? p1x[i] : p0x[i];
+		double minqx = q1x[i] < q0x[i] ? q1x[i] : q0x[i];
+		double maxqx = q0x[i] < q1x[i] ? q1x[i] : q0x[i];
+		double minpy = p1y[i] < p0y[i] ? p1y[i] : p0y[i];
+		double maxpy = p0y[i] < p1y[i] ? p1y[i] : p0y[i];
+		double minqy = q1y[i] < q0y[i] ? q1y[i] : q0y[i];
+		double maxqy = q0y[i] < q1y[i] ? q1y[i] : q0y[i];
+		int disjoint = (minpx > maxqx) | (maxpx < minqx) |
+		               (minpy > maxqy) | (maxpy < minqy);
+
+		// both ends of a segment strictly on one side of the other
+		int pq0 = certainOrientation(p0x[i], p0y[i], p1x[i], p1y[i],
+		                             q0x[i], q0y[i]);
+		int pq1 = certainOrientation(p0x[i], p0y[i], p1x[i], p1y[i],
+		                             q1x[i], q1y[i]);
+		int qp0 = certainOrientation(q0x[i], q0y[i], q1x[i], q1y[i],
+		                             p0x[i], p0y[i]);
+		int qp1 = certainOrientation(q0x[i], q0y[i], q1x[i], q1y[i],
+		                             p1x[i], p1y[i]);
+		disjoint |= (pq0 * pq1 > 0) | (qp0 * qp1 > 0);
+
+		keep[i] = (unsigned char)(!disjoint);
+	}
+
+	nCandidates = 0;
+	for (std::size_t i=0; i<n; ++i)
+	{
+		candidates[nCandidates] = i;
+		nCandidates += keep[i];
+	}
+	return nCandidates;
+}
+
+} // namespace geos.algorithm
+} // namespace geos
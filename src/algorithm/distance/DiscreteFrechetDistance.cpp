@@ -0,0 +1,236 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/distance/DiscreteFrechetDistance.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFilter.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/math.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace algorithm { // geos.algorithm
+namespace distance { // geos.algorithm.distance
+
+namespace {
+
+/*
+ * Collects the coordinates of a geometry in order, with the points
+ * splitting each segment into numSubSegs parts.
+ */
+class PointCollecter : public CoordinateSequenceFilter
+{
+public:
+
+	PointCollecter(std::size_t numSubSegs, std::vector<Coordinate>& pts)
+		:
+		numSubSegs(numSubSegs),
+		pts(pts)
+	{}
+
+	void filter_ro(const CoordinateSequence& seq, std::size_t index)
+	{
+		const Coordinate& p1 = seq.getAt(index);
+		if ( index > 0 )
+		{
+			const Coordinate& p0 = seq.getAt(index - 1);
+			double delx = (p1.x - p0.x) / numSubSegs;
+			double dely = (p1.y - p0.y) / numSubSegs;
+			for (std::size_t i = 1; i < numSubSegs; ++i)
+				pts.push_back(Coordinate(p0.x + i * delx, p0.y + i * dely));
+		}
+		pts.push_back(p1);
+	}
+
+	bool isGeometryChanged() const { return false; }
+
+	bool isDone() const { return false; }
+
+private:
+
+	std::size_t numSubSegs;
+
+	std::vector<Coordinate>& pts;
+
+	// Declare type as noncopyable
+	PointCollecter(const PointCollecter& other);
+	PointCollecter& operator=(const PointCollecter& rhs);
+};
+
+} // anonymous namespace
+
+/* static public */
+double
+DiscreteFrechetDistance::distance(const geom::Geometry& g0,
+	                       const geom::Geometry& g1)
+{
+	DiscreteFrechetDistance dist(g0, g1);
+	return dist.distance();
+}
+
+/* static public */
+double
+DiscreteFrechetDistance::distance(const geom::Geometry& g0,
+	                       const geom::Geometry& g1,
+	                       double densifyFrac)
+{
+	DiscreteFrechetDistance dist(g0, g1);
+	dist.setDensifyFraction(densifyFrac);
+	return dist.distance();
+}
+
+/* static public */
+bool
+DiscreteFrechetDistance::isFrechetWithin(const geom::Geometry& g0,
+	                       const geom::Geometry& g1, double threshold)
+{
+	DiscreteFrechetDistance dist(g0, g1);
+	return dist.isFrechetWithin(threshold);
+}
+
+/* static public */
+bool
+DiscreteFrechetDistance::isFrechetWithin(const geom::Geometry& g0,
+	                       const geom::Geometry& g1, double densifyFrac,
+	                       double threshold)
+{
+	DiscreteFrechetDistance dist(g0, g1);
+	dist.setDensifyFraction(densifyFrac);
+	return dist.isFrechetWithin(threshold);
+}
+
+/* public */
+void
+DiscreteFrechetDistance::setDensifyFraction(double dFrac)
+{
+	if ( dFrac > 1.0 || dFrac <= 0.0 )
+	{
+		throw util::IllegalArgumentException(
+			"Fraction is not in range (0.0 - 1.0]");
+	}
+
+	densifyFrac = dFrac;
+}
+
+/* public */
+double
+DiscreteFrechetDistance::distance()
+{
+	Cell result;
+	compute(-1, result);
+	ptDist.initialize(pts0[result.i], pts1[result.j]);
+	return ptDist.getDistance();
+}
+
+/* public */
+bool
+DiscreteFrechetDistance::isFrechetWithin(double threshold)
+{
+	if ( threshold < 0 ) return false;
+	Cell result;
+	return compute(threshold, result) && result.distance <= threshold;
+}
+
+/* private */
+void
+DiscreteFrechetDistance::getPoints(const geom::Geometry& g,
+	                       std::vector<geom::Coordinate>& pts) const
+{
+	std::size_t numSubSegs = 1;
+	if ( densifyFrac > 0 )
+		numSubSegs = std::size_t(util::round(1.0 / densifyFrac));
+
+	pts.clear();
+	PointCollecter collecter(numSubSegs, pts);
+	g.apply_ro(collecter);
+	if ( pts.empty() )
+	{
+		throw util::IllegalArgumentException(
+			"Frechet distance of an empty geometry is undefined");
+	}
+}
+
+/*
+ * The cell of the points i and j, on the anti-diagonal k = i + j,
+ * is reached from those of (i-1, j) and (i, j-1), on k-1, or of
+ * (i-1, j-1), on k-2, by the walk whose farthest pair is the
+ * nearest. All are stored at the index of their point of g0.
+ */
+bool
+DiscreteFrechetDistance::compute(double threshold, Cell& result)
+{
+	getPoints(g0, pts0);
+	getPoints(g1, pts1);
+
+	const std::size_t n0 = pts0.size();
+	const std::size_t n1 = pts1.size();
+	const double unreached = std::numeric_limits<double>::infinity();
+	for (int d = 0; d < 3; ++d)
+		diagonals[d].resize(n0);
+
+	// a diagonal step skips an anti-diagonal, not two
+	bool prevReached = true;
+
+	for (std::size_t k = 0; k < n0 + n1 - 1; ++k)
+	{
+		std::vector<Cell>& cur = diagonals[k % 3];
+		const std::vector<Cell>& prev = diagonals[(k + 2) % 3];
+		const std::vector<Cell>& prev2 = diagonals[(k + 1) % 3];
+
+		std::size_t iMin = k < n1 ? 0 : k - (n1 - 1);
+		std::size_t iMax = (std::min)(k, n0 - 1);
+		bool reached = false;
+		for (std::size_t i = iMin; i <= iMax; ++i)
+		{
+			std::size_t j = k - i;
+			Cell& cell = cur[i];
+			cell.distance = pts0[i].distance(pts1[j]);
+			cell.i = i;
+			cell.j = j;
+			if ( threshold >= 0 && cell.distance > threshold )
+			{
+				cell.distance = unreached;
+				continue;
+			}
+			if ( k == 0 )
+			{
+				reached = true;
+				continue;
+			}
+
+			const Cell* best = 0;
+			if ( i > 0 ) best = &prev[i - 1];
+			if ( j > 0 && ( ! best || prev[i].distance < best->distance ) )
+				best = &prev[i];
+			if ( i > 0 && j > 0 && prev2[i - 1].distance < best->distance )
+				best = &prev2[i - 1];
+
+			if ( best->distance > cell.distance ) cell = *best;
+			if ( cell.distance != unreached ) reached = true;
+		}
+
+		if ( ! reached && ! prevReached ) return false;
+		prevReached = reached;
+	}
+
+	result = diagonals[(n0 + n1 - 2) % 3][n0 - 1];
+	return true;
+}
+
+} // namespace geos.algorithm.distance
+} // namespace geos.algorithm
+} // namespace geos
@@ -17,7 +17,15 @@
  **********************************************************************/
 
 #include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
+#include <geos/index/strtree/TemplateSTRtree.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/LineSegment.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/util/LinearComponentExtracter.h>
+#include <geos/geom/util/PointExtracter.h>
+#include <geos/platform.h> // for ISNAN
 
 //#include <geos/algorithm/CGAlgorithms.h>
 //#include <geos/geom/Geometry.h>
@@ -27,6 +35,9 @@
 //#include <geos/geom/LineString.h>
 
 #include <typeinfo>
+#include <algorithm>
+#include <limits>
+#include <cmath>
 #include <cassert>
 
 using namespace geos::geom;
@@ -35,6 +46,173 @@ namespace geos {
 namespace algorithm { // geos.algorithm
 namespace distance { // geos.algorithm.distance
 
+namespace {
+
+typedef index::strtree::TemplateSTRtree<LineSegment> SegmentTree;
+
+/// The distances from a point to segments and to their envelopes
+struct PointSegmentDistance
+{
+	PointSegmentDistance(const Coordinate& p) : pt(p) {}
+
+	double boundsDistance(const Envelope& env) const
+	{
+		double dx = (std::max)(0.0,
+			(std::max)(env.getMinX() - pt.x, pt.x - env.getMaxX()));
+		double dy = (std::max)(0.0,
+			(std::max)(env.getMinY() - pt.y, pt.y - env.getMaxY()));
+		return std::sqrt(dx * dx + dy * dy);
+	}
+
+	double itemDistance(const LineSegment& seg) const
+	{
+		Coordinate closestPt;
+		seg.closestPoint(pt, closestPt);
+		return closestPt.distance(pt);
+	}
+
+	const Coordinate& pt;
+};
+
+/*
+ * Indexes the segments of the linear components of g, and its
+ * points as zero-length segments, as DistanceToPoint measures
+ * distances to them.
+ */
+void
+indexSegments(const Geometry& g, SegmentTree& tree)
+{
+	LineString::ConstVect lines;
+	geom::util::LinearComponentExtracter::getLines(g, lines);
+	for (std::size_t i = 0, ni = lines.size(); i < ni; ++i)
+	{
+		const CoordinateSequence* pts = lines[i]->getCoordinatesRO();
+		for (std::size_t j = 1, nj = pts->size(); j < nj; ++j)
+		{
+			const Coordinate& p0 = pts->getAt(j - 1);
+			const Coordinate& p1 = pts->getAt(j);
+			tree.insert(Envelope(p0, p1), LineSegment(p0, p1));
+		}
+	}
+
+	Point::ConstVect points;
+	geom::util::PointExtracter::getPoints(g, points);
+	for (std::size_t i = 0, ni = points.size(); i < ni; ++i)
+	{
+		const Coordinate* p = points[i]->getCoordinate();
+		if ( p ) tree.insert(Envelope(*p), LineSegment(*p, *p));
+	}
+	tree.build();
+}
+
+/*
+ * Searches the vertices of a geometry, or the points densifying
+ * its segments, for those farther than a bound from the segments
+ * in a tree.
+ *
+ * The distance to the nearest segment found for a point, plus the
+ * distance to the next point, bounds that of the next point, which
+ * is not searched for when no farther than the bound.
+ *
+ * Given a PointPairDistance, raises the bound to the distance of
+ * each farther point, keeping the farthest pair in it. Otherwise,
+ * stops at the first farther point.
+ */
+class FarPointFilter : public CoordinateSequenceFilter
+{
+public:
+
+	FarPointFilter(SegmentTree& tree, double bound,
+	               std::size_t numSubSegs, PointPairDistance* maxPtDist)
+		:
+		tree(tree),
+		bound(bound),
+		numSubSegs(numSubSegs),
+		maxPtDist(maxPtDist),
+		nearestBound(std::numeric_limits<double>::infinity()),
+		farPointFound(false)
+	{}
+
+	void filter_ro(const CoordinateSequence& seq, std::size_t index)
+	{
+		if ( numSubSegs == 0 )
+		{
+			checkPoint(seq.getAt(index));
+			return;
+		}
+
+		// this also skips Point geometries
+		if ( index == 0 ) return;
+
+		const Coordinate& p0 = seq.getAt(index - 1);
+		const Coordinate& p1 = seq.getAt(index);
+		double delx = (p1.x - p0.x) / numSubSegs;
+		double dely = (p1.y - p0.y) / numSubSegs;
+		for (std::size_t i = 0; i < numSubSegs && ! farPointFound; ++i)
+			checkPoint(Coordinate(p0.x + i * delx, p0.y + i * dely));
+	}
+
+	bool isGeometryChanged() const { return false; }
+
+	bool isDone() const { return farPointFound; }
+
+	double getBound() const { return bound; }
+
+private:
+
+	SegmentTree& tree;
+
+	double bound;
+
+	/// 0 to search the vertices
+	std::size_t numSubSegs;
+
+	PointPairDistance* maxPtDist;
+
+	Coordinate previousPt;
+
+	/// No less than the distance of previousPt to the segments
+	double nearestBound;
+
+	bool farPointFound;
+
+	void checkPoint(const Coordinate& pt)
+	{
+		if ( nearestBound != std::numeric_limits<double>::infinity() )
+			nearestBound += pt.distance(previousPt);
+		previousPt = pt;
+		if ( nearestBound <= bound ) return;
+
+		PointSegmentDistance metric(pt);
+		double dist;
+		const LineSegment* seg = maxPtDist
+			? tree.nearest(metric, dist,
+			               std::numeric_limits<double>::infinity(), bound)
+			: tree.nearest(metric, dist, bound, bound);
+		if ( ! seg )
+		{
+			farPointFound = ! maxPtDist;
+			nearestBound = std::numeric_limits<double>::infinity();
+			return;
+		}
+
+		nearestBound = dist;
+		if ( dist <= bound ) return;
+
+		// seg is the nearest, and only searched for a maximum
+		bound = dist;
+		Coordinate closestPt;
+		seg->closestPoint(pt, closestPt);
+		maxPtDist->setMaximum(closestPt, pt);
+	}
+
+	// Declare type as noncopyable
+	FarPointFilter(const FarPointFilter& other);
+	FarPointFilter& operator=(const FarPointFilter& rhs);
+};
+
+} // anonymous namespace
+
 void
 DiscreteHausdorffDistance::MaxDensifiedByFractionDistanceFilter::filter_ro(
 	const geom::CoordinateSequence& seq, size_t index)
@@ -82,6 +260,26 @@ DiscreteHausdorffDistance::distance(const geom::Geometry& g0,
 	return dist.distance();
 }
 
+/* static public */
+bool
+DiscreteHausdorffDistance::isHausdorffWithin(const geom::Geometry& g0,
+	                       const geom::Geometry& g1, double threshold)
+{
+	DiscreteHausdorffDistance dist(g0, g1);
+	return dist.isHausdorffWithin(threshold);
+}
+
+/* static public */
+bool
+DiscreteHausdorffDistance::isHausdorffWithin(const geom::Geometry& g0,
+	                       const geom::Geometry& g1, double densifyFrac,
+	                       double threshold)
+{
+	DiscreteHausdorffDistance dist(g0, g1);
+	dist.setDensifyFraction(densifyFrac);
+	return dist.isHausdorffWithin(threshold);
+}
+
 /* private */
 void
 DiscreteHausdorffDistance::computeOrientedDistance(
@@ -89,17 +287,49 @@ DiscreteHausdorffDistance::computeOrientedDistance(
 		const geom::Geometry& geom,
 		PointPairDistance& ptDist)
 {
-	MaxPointDistanceFilter distFilter(geom);
-	discreteGeom.apply_ro(&distFilter);
-	ptDist.setMaximum(distFilter.getMaxPointDistance());
+	SegmentTree tree;
+	indexSegments(geom, tree);
+	if ( tree.isEmpty() ) return;
+
+	// the points no farther than the distance already found
+	// cannot change it
+	double bound = ptDist.getDistance();
+	if ( ISNAN(bound) ) bound = -1;
+
+	FarPointFilter distFilter(tree, bound, 0, &ptDist);
+	discreteGeom.apply_ro(distFilter);
+
+	if (densifyFrac > 0)
+	{
+		std::size_t numSubSegs = std::size_t(util::round(1.0/densifyFrac));
+		FarPointFilter fracFilter(tree, distFilter.getBound(),
+		                          numSubSegs, &ptDist);
+		discreteGeom.apply_ro(fracFilter);
+	}
+}
+
+/* private */
+bool
+DiscreteHausdorffDistance::isOrientedWithin(
+		const geom::Geometry& discreteGeom,
+		const geom::Geometry& geom,
+		double threshold)
+{
+	SegmentTree tree;
+	indexSegments(geom, tree);
+
+	FarPointFilter distFilter(tree, threshold, 0, 0);
+	discreteGeom.apply_ro(distFilter);
+	if ( distFilter.isDone() ) return false;
 
 	if (densifyFrac > 0)
 	{
-		MaxDensifiedByFractionDistanceFilter fracFilter(geom,
-							  densifyFrac);
+		std::size_t numSubSegs = std::size_t(util::round(1.0/densifyFrac));
+		FarPointFilter fracFilter(tree, threshold, numSubSegs, 0);
 		discreteGeom.apply_ro(fracFilter);
-		ptDist.setMaximum(fracFilter.getMaxPointDistance());
+		if ( fracFilter.isDone() ) return false;
 	}
+	return true;
 }
 
 } // namespace geos.algorithm.distance
@@ -0,0 +1,306 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/locate/GridPointInAreaLocator.h>
+#include <geos/algorithm/RayCrossingCounter.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Location.h>
+#include <geos/geom/util/LinearComponentExtracter.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <typeinfo>
+
+namespace geos {
+namespace algorithm {
+namespace locate {
+
+namespace {
+
+/// The crossing of a segment with the centre line of a row
+typedef std::pair<std::size_t, double> RowCrossing;
+
+} // anonymous namespace
+
+//
+// private:
+//
+void
+GridPointInAreaLocator::init( const geom::Geometry & g)
+{
+	geom::LineString::ConstVect lines;
+	geom::util::LinearComponentExtracter::getLines( g, lines);
+
+	for ( std::size_t i = 0, ni = lines.size(); i < ni; i++ )
+	{
+		const geom::CoordinateSequence * pts = lines[ i ]->getCoordinatesRO();
+		for ( std::size_t j = 1, nj = pts->size(); j < nj; j++ )
+			segments.push_back( geom::LineSegment( pts->getAt( j - 1 ), pts->getAt( j )));
+	}
+	if ( segments.empty() ) return;
+
+	// about one cell per segment, as square as the extent allows
+	double const n = double( segments.size());
+	double const width = extent.getWidth();
+	double const height = extent.getHeight();
+	if ( height == 0 )
+	{
+		numCellsX = segments.size();
+		numCellsY = 1;
+	}
+	else if ( width == 0 )
+	{
+		numCellsX = 1;
+		numCellsY = segments.size();
+	}
+	else
+	{
+		double nx = std::ceil( std::sqrt( n * width / height));
+		nx = (std::max)( 1.0, (std::min)( nx, n));
+		numCellsX = std::size_t( nx);
+		numCellsY = std::size_t( std::ceil( n / nx));
+	}
+	cellWidth = width / double( numCellsX);
+	cellHeight = height / double( numCellsY);
+
+	indexSegments();
+	classifyCells();
+}
+
+/*
+ * Fills the segment lists of the cells, counting the segments of
+ * each cell, then placing them.
+ */
+void
+GridPointInAreaLocator::indexSegments()
+{
+	std::size_t const numCells = numCellsX * numCellsY;
+	cellStarts.assign( numCells + 1, 0);
+
+	for ( int pass = 0; pass < 2; pass++ )
+	{
+		if ( pass == 1 )
+		{
+			// turn the counts into the ends of the lists,
+			// which go down to their starts as they fill
+			for ( std::size_t i = 0; i < numCells; i++ )
+				cellStarts[ i + 1 ] += cellStarts[ i ];
+			cellSegments.resize( cellStarts[ numCells ]);
+		}
+
+		for ( std::size_t s = 0, ns = segments.size(); s < ns; s++ )
+		{
+			const geom::LineSegment & seg = segments[ s ];
+			std::size_t const minRow = row( (std::min)( seg.p0.y, seg.p1.y));
+			std::size_t const maxRow = row( (std::max)( seg.p0.y, seg.p1.y));
+			for ( std::size_t r = minRow; r <= maxRow; r++ )
+			{
+				std::size_t minColumn, maxColumn;
+				getColumns( seg, r, minColumn, maxColumn);
+				for ( std::size_t c = minColumn; c <= maxColumn; c++ )
+				{
+					std::size_t const cell = r * numCellsX + c;
+					if ( pass == 0 )
+						cellStarts[ cell + 1 ]++;
+					else
+						cellSegments[ --cellStarts[ cell + 1 ] ] = s;
+				}
+			}
+		}
+	}
+
+	// the ends went down to the starts, one cell further
+	for ( std::size_t i = 0; i < numCells; i++ )
+		cellStarts[ i ] = cellStarts[ i + 1 ];
+	cellStarts[ numCells ] = cellSegments.size();
+}
+
+/*
+ * Classifies the cells crossed by no segment by the parity of the
+ * crossings on the right of their centre along the centre line of
+ * their row.
+ */
+void
+GridPointInAreaLocator::classifyCells()
+{
+	std::vector< RowCrossing > crossings;
+	for ( std::size_t s = 0, ns = segments.size(); s < ns; s++ )
+	{
+		const geom::LineSegment & seg = segments[ s ];
+		double const dy = seg.p1.y - seg.p0.y;
+		std::size_t const minRow = row( (std::min)( seg.p0.y, seg.p1.y));
+		std::size_t const maxRow = row( (std::max)( seg.p0.y, seg.p1.y));
+		for ( std::size_t r = minRow; r <= maxRow; r++ )
+		{
+			double const y = extent.getMinY() + ( double( r) + 0.5) * cellHeight;
+			if ( ( seg.p0.y > y ) == ( seg.p1.y > y ) ) continue;
+			double const x = seg.p0.x + ( y - seg.p0.y) * ( seg.p1.x - seg.p0.x) / dy;
+			crossings.push_back( RowCrossing( r, x));
+		}
+	}
+	std::sort( crossings.begin(), crossings.end());
+
+	cellStates.resize( numCellsX * numCellsY);
+	std::size_t next = 0;
+	for ( std::size_t r = 0; r < numCellsY; r++ )
+	{
+		std::size_t rowEnd = next;
+		while ( rowEnd < crossings.size() && crossings[ rowEnd ].first == r )
+			rowEnd++;
+
+		for ( std::size_t c = 0; c < numCellsX; c++ )
+		{
+			std::size_t const cell = r * numCellsX + c;
+			if ( cellStarts[ cell ] != cellStarts[ cell + 1 ] )
+			{
+				cellStates[ cell ] = CELL_BOUNDARY;
+				continue;
+			}
+
+			double const x = extent.getMinX() + ( double( c) + 0.5) * cellWidth;
+			while ( next < rowEnd && crossings[ next ].second <= x )
+				next++;
+			bool const inside = ( rowEnd - next ) % 2 == 1;
+			cellStates[ cell ] = inside ? CELL_INTERIOR : CELL_EXTERIOR;
+		}
+		next = rowEnd;
+	}
+}
+
+std::size_t
+GridPointInAreaLocator::column( double x) const
+{
+	if ( cellWidth == 0 ) return 0;
+	double const c = ( x - extent.getMinX()) / cellWidth;
+	if ( c <= 0 ) return 0;
+	if ( c >= double( numCellsX - 1) ) return numCellsX - 1;
+	return std::size_t( c);
+}
+
+std::size_t
+GridPointInAreaLocator::row( double y) const
+{
+	if ( cellHeight == 0 ) return 0;
+	double const r = ( y - extent.getMinY()) / cellHeight;
+	if ( r <= 0 ) return 0;
+	if ( r >= double( numCellsY - 1) ) return numCellsY - 1;
+	return std::size_t( r);
+}
+
+/*
+ * The columns span the part of the segment in the band of the row,
+ * widened by a cell on each side against rounding, within the
+ * columns of the whole segment.
+ */
+void
+GridPointInAreaLocator::getColumns( const geom::LineSegment & seg, std::size_t r,
+                                    std::size_t & minColumn, std::size_t & maxColumn) const
+{
+	double x0 = seg.p0.x;
+	double x1 = seg.p1.x;
+	double const dy = seg.p1.y - seg.p0.y;
+	if ( dy != 0 && cellHeight != 0 )
+	{
+		double const bandMin = extent.getMinY() + double( r) * cellHeight;
+		double const bandMax = bandMin + cellHeight;
+		double const y0 = (std::max)( bandMin, (std::min)( seg.p0.y, seg.p1.y));
+		double const y1 = (std::min)( bandMax, (std::max)( seg.p0.y, seg.p1.y));
+		double const slope = ( seg.p1.x - seg.p0.x) / dy;
+		x0 = seg.p0.x + ( y0 - seg.p0.y) * slope;
+		x1 = seg.p0.x + ( y1 - seg.p0.y) * slope;
+	}
+
+	std::size_t const segMin = column( (std::min)( seg.p0.x, seg.p1.x));
+	std::size_t const segMax = column( (std::max)( seg.p0.x, seg.p1.x));
+	std::size_t const c0 = column( (std::min)( x0, x1));
+	std::size_t const c1 = column( (std::max)( x0, x1));
+	minColumn = (std::max)( segMin, c0 > 0 ? c0 - 1 : 0);
+	maxColumn = (std::min)( segMax, c1 + 1);
+}
+
+//
+// public:
+//
+GridPointInAreaLocator::GridPointInAreaLocator( const geom::Geometry & g)
+:	extent( *g.getEnvelopeInternal()),
+	cellWidth( 0),
+	cellHeight( 0),
+	numCellsX( 0),
+	numCellsY( 0)
+{
+	if (	typeid( g) != typeid( geom::Polygon)
+		&&	typeid( g) != typeid( geom::MultiPolygon) )
+		throw util::IllegalArgumentException("Argument must be Polygonal");
+
+	init( g);
+}
+
+GridPointInAreaLocator::~GridPointInAreaLocator()
+{
+}
+
+int
+GridPointInAreaLocator::locate( const geom::Coordinate * /*const*/ p)
+{
+	if ( segments.empty() || ! extent.covers( p->x, p->y) )
+		return geom::Location::EXTERIOR;
+
+	std::size_t const r = row( p->y);
+	std::size_t const c = column( p->x);
+	std::size_t const rowStart = r * numCellsX;
+	int const state = cellStates[ rowStart + c ];
+	if ( state == CELL_INTERIOR ) return geom::Location::INTERIOR;
+	if ( state == CELL_EXTERIOR ) return geom::Location::EXTERIOR;
+
+	// Count the crossings on the right of p up to the first cell of
+	// the row with no segment, which no segment crossed runs past.
+	// A segment in several of these cells is counted in the first.
+	algorithm::RayCrossingCounter rcc( *p);
+	std::size_t k = c;
+	for ( ; k < numCellsX && cellStates[ rowStart + k ] == CELL_BOUNDARY; k++ )
+	{
+		std::size_t const cell = rowStart + k;
+		for ( std::size_t i = cellStarts[ cell ]; i < cellStarts[ cell + 1 ]; i++ )
+		{
+			const geom::LineSegment & seg = segments[ cellSegments[ i ] ];
+			if ( k > c )
+			{
+				std::size_t minColumn, maxColumn;
+				getColumns( seg, r, minColumn, maxColumn);
+				if ( minColumn != k ) continue;
+			}
+			rcc.countSegment( seg.p0, seg.p1);
+		}
+		if ( rcc.isOnSegment() ) return geom::Location::BOUNDARY;
+	}
+
+	bool inside = ( k < numCellsX && cellStates[ rowStart + k ] == CELL_INTERIOR );
+	if ( rcc.getLocation() == geom::Location::INTERIOR ) inside = ! inside;
+	return inside ? geom::Location::INTERIOR : geom::Location::EXTERIOR;
+}
+
+std::size_t
+GridPointInAreaLocator::getNumBoundaryCells() const
+{
+	return std::size_t( std::count( cellStates.begin(), cellStates.end(),
+	                                (unsigned char)( CELL_BOUNDARY)));
+}
+
+} // geos::algorithm::locate
+} // geos::algorithm
+} // geos
@@ -20,18 +20,44 @@
 #include <geos/geom/LineString.h>
 #include <geos/geom/LineSegment.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Location.h>
 #include <geos/geom/util/LinearComponentExtracter.h>
 #include <geos/index/intervalrtree/SortedPackedIntervalRTree.h>
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/algorithm/RayCrossingCounter.h>
-#include <geos/index/ItemVisitor.h> 
 
 #include <algorithm>
 #include <typeinfo>
+#include <cstddef>
 
 namespace geos {
 namespace algorithm { 
 namespace locate { 
+
+namespace {
+
+/// The points are split into at most this many stripes per point
+const std::size_t STRIPES_PER_POINT = 4;
+
+/// Collects the segments of a stripe
+class SegmentCollector
+{
+	std::vector< const geom::LineSegment * > & segs;
+
+public:
+	SegmentCollector( std::vector< const geom::LineSegment * > & segs)
+	:	segs( segs)
+	{ }
+
+	void operator()( void * item)
+	{
+		segs.push_back( static_cast< const geom::LineSegment * >( item));
+	}
+};
+
+} // anonymous namespace
+
 //
 // private:
 //
@@ -44,11 +70,6 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::IntervalIndexedGeometry( con
 IndexedPointInAreaLocator::IntervalIndexedGeometry::~IntervalIndexedGeometry( )
 {
 	delete index;
-
-	for ( size_t i = 0, ni = allocatedSegments.size(); i < ni; ++i ) 
-	{
-		delete allocatedSegments[i];
-	}
 }
 
 void 
@@ -66,6 +87,17 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::init( const geom::Geometry &
 
 		delete pts;
 	}
+
+	// the segments do not move any more
+	for ( size_t i = 0, ni = segments.size(); i < ni; i++ )
+	{
+		const geom::LineSegment & seg = segments[ i ];
+		double const min = (std::min)( seg.p0.y, seg.p1.y);
+		double const max = (std::max)( seg.p0.y, seg.p1.y);
+
+		index->insert( min, max, &segments[ i ]);
+	}
+	index->build();
 }
 
 void 
@@ -73,13 +105,7 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::addLine( geom::CoordinateSeq
 {
 	for ( size_t i = 1, ni = pts->size(); i < ni; i++ ) 
 	{
-		geom::LineSegment * seg = new geom::LineSegment( (*pts)[ i - 1 ], (*pts)[ i ]);
-		double const min = (std::min)( seg->p0.y, seg->p1.y);
-		double const max = (std::max)( seg->p0.y, seg->p1.y);
-		
-		// NOTE: seg ownership still ours
-		allocatedSegments.push_back(seg);
-		index->insert( min, max, seg);
+		segments.push_back( geom::LineSegment( (*pts)[ i - 1 ], (*pts)[ i ]));
 	}
 } 
 
@@ -108,6 +134,9 @@ IndexedPointInAreaLocator::IndexedPointInAreaLocator( const geom::Geometry & g)
 	//areaGeom = g;
 	
 	buildIndex( areaGeom);
+
+	// cache the envelope too, so that locateAll only reads
+	areaGeom.getEnvelopeInternal();
 }
 
 IndexedPointInAreaLocator::~IndexedPointInAreaLocator()
@@ -122,13 +151,109 @@ IndexedPointInAreaLocator::locate( const geom::Coordinate * /*const*/ p)
 
 	IndexedPointInAreaLocator::SegmentVisitor visitor( &rcc);
 
-	index->query( p->y, p->y, &visitor);
+	index->query( p->y, p->y, visitor);
 
 	return rcc.getLocation();
 }
 
+void
+IndexedPointInAreaLocator::locateAll( const double * xy, std::size_t n,
+                                      int * locations,
+                                      std::size_t part, std::size_t numParts)
+{
+	if ( part >= numParts )
+	{
+		throw util::IllegalArgumentException(
+			"IndexedPointInAreaLocator::locateAll: part must be less than numParts");
+	}
+
+	// the points of the part, located as a whole array
+	std::size_t const first = n * part / numParts;
+	xy += 2 * first;
+	locations += first;
+	n = n * ( part + 1) / numParts - first;
+
+	const geom::Envelope * env = areaGeom.getEnvelopeInternal();
+
+	std::size_t numInside = 0;
+	for ( std::size_t i = 0; i < n; i++ )
+	{
+		if ( env->intersects( xy[ 2 * i ], xy[ 2 * i + 1 ]) )
+			numInside++;
+		else
+			locations[ i ] = geom::Location::EXTERIOR;
+	}
+	if ( numInside == 0 ) return;
+
+	// about a segment per stripe, but no more stripes than points need
+	std::size_t numStripes = index->getSegments().size();
+	numStripes = (std::min)( numStripes, numInside * STRIPES_PER_POINT);
+	numStripes = (std::max)( numStripes, std::size_t( 1));
+
+	double const minY = env->getMinY();
+	double const stripeHeight = env->getHeight() / numStripes;
+
+	// bucket sort the points inside by stripe, numStripes marking
+	// the ones outside
+	std::vector< std::size_t > stripes( n, numStripes);
+	std::vector< std::size_t > stripeStarts( numStripes + 1, 0);
+	for ( std::size_t i = 0; i < n; i++ )
+	{
+		if ( ! env->intersects( xy[ 2 * i ], xy[ 2 * i + 1 ]) ) continue;
+		std::size_t stripe = numStripes - 1;
+		if ( stripeHeight > 0 )
+		{
+			double pos = ( xy[ 2 * i + 1 ] - minY ) / stripeHeight;
+			if ( pos < numStripes - 1 ) stripe = std::size_t( pos);
+		}
+		stripes[ i ] = stripe;
+		stripeStarts[ stripe + 1 ]++;
+	}
+	for ( std::size_t s = 0; s < numStripes; s++ )
+		stripeStarts[ s + 1 ] += stripeStarts[ s ];
+
+	std::vector< std::size_t > order( numInside);
+	std::vector< std::size_t > nextInStripe( stripeStarts.begin(),
+	                                         stripeStarts.end() - 1);
+	for ( std::size_t i = 0; i < n; i++ )
+	{
+		if ( stripes[ i ] == numStripes ) continue;
+		order[ nextInStripe[ stripes[ i ] ]++ ] = i;
+	}
+
+	// query the segments of each stripe once for all its points
+	std::vector< const geom::LineSegment * > segs;
+	for ( std::size_t s = 0; s < numStripes; s++ )
+	{
+		std::size_t const start = stripeStarts[ s ];
+		std::size_t const end = stripeStarts[ s + 1 ];
+		if ( start == end ) continue;
+
+		double stripeMinY = xy[ 2 * order[ start ] + 1 ];
+		double stripeMaxY = stripeMinY;
+		for ( std::size_t k = start + 1; k < end; k++ )
+		{
+			double const y = xy[ 2 * order[ k ] + 1 ];
+			stripeMinY = (std::min)( stripeMinY, y);
+			stripeMaxY = (std::max)( stripeMaxY, y);
+		}
+		segs.clear();
+		index->query( stripeMinY, stripeMaxY, segs);
+
+		for ( std::size_t k = start; k < end; k++ )
+		{
+			std::size_t const i = order[ k ];
+			geom::Coordinate p( xy[ 2 * i ], xy[ 2 * i + 1 ]);
+			algorithm::RayCrossingCounter rcc( p);
+			for ( std::size_t j = 0, nj = segs.size(); j < nj; j++ )
+				rcc.countSegment( (*segs[ j ])[ 0 ], (*segs[ j ])[ 1 ]);
+			locations[ i ] = rcc.getLocation();
+		}
+	}
+}
+
 void 
-IndexedPointInAreaLocator::SegmentVisitor::visitItem( void * item)
+IndexedPointInAreaLocator::SegmentVisitor::operator()( void * item)
 {
 	geom::LineSegment * seg = (geom::LineSegment *)item;
 
@@ -136,11 +261,18 @@ IndexedPointInAreaLocator::SegmentVisitor::visitItem( void * item)
 }
 
 void 
-IndexedPointInAreaLocator::IntervalIndexedGeometry::query( double min, double max, index::ItemVisitor * visitor)
+IndexedPointInAreaLocator::IntervalIndexedGeometry::query( double min, double max, SegmentVisitor & visitor)
 {
 	index->query( min, max, visitor);
 }
 
+void 
+IndexedPointInAreaLocator::IntervalIndexedGeometry::query( double min, double max, std::vector< const geom::LineSegment * > & segs)
+{
+	SegmentCollector collector( segs);
+	index->query( min, max, collector);
+}
+
 
 } // geos::algorithm::locate
 } // geos::algorithm
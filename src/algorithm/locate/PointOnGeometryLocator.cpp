@@ -14,11 +14,32 @@
 
 
 #include <geos/algorithm/locate/PointOnGeometryLocator.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/util/IllegalArgumentException.h>
 
 namespace geos {
 namespace algorithm { // geos::algorithm
 namespace locate { // geos::algorithm::locate
 
+void
+PointOnGeometryLocator::locateAll( const double * xy, std::size_t n,
+                                   int * locations,
+                                   std::size_t part, std::size_t numParts)
+{
+	if ( part >= numParts )
+	{
+		throw util::IllegalArgumentException(
+			"PointOnGeometryLocator::locateAll: part must be less than numParts");
+	}
+
+	for ( std::size_t i = n * part / numParts,
+	      end = n * ( part + 1) / numParts; i < end; i++ )
+	{
+		geom::Coordinate p( xy[ 2 * i ], xy[ 2 * i + 1 ]);
+		locations[ i ] = locate( &p);
+	}
+}
+
 } // geos::algorithm::locate
 } // geos::algorithm
 } // geos
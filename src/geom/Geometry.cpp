@@ -51,6 +51,7 @@
 #include <geos/operation/buffer/BufferOp.h>
 #include <geos/operation/distance/DistanceOp.h>
 #include <geos/operation/IsSimpleOp.h>
+#include <geos/geomgraph/SelfNodingCache.h>
 #include <geos/io/WKBWriter.h>
 #include <geos/io/WKTWriter.h>
 #include <geos/version.h>
@@ -106,7 +107,8 @@ Geometry::Geometry(const GeometryFactory *newFactory)
 	:
 	envelope(NULL),
 	factory(newFactory),
-	userData(NULL)
+	userData(NULL),
+	selfNodingCache(NULL)
 {
 	if ( factory == NULL ) {
 		factory = INTERNAL_GEOMETRY_FACTORY;
@@ -118,7 +120,8 @@ Geometry::Geometry(const Geometry &geom)
 	:
 	SRID(geom.getSRID()),
 	factory(geom.factory),
-	userData(NULL)
+	userData(NULL),
+	selfNodingCache(NULL)
 {
 	if ( geom.envelope.get() )
 	{
@@ -169,22 +172,7 @@ Geometry::hasNullElements(const vector<Geometry *>* lrs)
 bool
 Geometry::isWithinDistance(const Geometry *geom,double cDistance) const
 {
-	const Envelope *env0=getEnvelopeInternal();
-	const Envelope *env1=geom->getEnvelopeInternal();
-	double envDist=env0->distance(env1);
-	//delete env0;
-	//delete env1;
-	if (envDist>cDistance)
-	{
-		return false;
-	}
-	// NOTE: this could be implemented more efficiently
-	double geomDist=distance(geom);
-	if (geomDist>cDistance)
-	{
-		return false;
-	}
-	return true;
+	return DistanceOp::isWithinDistance(*this, *geom, cDistance);
 }
 
 /*public*/
@@ -273,6 +261,15 @@ Geometry::geometryChangedAction()
 {
 	//delete envelope;
 	envelope.reset(NULL);
+	if ( selfNodingCache.get() ) selfNodingCache->clear();
+}
+
+void
+Geometry::setSelfNodingCacheEnabled(bool enable)
+{
+	if ( ! enable ) selfNodingCache.reset();
+	else if ( ! selfNodingCache.get() )
+		selfNodingCache.reset(new geomgraph::SelfNodingCache());
 }
 
 bool
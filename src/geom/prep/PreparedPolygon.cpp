@@ -29,6 +29,7 @@
 #include <geos/operation/predicate/RectangleIntersects.h>
 #include <geos/algorithm/locate/PointOnGeometryLocator.h>
 #include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/algorithm/locate/GridPointInAreaLocator.h>
 // std
 #include <cstddef>
 
@@ -39,7 +40,8 @@ namespace prep { // geos.geom.prep
 // public:
 //
 PreparedPolygon::PreparedPolygon(const geom::Geometry * geom) 
-    : BasicPreparedGeometry(geom), segIntFinder(0), ptOnGeomLoc(0)
+    : BasicPreparedGeometry(geom), ptOnGeomLocType(INDEXED_LOCATOR),
+      segIntFinder(0), ptOnGeomLoc(0)
 {
 	isRectangle = getGeometry().isRectangle();
 }
@@ -73,11 +75,27 @@ PreparedPolygon::
 getPointLocator() const
 {
 	if (! ptOnGeomLoc) 
-		ptOnGeomLoc = new algorithm::locate::IndexedPointInAreaLocator( getGeometry() );
+	{
+		if ( ptOnGeomLocType == GRID_LOCATOR )
+			ptOnGeomLoc = new algorithm::locate::GridPointInAreaLocator( getGeometry() );
+		else
+			ptOnGeomLoc = new algorithm::locate::IndexedPointInAreaLocator( getGeometry() );
+	}
 
 	return ptOnGeomLoc;
 }
 
+void
+PreparedPolygon::
+setPointLocatorType( PointLocatorType type)
+{
+	if ( type == ptOnGeomLocType ) return;
+
+	ptOnGeomLocType = type;
+	delete ptOnGeomLoc;
+	ptOnGeomLoc = 0;
+}
+
 bool 
 PreparedPolygon::
 contains( const geom::Geometry * g) const
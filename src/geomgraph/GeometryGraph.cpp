@@ -28,8 +28,11 @@
 #include <geos/geomgraph/Edge.h>
 #include <geos/geomgraph/Label.h>
 #include <geos/geomgraph/Position.h>
+#include <geos/geomgraph/SelfNodingCache.h>
+#include <geos/geomgraph/EdgeIntersectionList.h>
 
 #include <geos/geomgraph/index/SimpleMCSweepLineIntersector.h> 
+#include <geos/geomgraph/index/STRtreeEdgeSetIntersector.h>
 #include <geos/geomgraph/index/SegmentIntersector.h> 
 #include <geos/geomgraph/index/EdgeSetIntersector.h>
 
@@ -106,9 +109,25 @@ GeometryGraph::createEdgeSetIntersector()
 	//private EdgeSetIntersector esi = new MCSweepLineIntersector();
 
 	//return new SimpleEdgeSetIntersector();
+	if ( edgeSetIntersectorType == STRTREE_INTERSECTOR )
+		return new STRtreeEdgeSetIntersector();
 	return new SimpleMCSweepLineIntersector();
 }
 
+/*public*/
+void
+GeometryGraph::setEdgeSetIntersectorType(EdgeSetIntersectorType type)
+{
+	edgeSetIntersectorType = type;
+}
+
+/*public*/
+GeometryGraph::EdgeSetIntersectorType
+GeometryGraph::getEdgeSetIntersectorType() const
+{
+	return edgeSetIntersectorType;
+}
+
 /*public*/
 vector<Node*>*
 GeometryGraph::getBoundaryNodes()
@@ -348,19 +367,22 @@ SegmentIntersector*
 GeometryGraph::computeSelfNodes(LineIntersector *li, bool computeRingSelfNodes)
 {
 	SegmentIntersector *si=new SegmentIntersector(li,true,false);
-    	auto_ptr<EdgeSetIntersector> esi(createEdgeSetIntersector());
 
 	// optimized test for Polygons and Rings
-	if (! computeRingSelfNodes
-	    && ( dynamic_cast<const LinearRing*>(parentGeom)
+	bool testAllSegments = computeRingSelfNodes
+	    || ! ( dynamic_cast<const LinearRing*>(parentGeom)
 	    || dynamic_cast<const Polygon*>(parentGeom)
-	    || dynamic_cast<const MultiPolygon*>(parentGeom) ))
-	{
-		esi->computeIntersections(edges, si, false);
-	}
-	else
+	    || dynamic_cast<const MultiPolygon*>(parentGeom) );
+
+	// The cache only describes edges with no intersections added yet
+	SelfNodingCache* cache = parentGeom ? parentGeom->getSelfNodingCache() : 0;
+	if ( cache && hasEdgeIntersections() ) cache = 0;
+
+	if ( ! cache || ! cache->restore(*edges, *li, testAllSegments, *si) )
 	{
-		esi->computeIntersections(edges, si, true);
+		auto_ptr<EdgeSetIntersector> esi(createEdgeSetIntersector());
+		esi->computeIntersections(edges, si, testAllSegments);
+		if ( cache ) cache->store(*edges, *li, testAllSegments, *si);
 	}
 
 #if GEOS_DEBUG
@@ -371,6 +393,18 @@ GeometryGraph::computeSelfNodes(LineIntersector *li, bool computeRingSelfNodes)
 	return si;
 }
 
+/*private*/
+bool
+GeometryGraph::hasEdgeIntersections() const
+{
+	for (vector<Edge*>::const_iterator i=edges->begin(), e=edges->end();
+			i!=e; ++i)
+	{
+		if ( ! (*i)->getEdgeIntersectionList().isEmpty() ) return true;
+	}
+	return false;
+}
+
 SegmentIntersector*
 GeometryGraph::computeEdgeIntersections(GeometryGraph *g,
 	LineIntersector *li, bool includeProper)
@@ -497,7 +531,8 @@ GeometryGraph::GeometryGraph(int newArgIndex,
 	useBoundaryDeterminationRule(true),
 	boundaryNodeRule(algorithm::BoundaryNodeRule::OGC_SFS_BOUNDARY_RULE),
 	argIndex(newArgIndex),
-	hasTooFewPointsVar(false)
+	hasTooFewPointsVar(false),
+	edgeSetIntersectorType(SWEEPLINE_INTERSECTOR)
 {
 	if (parentGeom!=NULL) add(parentGeom);
 }
@@ -511,7 +546,8 @@ GeometryGraph::GeometryGraph(int newArgIndex,
 	useBoundaryDeterminationRule(true),
 	boundaryNodeRule(bnr),
 	argIndex(newArgIndex),
-	hasTooFewPointsVar(false)
+	hasTooFewPointsVar(false),
+	edgeSetIntersectorType(SWEEPLINE_INTERSECTOR)
 {
 	if (parentGeom!=NULL) add(parentGeom);
 }
@@ -523,7 +559,8 @@ GeometryGraph::GeometryGraph()
 	useBoundaryDeterminationRule(true),
 	boundaryNodeRule(algorithm::BoundaryNodeRule::OGC_SFS_BOUNDARY_RULE),
 	argIndex(-1),
-	hasTooFewPointsVar(false)
+	hasTooFewPointsVar(false),
+	edgeSetIntersectorType(SWEEPLINE_INTERSECTOR)
 {
 }
 
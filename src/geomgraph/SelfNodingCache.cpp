@@ -0,0 +1,180 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geomgraph/SelfNodingCache.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/EdgeIntersection.h>
+#include <geos/geomgraph/EdgeIntersectionList.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/Coordinate.h>
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+using namespace geos::geom;
+using geos::geomgraph::index::SegmentIntersector;
+using geos::algorithm::LineIntersector;
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+
+class SelfNodingCache::Entry {
+
+public:
+
+	Entry(const PrecisionModel& nPm)
+		:
+		pm(nPm)
+	{}
+
+	/// Rounding used for the intersection points
+	PrecisionModel pm;
+
+	/// Number of points of each edge, to tell graphs apart
+	std::vector<int> edgeNumPoints;
+
+	/// Intersections of edge i end at intersectionsEnd[i]
+	std::vector<std::size_t> intersectionsEnd;
+
+	std::vector<EdgeIntersection> intersections;
+
+	bool hasIntersection;
+	bool hasProper;
+	bool hasProperInterior;
+	Coordinate properIntersectionPoint;
+	int numIntersections;
+	int numTests;
+
+	bool matches(const std::vector<Edge*>& edges,
+	             const PrecisionModel& otherPm) const
+	{
+		if ( pm.getType() != otherPm.getType() ) return false;
+		if ( pm.getType() == PrecisionModel::FIXED &&
+		     pm.getScale() != otherPm.getScale() ) return false;
+
+		if ( edges.size() != edgeNumPoints.size() ) return false;
+		for (std::size_t i=0, n=edges.size(); i<n; ++i)
+		{
+			if ( edges[i]->getNumPoints() != edgeNumPoints[i] )
+				return false;
+		}
+		return true;
+	}
+};
+
+namespace {
+
+/// A NULL precision model means no rounding, same as a floating one
+PrecisionModel
+getRoundingModel(const LineIntersector& li)
+{
+	const PrecisionModel* pm = li.getPrecisionModel();
+	return pm ? *pm : PrecisionModel();
+}
+
+} // anonymous namespace
+
+/*public*/
+SelfNodingCache::SelfNodingCache()
+{
+	entries[0] = entries[1] = 0;
+}
+
+/*public*/
+SelfNodingCache::~SelfNodingCache()
+{
+	clear();
+}
+
+/*public*/
+void
+SelfNodingCache::clear()
+{
+	delete entries[0];
+	delete entries[1];
+	entries[0] = entries[1] = 0;
+}
+
+/*public*/
+bool
+SelfNodingCache::restore(std::vector<Edge*>& edges,
+		const LineIntersector& li, bool testAllSegments,
+		SegmentIntersector& si) const
+{
+	const Entry* e = entries[testAllSegments ? 1 : 0];
+	if ( ! e || ! e->matches(edges, getRoundingModel(li)) ) return false;
+
+	std::size_t j = 0;
+	for (std::size_t i=0, n=edges.size(); i<n; ++i)
+	{
+		EdgeIntersectionList& eiList = edges[i]->getEdgeIntersectionList();
+		assert(eiList.isEmpty());
+		for (std::size_t end=e->intersectionsEnd[i]; j<end; ++j)
+		{
+			const EdgeIntersection& ei = e->intersections[j];
+			eiList.add(ei.coord, ei.segmentIndex, ei.dist);
+		}
+	}
+
+	si.hasIntersectionVar = e->hasIntersection;
+	si.hasProper = e->hasProper;
+	si.hasProperInterior = e->hasProperInterior;
+	si.properIntersectionPoint = e->properIntersectionPoint;
+	si.numIntersections = e->numIntersections;
+	si.numTests = e->numTests;
+
+	return true;
+}
+
+/*public*/
+void
+SelfNodingCache::store(std::vector<Edge*>& edges,
+		const LineIntersector& li, bool testAllSegments,
+		SegmentIntersector& si)
+{
+	Entry* e = new Entry(getRoundingModel(li));
+
+	std::size_t n = edges.size();
+	e->edgeNumPoints.reserve(n);
+	e->intersectionsEnd.reserve(n);
+	for (std::size_t i=0; i<n; ++i)
+	{
+		Edge* edge = edges[i];
+		e->edgeNumPoints.push_back(edge->getNumPoints());
+
+		EdgeIntersectionList& eiList = edge->getEdgeIntersectionList();
+		for (EdgeIntersectionList::const_iterator
+				it=eiList.begin(), itEnd=eiList.end();
+				it!=itEnd; ++it)
+		{
+			e->intersections.push_back(**it);
+		}
+		e->intersectionsEnd.push_back(e->intersections.size());
+	}
+
+	e->hasIntersection = si.hasIntersectionVar;
+	e->hasProper = si.hasProper;
+	e->hasProperInterior = si.hasProperInterior;
+	e->properIntersectionPoint = si.properIntersectionPoint;
+	e->numIntersections = si.numIntersections;
+	e->numTests = si.numTests;
+
+	Entry*& slot = entries[testAllSegments ? 1 : 0];
+	delete slot;
+	slot = e;
+}
+
+} // namespace geos.geomgraph
+} // namespace geos
@@ -0,0 +1,281 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+#include <geos/geomgraph/index/STRtreeEdgeSetIntersector.h>
+#include <geos/geomgraph/index/MonotoneChainEdge.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+namespace index { // geos.geomgraph.index
+
+namespace {
+
+template <class Item>
+struct CentreXLessThen {
+	bool operator()(const Item& a, const Item& b) const {
+		return a.minX + a.maxX < b.minX + b.maxX;
+	}
+};
+
+template <class Item>
+struct CentreYLessThen {
+	bool operator()(const Item& a, const Item& b) const {
+		return a.minY + a.maxY < b.minY + b.maxY;
+	}
+};
+
+template <class Item>
+bool
+overlaps(const Item& a, double minX, double minY, double maxX, double maxY)
+{
+	return ! ( a.minX > maxX || a.maxX < minX ||
+	           a.minY > maxY || a.maxY < minY );
+}
+
+/*
+ * Sort-Tile-Recursive packing of items[start, end) into nodes
+ * of up to nodeCapacity children, appended to out.
+ * Items and out may be the same vector, hence the use of indexes.
+ */
+template <class Item, class Node>
+void
+packLevel(vector<Item>& items, size_t start, size_t end,
+	size_t nodeCapacity, vector<Node>& out)
+{
+	size_t n = end - start;
+	size_t nNodes = (n + nodeCapacity - 1) / nodeCapacity;
+	size_t nSlices = size_t(ceil(sqrt(double(nNodes))));
+	size_t sliceCapacity = nodeCapacity * ((nNodes + nSlices - 1) / nSlices);
+
+	sort(items.begin() + start, items.begin() + end,
+	     CentreXLessThen<Item>());
+
+	for (size_t sliceStart = start; sliceStart < end;
+	     sliceStart += sliceCapacity)
+	{
+		size_t sliceEnd = min(sliceStart + sliceCapacity, end);
+		sort(items.begin() + sliceStart, items.begin() + sliceEnd,
+		     CentreYLessThen<Item>());
+
+		for (size_t i = sliceStart; i < sliceEnd; i += nodeCapacity)
+		{
+			Node node;
+			node.childStart = i;
+			node.childEnd = min(i + nodeCapacity, sliceEnd);
+			node.minX = items[i].minX;
+			node.minY = items[i].minY;
+			node.maxX = items[i].maxX;
+			node.maxY = items[i].maxY;
+			for (size_t j = i + 1; j < node.childEnd; ++j)
+			{
+				const Item& it = items[j];
+				if (it.minX < node.minX) node.minX = it.minX;
+				if (it.minY < node.minY) node.minY = it.minY;
+				if (it.maxX > node.maxX) node.maxX = it.maxX;
+				if (it.maxY > node.maxY) node.maxY = it.maxY;
+			}
+			out.push_back(node);
+		}
+	}
+}
+
+} // anonymous namespace
+
+const size_t STRtreeEdgeSetIntersector::DEFAULT_NODE_CAPACITY;
+
+STRtreeEdgeSetIntersector::STRtreeEdgeSetIntersector(size_t nNodeCapacity)
+	:
+	nodeCapacity(nNodeCapacity),
+	leafEnd(0),
+	nOverlaps(0)
+{
+	assert(nodeCapacity > 1);
+}
+
+STRtreeEdgeSetIntersector::~STRtreeEdgeSetIntersector()
+{
+}
+
+void
+STRtreeEdgeSetIntersector::computeIntersections(vector<Edge*> *edges,
+	SegmentIntersector *si, bool testAllSegments)
+{
+	if (testAllSegments)
+		add(edges, NULL);
+	else
+	{
+		// edge is its own group
+		for (size_t i=0; i<edges->size(); ++i)
+			add((*edges)[i], (*edges)[i]);
+	}
+	computeIntersections(si);
+}
+
+void
+STRtreeEdgeSetIntersector::computeIntersections(vector<Edge*> *edges0,
+	vector<Edge*> *edges1, SegmentIntersector *si)
+{
+	add(edges0, edges0);
+	add(edges1, edges1);
+	computeIntersections(si);
+}
+
+void
+STRtreeEdgeSetIntersector::add(vector<Edge*> *edges, const void* edgeSet)
+{
+	for (size_t i=0; i<edges->size(); ++i)
+		add((*edges)[i], edgeSet);
+}
+
+void
+STRtreeEdgeSetIntersector::add(Edge *edge, const void* edgeSet)
+{
+	MonotoneChainEdge *mce=edge->getMonotoneChainEdge();
+	const CoordinateSequence *pts=mce->getCoordinates();
+	vector<int> &startIndex=mce->getStartIndexes();
+	size_t n = startIndex.size()-1;
+	chains.reserve(chains.size()+n);
+	for(size_t i=0; i<n; ++i)
+	{
+		// the envelope of a monotone chain is that of its endpoints
+		const Coordinate& p0=pts->getAt(startIndex[i]);
+		const Coordinate& p1=pts->getAt(startIndex[i+1]);
+		Chain c;
+		c.minX = min(p0.x, p1.x);
+		c.maxX = max(p0.x, p1.x);
+		c.minY = min(p0.y, p1.y);
+		c.maxY = max(p0.y, p1.y);
+		c.mce = mce;
+		c.chainIndex = int(i);
+		c.edgeSet = edgeSet;
+		c.id = chains.size();
+		chains.push_back(c);
+	}
+}
+
+void
+STRtreeEdgeSetIntersector::build()
+{
+	nodes.clear();
+	if (chains.empty()) return;
+
+	packLevel(chains, 0, chains.size(), nodeCapacity, nodes);
+	leafEnd = nodes.size();
+
+	size_t levelStart = 0;
+	while (nodes.size() - levelStart > 1)
+	{
+		size_t levelEnd = nodes.size();
+		packLevel(nodes, levelStart, levelEnd, nodeCapacity, nodes);
+		levelStart = levelEnd;
+	}
+}
+
+/*private static*/
+bool
+STRtreeEdgeSetIntersector::precedes(const Chain& c0, const Chain& c1)
+{
+	// the order in which the sweep line would insert the chains
+	if (c0.minX != c1.minX) return c0.minX < c1.minX;
+	return c0.id < c1.id;
+}
+
+/*private static*/
+bool
+STRtreeEdgeSetIntersector::precedesPtr(const Chain* c0, const Chain* c1)
+{
+	return precedes(*c0, *c1);
+}
+
+void
+STRtreeEdgeSetIntersector::computeIntersections(SegmentIntersector *si)
+{
+	nOverlaps=0;
+	build();
+
+	vector<const Chain*> order;
+	order.reserve(chains.size());
+	for (size_t i=0; i<chains.size(); ++i) order.push_back(&chains[i]);
+	sort(order.begin(), order.end(), precedesPtr);
+
+	for (size_t i=0; i<order.size(); ++i)
+	{
+		const Chain& c0 = *order[i];
+		query(c0);
+		for (size_t j=0; j<candidates.size(); ++j)
+		{
+			const Chain& c1 = *candidates[j];
+			c0.mce->computeIntersectsForChain(c0.chainIndex,
+				*c1.mce, c1.chainIndex, *si);
+			nOverlaps++;
+		}
+	}
+}
+
+void
+STRtreeEdgeSetIntersector::query(const Chain& qc)
+{
+	candidates.clear();
+	stack.clear();
+	stack.push_back(nodes.size()-1);
+	while (!stack.empty())
+	{
+		size_t nodeIndex = stack.back();
+		stack.pop_back();
+		const Node& node = nodes[nodeIndex];
+		if (!overlaps(node, qc.minX, qc.minY, qc.maxX, qc.maxY))
+			continue;
+
+		if (nodeIndex >= leafEnd)
+		{
+			for (size_t i=node.childStart; i<node.childEnd; ++i)
+				stack.push_back(i);
+			continue;
+		}
+
+		for (size_t i=node.childStart; i<node.childEnd; ++i)
+		{
+			const Chain& c = chains[i];
+			// each pair is tested once, from the chain inserted first;
+			// a chain is tested against itself only if not in a set
+			if (&c == &qc) {
+				if (qc.edgeSet != NULL) continue;
+			}
+			else {
+				if (qc.edgeSet != NULL && qc.edgeSet == c.edgeSet)
+					continue;
+				if (!precedes(qc, c)) continue;
+				if (!overlaps(c, qc.minX, qc.minY, qc.maxX, qc.maxY))
+					continue;
+			}
+			candidates.push_back(&c);
+		}
+	}
+
+	// test in the order the sweep line would
+	sort(candidates.begin(), candidates.end(), precedesPtr);
+}
+
+} // namespace geos.geomgraph.index
+} // namespace geos.geomgraph
+} // namespace geos
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <geos/index/bintree/Bintree.h>
 #include <geos/index/bintree/Root.h>
+#include <geos/index/bintree/Node.h>
 #include <geos/index/bintree/Interval.h>
 #include <vector>
 
@@ -139,6 +140,27 @@ Bintree::query(Interval *interval,vector<void*> *foundItems)
 	root->addAllItemsFromOverlapping(interval,foundItems);
 }
 
+void
+Bintree::query(Interval *interval, vector<void*> *foundItems,
+		QueryStatistics& stats)
+{
+	root->addAllItemsFromOverlapping(interval,foundItems,stats);
+}
+
+IndexStatistics
+Bintree::getStatistics()
+{
+	IndexStatistics stats;
+	root->addStatistics(stats);
+	// every node but the root fills a half of its parent
+	stats.fillFactor=double(stats.numNodes-1)/double(2*stats.numNodes);
+	stats.memorySize+=sizeof(Root)
+		+(stats.numNodes-1)*(sizeof(Node)+sizeof(Interval))
+		+newIntervals.capacity()*sizeof(Interval*)
+		+newIntervals.size()*sizeof(Interval);
+	return stats;
+}
+
 void
 Bintree::collectStats(Interval *interval)
 {
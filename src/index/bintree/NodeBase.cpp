@@ -16,6 +16,8 @@
 #include <geos/index/bintree/NodeBase.h>
 #include <geos/index/bintree/Interval.h>
 #include <geos/index/bintree/Node.h>
+#include <geos/index/IndexStatistics.h>
+#include <geos/index/QueryStatistics.h>
 #include <geos/index/chain/MonotoneChain.h> // FIXME: split
 
 #include <vector>
@@ -79,20 +81,56 @@ vector<void*>* NodeBase::addAllItems(vector<void*> *newItems) {
 	return items;
 }
 
-vector<void*>*
-NodeBase::addAllItemsFromOverlapping(Interval *interval,vector<void*> *resultItems)
+template <class Stats>
+void
+NodeBase::collectOverlapping(Interval *interval, vector<void*> *resultItems,
+		Stats& stats)
 {
 	if (!isSearchMatch(interval))
-		return items;
-	resultItems->insert(resultItems->end(),items->begin(),items->end());
+		return;
+	stats.visitNode();
+	if (!items->empty()) {
+		stats.testLeaf();
+		stats.returnItems(items->size());
+		resultItems->insert(resultItems->end(),items->begin(),items->end());
+	}
 	for (int i=0;i<2;i++) {
 		if (subnode[i]!=NULL) {
-			subnode[i]->addAllItemsFromOverlapping(interval,resultItems);
+			subnode[i]->collectOverlapping(interval,resultItems,stats);
 		}
 	}
+}
+
+vector<void*>*
+NodeBase::addAllItemsFromOverlapping(Interval *interval,vector<void*> *resultItems)
+{
+	NoQueryStatistics stats;
+	collectOverlapping(interval,resultItems,stats);
 	return items;
 }
 
+void
+NodeBase::addAllItemsFromOverlapping(Interval *interval,
+		vector<void*> *resultItems, QueryStatistics& stats)
+{
+	collectOverlapping(interval,resultItems,stats);
+}
+
+void
+NodeBase::addStatistics(IndexStatistics& stats, size_t nodeDepth)
+{
+	++stats.numNodes;
+	stats.numItems += items->size();
+	stats.memorySize += sizeof(vector<void*>)
+		+ items->capacity()*sizeof(void*);
+	if (nodeDepth>stats.depth) stats.depth=nodeDepth;
+	for (int i=0;i<2;i++) {
+		if (subnode[i]!=NULL) {
+			subnode[i]->addStatistics(stats,nodeDepth+1);
+		}
+	}
+}
+
 int
 NodeBase::depth()
 {
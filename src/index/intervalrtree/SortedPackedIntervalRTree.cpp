@@ -13,9 +13,6 @@
  **********************************************************************/
 
 #include <geos/index/intervalrtree/SortedPackedIntervalRTree.h>
-#include <geos/index/intervalrtree/IntervalRTreeNode.h>
-#include <geos/index/intervalrtree/IntervalRTreeLeafNode.h>
-#include <geos/index/intervalrtree/IntervalRTreeBranchNode.h>
 #include <geos/index/ItemVisitor.h>
 #include <geos/util/UnsupportedOperationException.h>
 
@@ -28,69 +25,101 @@
 namespace geos {
 namespace index {
 namespace intervalrtree {
+
+namespace {
+
+struct Leaf
+{
+	double min;
+	double max;
+	void * item;
+};
+
+bool
+leafMidpointLess( const Leaf & l1, const Leaf & l2)
+{
+	return l1.min + l1.max < l2.min + l2.max;
+}
+
+class VisitorCaller
+{
+public:
+	VisitorCaller( index::ItemVisitor * visitor)
+	:	visitor( visitor)
+	{ }
+
+	void operator()( void * item)
+	{
+		visitor->visitItem( item);
+	}
+
+private:
+	index::ItemVisitor * visitor;
+};
+
+} // anonymous namespace
+
 //
 // private:
 //
 void 
 SortedPackedIntervalRTree::init()
 {
-	if (root != NULL) return;
+	if ( built ) return;
 
-	root = buildTree();
+	buildTree();
+	built = true;
 }
 
-const IntervalRTreeNode * 
+void 
 SortedPackedIntervalRTree::buildTree()
 {
-	// sort the leaf nodes
-	std::sort( leaves->begin(), leaves->end(), IntervalRTreeNode::compare );
-
-	// now group nodes into blocks of two and build tree up recursively
-	IntervalRTreeNode::ConstVect * src = leaves;
-	IntervalRTreeNode::ConstVect * dest = new IntervalRTreeNode::ConstVect();
+	std::size_t const n = items.size();
+	if ( n == 0 ) return;
 
-	while (true) 
+	// sort the leaves by midpoint, keeping items alongside
+	std::vector<Leaf> leaves( n);
+	for ( std::size_t i = 0; i < n; ++i )
 	{
-		buildLevel( src, dest);
-	
-		if (dest->size() == 1)
-		{
-			const IntervalRTreeNode * r = (*dest)[ 0 ];
-			delete src;
-			delete dest;
-			//delete leaves; // don't need anymore
-			return r;
-		}
-
-		IntervalRTreeNode::ConstVect * temp = src;
-		src = dest;
-		dest = temp;
+		leaves[ i ].min = bounds[ i ].min;
+		leaves[ i ].max = bounds[ i ].max;
+		leaves[ i ].item = items[ i ];
+	}
+	std::stable_sort( leaves.begin(), leaves.end(), leafMidpointLess);
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		bounds[ i ].min = leaves[ i ].min;
+		bounds[ i ].max = leaves[ i ].max;
+		items[ i ] = leaves[ i ].item;
 	}
-}
 
-void 
-SortedPackedIntervalRTree::buildLevel( IntervalRTreeNode::ConstVect * src, IntervalRTreeNode::ConstVect * dest) 
-{
-	level++;
+	// now group nodes into pairs, level by level up to the root
+	std::size_t total = n;
+	for ( std::size_t size = n; size > 1; size = ( size + 1 ) / 2 )
+		total += ( size + 1 ) / 2;
+	bounds.reserve( total);
 
-	dest->clear();
-	
-	for (size_t i = 0, ni = src->size(); i < ni; i += 2) 
+	levelStarts.push_back( 0);
+	std::size_t levelStart = 0;
+	std::size_t levelEnd = n;
+	while ( true )
 	{
-		const IntervalRTreeNode * n1 = (*src)[ i ];
+		levelStarts.push_back( levelEnd);
+		if ( levelEnd - levelStart == 1 ) return;
 
-		if ( i + 1 < ni )
+		for ( std::size_t i = levelStart; i < levelEnd; i += 2 )
 		{
-			const IntervalRTreeNode * n2 = (*src)[ i + 1 ];
-
-			const IntervalRTreeNode * node = new IntervalRTreeBranchNode( n1, n2 );
-
-			dest->push_back( node);
-		}
-		else
-		{
-			dest->push_back( n1);
+			Interval node = bounds[ i ];
+			if ( i + 1 < levelEnd )
+			{
+				const Interval & other = bounds[ i + 1 ];
+				node.min = (std::min)( node.min, other.min);
+				node.max = (std::max)( node.max, other.max);
+			}
+			bounds.push_back( node);
 		}
+		levelStart = levelEnd;
+		levelEnd = bounds.size();
 	}
 }
 
@@ -103,43 +132,32 @@ SortedPackedIntervalRTree::buildLevel( IntervalRTreeNode::ConstVect * src, Inter
 //
 SortedPackedIntervalRTree::SortedPackedIntervalRTree()
 	:
-	leaves( new IntervalRTreeNode::ConstVect()),
-	root( NULL),
-	level( 0)
+	built( false)
 { }
 
 SortedPackedIntervalRTree::~SortedPackedIntervalRTree()
 {
-	if ( root != NULL )
-	{
-		// deleting root cascades to all IntervalRTreeNode's
-		delete root;
-	}
-	else // possibly IntervalRTreeNode's in leaves to delete
-	{
-		for ( size_t i = 0, ni = leaves->size(); i < ni; i++ )
-			delete (*leaves)[i];
-
-		delete leaves;
-	}
 }
 
 
 void 
 SortedPackedIntervalRTree::insert( double min, double max, void * item)
 {
-	if (root != NULL)
-		throw new util::UnsupportedOperationException( "Index cannot be added to once it has been queried");
-
-	leaves->push_back( new IntervalRTreeLeafNode( min, max, item));
+	if ( built )
+		throw util::UnsupportedOperationException( "Index cannot be added to once it has been queried");
+
+	Interval interval;
+	interval.min = min;
+	interval.max = max;
+	bounds.push_back( interval);
+	items.push_back( item);
 }
 
 void 
 SortedPackedIntervalRTree::query( double min, double max, index::ItemVisitor * visitor)
 {
-	init();
-
-	root->query( min, max, visitor);
+	VisitorCaller caller( visitor);
+	query( min, max, caller);
 }
 
 } // geos::intervalrtree
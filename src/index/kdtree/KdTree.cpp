@@ -0,0 +1,342 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/kdtree/KdTree.h>
+#include <geos/index/kdtree/KdNode.h>
+#include <geos/index/kdtree/KdNodeVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos::index
+namespace kdtree { // geos::index::kdtree
+
+namespace {
+
+/*
+ * The largest share of the nodes of a subtree one of its children
+ * may hold in a balanced tree
+ */
+const double BALANCE_ALPHA = 0.7;
+
+/// The height over which a subtree of the given size is unbalanced
+inline double
+maxHeight(std::size_t size)
+{
+	return std::log(double(size)) / std::log(1 / BALANCE_ALPHA) + 1;
+}
+
+/// A node to visit, and whether it splits by x
+typedef std::pair<KdNode*, bool> StackEntry;
+
+inline double
+key(const KdNode* node, bool splitX)
+{
+	return splitX ? node->getX() : node->getY();
+}
+
+struct KeyLess
+{
+	KeyLess(bool x) : splitX(x) {}
+	bool operator()(const KdNode* a, const KdNode* b) const
+	{
+		return key(a, splitX) < key(b, splitX);
+	}
+	bool splitX;
+};
+
+struct KeyBelow
+{
+	KeyBelow(bool x, double k) : splitX(x), value(k) {}
+	bool operator()(const KdNode* n) const
+	{
+		return key(n, splitX) < value;
+	}
+	bool splitX;
+	double value;
+};
+
+/*
+ * Calls visitor with the nodes whose point is in env. The nodes
+ * to the left of a node have a key lower than its own, those to
+ * its right a key at least equal.
+ */
+template <class Visitor>
+void
+queryNodes(KdNode* root, const Envelope& env, Visitor& visitor,
+           std::vector<StackEntry>& stack)
+{
+	if ( ! root || env.isNull() ) return;
+
+	stack.clear();
+	stack.push_back(StackEntry(root, true));
+	while ( ! stack.empty() )
+	{
+		KdNode* node = stack.back().first;
+		bool splitX = stack.back().second;
+		stack.pop_back();
+
+		const Coordinate& p = node->getCoordinate();
+		if ( env.covers(p.x, p.y) ) visitor(node);
+
+		double k = key(node, splitX);
+		double queryMin = splitX ? env.getMinX() : env.getMinY();
+		double queryMax = splitX ? env.getMaxX() : env.getMaxY();
+		if ( node->getLeft() && queryMin < k )
+			stack.push_back(StackEntry(node->getLeft(), ! splitX));
+		if ( node->getRight() && queryMax >= k )
+			stack.push_back(StackEntry(node->getRight(), ! splitX));
+	}
+}
+
+class VisitorCaller
+{
+public:
+	VisitorCaller(KdNodeVisitor& v) : visitor(v) {}
+	void operator()(KdNode* node) { visitor.visit(node); }
+private:
+	KdNodeVisitor& visitor;
+};
+
+class NodeCollector
+{
+public:
+	NodeCollector(std::vector<KdNode*>& r) : result(r) {}
+	void operator()(KdNode* node) { result.push_back(node); }
+private:
+	std::vector<KdNode*>& result;
+};
+
+/// Keeps the node nearest to p within the tolerance
+class BestMatchFinder
+{
+public:
+	BestMatchFinder(const Coordinate& pt, double tol)
+		:
+		p(pt),
+		tolerance(tol),
+		best(0),
+		bestDistance(0)
+	{}
+
+	void operator()(KdNode* node)
+	{
+		double d = p.distance(node->getCoordinate());
+		if ( d > tolerance ) return;
+		if ( ! best || d < bestDistance )
+		{
+			best = node;
+			bestDistance = d;
+		}
+	}
+
+	KdNode* getBest() const { return best; }
+
+private:
+	const Coordinate& p;
+	double tolerance;
+	KdNode* best;
+	double bestDistance;
+};
+
+} // anonymous namespace
+
+/*public*/
+KdTree::KdTree(double nTolerance)
+	:
+	tolerance(nTolerance),
+	root(0)
+{
+}
+
+/*public*/
+KdTree::~KdTree()
+{
+}
+
+/*public*/
+KdNode*
+KdTree::insert(const Coordinate& p, void* data)
+{
+	if ( ! root )
+	{
+		nodes.push_back(KdNode(p, data));
+		root = &nodes.back();
+		return root;
+	}
+
+	if ( tolerance > 0 )
+	{
+		KdNode* match = findBestMatch(p);
+		if ( match )
+		{
+			++match->count;
+			return match;
+		}
+	}
+
+	path.clear();
+	KdNode* node = root;
+	bool splitX = true;
+	KdNode* newNode = 0;
+	while ( ! newNode )
+	{
+		if ( p.equals2D(node->p) )
+		{
+			++node->count;
+			return node;
+		}
+
+		path.push_back(node);
+		bool goLeft = splitX ? p.x < node->p.x : p.y < node->p.y;
+		KdNode*& child = goLeft ? node->left : node->right;
+		if ( child )
+		{
+			node = child;
+			splitX = ! splitX;
+			continue;
+		}
+
+		nodes.push_back(KdNode(p, data));
+		newNode = child = &nodes.back();
+	}
+
+	for (std::size_t i=0; i<path.size(); ++i)
+		++path[i]->subtreeSize;
+
+	rebalance(path.size());
+	return newNode;
+}
+
+/*public*/
+void
+KdTree::query(const Envelope& queryEnv, KdNodeVisitor& visitor) const
+{
+	std::vector<StackEntry> stack;
+	VisitorCaller caller(visitor);
+	queryNodes(root, queryEnv, caller, stack);
+}
+
+/*public*/
+void
+KdTree::query(const Envelope& queryEnv, std::vector<KdNode*>& result) const
+{
+	std::vector<StackEntry> stack;
+	NodeCollector collector(result);
+	queryNodes(root, queryEnv, collector, stack);
+}
+
+/*public static*/
+void
+KdTree::toCoordinates(const std::vector<KdNode*>& kdnodes,
+                      std::vector<Coordinate>& coords,
+                      bool includeRepeated)
+{
+	for (std::size_t i=0; i<kdnodes.size(); ++i)
+	{
+		const KdNode* node = kdnodes[i];
+		std::size_t count = includeRepeated ? node->getCount() : 1;
+		coords.insert(coords.end(), count, node->getCoordinate());
+	}
+}
+
+/*private*/
+KdNode*
+KdTree::findBestMatch(const Coordinate& p)
+{
+	Envelope queryEnv(p.x - tolerance, p.x + tolerance,
+	                  p.y - tolerance, p.y + tolerance);
+	BestMatchFinder finder(p, tolerance);
+	queryNodes(root, queryEnv, finder, stack);
+	return finder.getBest();
+}
+
+/*
+ * private
+ *
+ * If the node just inserted at the given depth is deeper than a
+ * balanced tree allows, rebuilds the subtree of its deepest
+ * ancestor too high for the number of its nodes.
+ */
+void
+KdTree::rebalance(std::size_t depth)
+{
+	if ( double(depth) <= maxHeight(nodes.size()) ) return;
+
+	for (std::size_t i=path.size(); i-- > 0; )
+	{
+		KdNode* node = path[i];
+		double height = double(depth - i);
+		if ( height <= maxHeight(node->subtreeSize) ) continue;
+
+		rebuildNodes.clear();
+		rebuildNodes.push_back(node);
+		for (std::size_t j=0; j<rebuildNodes.size(); ++j)
+		{
+			KdNode* n = rebuildNodes[j];
+			if ( n->left ) rebuildNodes.push_back(n->left);
+			if ( n->right ) rebuildNodes.push_back(n->right);
+		}
+
+		// nodes at even depths split by x
+		KdNode* subtree = buildBalanced(0, rebuildNodes.size(), i % 2 == 0);
+		if ( i == 0 )
+		{
+			root = subtree;
+			return;
+		}
+		KdNode* parent = path[i - 1];
+		if ( parent->left == node ) parent->left = subtree;
+		else parent->right = subtree;
+		return;
+	}
+}
+
+/*
+ * private
+ *
+ * Links the nodes rebuildNodes[begin, end) into a tree whose root
+ * splits by x or y at the median, and returns its root.
+ */
+KdNode*
+KdTree::buildBalanced(std::size_t begin, std::size_t end, bool splitX)
+{
+	if ( begin == end ) return 0;
+
+	typedef std::vector<KdNode*>::iterator Iter;
+	Iter first = rebuildNodes.begin() + begin;
+	Iter last = rebuildNodes.begin() + end;
+	Iter mid = first + (end - begin) / 2;
+	std::nth_element(first, mid, last, KeyLess(splitX));
+
+	// the nodes with the median key go right of it
+	Iter split = std::partition(first, mid,
+	                            KeyBelow(splitX, key(*mid, splitX)));
+	std::iter_swap(split, mid);
+
+	std::size_t splitIndex = begin + (split - first);
+	KdNode* node = *split;
+	node->subtreeSize = end - begin;
+	node->left = buildBalanced(begin, splitIndex, ! splitX);
+	node->right = buildBalanced(splitIndex + 1, end, ! splitX);
+	return node;
+}
+
+} // namespace geos::index::kdtree
+} // namespace geos::index
+} // namespace geos
@@ -19,6 +19,7 @@
 
 #include <geos/index/quadtree/Node.h> 
 #include <geos/index/quadtree/Key.h> 
+#include <geos/index/quadtree/NodePool.h> 
 #include <geos/geom/Envelope.h>
 
 #include <string>
@@ -40,25 +41,28 @@ namespace geos {
 namespace index { // geos.index
 namespace quadtree { // geos.index.quadtree
 
+/* public static */
+Node*
+Node::createNode(const Envelope& env, NodePool& pool)
+{
+	Key key(env);
+	return pool.create(key.getEnvelope(), key.getLevel());
+}
+
 /* public static */
 std::auto_ptr<Node>
 Node::createNode(const Envelope& env)
 {
 	Key key(env);
-
-	std::auto_ptr<Envelope> nenv ( new Envelope(key.getEnvelope()) );
-	std::auto_ptr<Node> node (
-		new Node(nenv, key.getLevel())
-	);
-	return node;
+	return std::auto_ptr<Node>(new Node(key.getEnvelope(), key.getLevel()));
 }
 
 /* static public */
-std::auto_ptr<Node>
-Node::createExpanded(std::auto_ptr<Node> node, const Envelope& addEnv)
+Node*
+Node::createExpanded(Node* node, const Envelope& addEnv, NodePool& pool)
 {
 	Envelope expandEnv(addEnv);
-	if ( node.get() ) // should this be asserted ?
+	if ( node ) // should this be asserted ?
 	{
 		expandEnv.expandToInclude(node->getEnvelope());
 	}
@@ -67,6 +71,25 @@ Node::createExpanded(std::auto_ptr<Node> node, const Envelope& addEnv)
 	cerr<<"Node::createExpanded computed "<<expandEnv.toString()<<endl;
 #endif
 
+	Node* largerNode = createNode(expandEnv, pool);
+	if ( node ) // should this be asserted ?
+	{
+		largerNode->insertNode(node, pool);
+	}
+
+	return largerNode;
+}
+
+/* static public */
+std::auto_ptr<Node>
+Node::createExpanded(std::auto_ptr<Node> node, const Envelope& addEnv)
+{
+	Envelope expandEnv(addEnv);
+	if ( node.get() ) // should this be asserted ?
+	{
+		expandEnv.expandToInclude(node->getEnvelope());
+	}
+
 	std::auto_ptr<Node> largerNode = createNode(expandEnv);
 	if ( node.get() ) // should this be asserted ?
 	{
@@ -76,22 +99,55 @@ Node::createExpanded(std::auto_ptr<Node> node, const Envelope& addEnv)
 	return largerNode;
 }
 
+/*public*/
+Node::~Node()
+{
+	if ( ! ownsSubnodes ) return;
+	for (int i=0; i<4; ++i) delete subnode[i];
+}
+
+/*private*/
+void
+Node::init(const Envelope& nenv, int nlevel)
+{
+	env = nenv;
+	centre.x = (env.getMinX()+env.getMaxX())/2;
+	centre.y = (env.getMinY()+env.getMaxY())/2;
+	level = nlevel;
+	items.clear();
+	for (int i=0; i<4; ++i) subnode[i] = NULL;
+}
+
 /*public*/
 Node*
-Node::getNode(const Envelope *searchEnv)
+Node::getNode(const Envelope *searchEnv, NodePool& pool)
 {
-	int subnodeIndex = getSubnodeIndex(searchEnv, centre);
-	// if subquadIndex is -1 searchEnv is not contained in a subquad
-	if (subnodeIndex != -1)
+	assert( ! ownsSubnodes );
+
+	Node* node = this;
+	for (;;)
 	{
-		// create the quad if it does not exist
-		Node *node = getSubnode(subnodeIndex);
-		// recursively search the found/created quad
-		return node->getNode(searchEnv);
+		int subnodeIndex = getSubnodeIndex(searchEnv, node->centre);
+		// if subquadIndex is -1 searchEnv is not contained in a subquad
+		if (subnodeIndex == -1) return node;
+
+		// create the quad if it does not exist, and search it
+		node = node->getSubnode(subnodeIndex, pool);
 	}
-	else
+}
+
+/*public*/
+Node*
+Node::getNode(const Envelope *searchEnv)
+{
+	assert( ownsSubnodes );
+
+	Node* node = this;
+	for (;;)
 	{
-		return this;
+		int subnodeIndex = getSubnodeIndex(searchEnv, node->centre);
+		if (subnodeIndex == -1) return node;
+		node = node->getSubnode(subnodeIndex);
 	}
 }
 
@@ -99,22 +155,53 @@ Node::getNode(const Envelope *searchEnv)
 NodeBase*
 Node::find(const Envelope *searchEnv)
 {
-	int subnodeIndex=getSubnodeIndex(searchEnv, centre);
-	if (subnodeIndex==-1)
-		return this;
-	if (subnode[subnodeIndex]!=NULL) {
+	Node* node = this;
+	for (;;)
+	{
+		int subnodeIndex=getSubnodeIndex(searchEnv, node->centre);
+		if (subnodeIndex==-1)
+			return node;
+		// no existing subquad, so return this one anyway
+		if (node->subnode[subnodeIndex]==NULL)
+			return node;
 		// query lies in subquad, so search it
-		Node *node=subnode[subnodeIndex];
-		return node->find(searchEnv);
+		node=node->subnode[subnodeIndex];
+	}
+}
+
+void
+Node::insertNode(Node* node, NodePool& pool)
+{
+	assert( ! ownsSubnodes );
+	assert( env.contains(node->getEnvelope()) );
+
+	int index = getSubnodeIndex(node->getEnvelope(), centre);
+	assert(index >= 0);
+
+	if (node->level == level-1)
+	{
+		if ( subnode[index] ) pool.release(subnode[index]);
+		subnode[index] = node;
+
+		//System.out.println("inserted");
+	}
+	else
+	{
+		// the quad is not a direct child, so make a new child
+		// quad to contain it and recursively insert the quad
+		Node* childNode = createSubnode(index, pool);
+		childNode->insertNode(node, pool);
+
+		if ( subnode[index] ) pool.release(subnode[index]);
+		subnode[index] = childNode;
 	}
-	// no existing subquad, so return this one anyway
-	return this;
 }
 
 void
 Node::insertNode(std::auto_ptr<Node> node)
 {
-	assert( env->contains(node->getEnvelope()) );
+	assert( ownsSubnodes );
+	assert( env.contains(node->getEnvelope()) );
 
 	int index = getSubnodeIndex(node->getEnvelope(), centre);
 	assert(index >= 0);
@@ -124,8 +211,6 @@ Node::insertNode(std::auto_ptr<Node> node)
 		// We take ownership of node 
 		delete subnode[index];
 		subnode[index] = node.release();
-
-		//System.out.println("inserted");
 	}
 	else
 	{
@@ -142,6 +227,17 @@ Node::insertNode(std::auto_ptr<Node> node)
 	}
 }
 
+Node*
+Node::getSubnode(int index, NodePool& pool)
+{
+	assert(index >=0 && index < 4);
+	if (subnode[index] == NULL)
+	{
+		subnode[index] = createSubnode(index, pool);
+	}
+	return subnode[index];
+}
+
 Node*
 Node::getSubnode(int index)
 {
@@ -153,10 +249,22 @@ Node::getSubnode(int index)
 	return subnode[index];
 }
 
+Node*
+Node::createSubnode(int index, NodePool& pool)
+{
+	return pool.create(getSubnodeEnvelope(index), level-1);
+}
+
 std::auto_ptr<Node>
 Node::createSubnode(int index)
 {
-	// create a new subquad in the appropriate quadrant
+	return std::auto_ptr<Node>(new Node(getSubnodeEnvelope(index), level-1));
+}
+
+Envelope
+Node::getSubnodeEnvelope(int index) const
+{
+	// the extent of a subquad in the appropriate quadrant
 	double minx=0.0;
 	double maxx=0.0;
 	double miny=0.0;
@@ -164,40 +272,38 @@ Node::createSubnode(int index)
 
 	switch (index) {
 		case 0:
-			minx=env->getMinX();
+			minx=env.getMinX();
 			maxx=centre.x;
-			miny=env->getMinY();
+			miny=env.getMinY();
 			maxy=centre.y;
 			break;
 		case 1:
 			minx=centre.x;
-			maxx=env->getMaxX();
-			miny=env->getMinY();
+			maxx=env.getMaxX();
+			miny=env.getMinY();
 			maxy=centre.y;
 			break;
 		case 2:
-			minx=env->getMinX();
+			minx=env.getMinX();
 			maxx=centre.x;
 			miny=centre.y;
-			maxy=env->getMaxY();
+			maxy=env.getMaxY();
 			break;
 		case 3:
 			minx=centre.x;
-			maxx=env->getMaxX();
+			maxx=env.getMaxX();
 			miny=centre.y;
-			maxy=env->getMaxY();
+			maxy=env.getMaxY();
 			break;
 	}
-	std::auto_ptr<Envelope> sqEnv ( new Envelope(minx,maxx,miny,maxy) );
-	std::auto_ptr<Node> node ( new Node(sqEnv, level-1) );
-	return node;
+	return Envelope(minx,maxx,miny,maxy);
 }
 
 string
 Node::toString() const
 {
 	ostringstream os;
-	os <<"L"<<level<<" "<<env->toString()<<" Ctr["<<centre.toString()<<"]";
+	os <<"L"<<level<<" "<<env.toString()<<" Ctr["<<centre.toString()<<"]";
 	os <<" "+NodeBase::toString();
 	return os.str();
 }
@@ -19,13 +19,16 @@
 
 #include <geos/index/quadtree/NodeBase.h> 
 #include <geos/index/quadtree/Node.h> 
+#include <geos/index/quadtree/NodePool.h> 
 #include <geos/index/ItemVisitor.h> 
+#include <geos/index/IndexStatistics.h> 
+#include <geos/index/QueryStatistics.h> 
 #include <geos/geom/Envelope.h>
 #include <geos/geom/Coordinate.h>
-#include <geos/util.h>
 
 #include <sstream>
 #include <vector>
+#include <utility>
 #include <algorithm>
 
 #ifndef GEOS_DEBUG
@@ -43,6 +46,78 @@ namespace geos {
 namespace index { // geos.index
 namespace quadtree { // geos.index.quadtree
 
+namespace {
+
+class ItemCollector
+{
+public:
+	ItemCollector(vector<void*>& r) : result(r) {}
+	void operator()(const vector<void*>& items)
+	{
+		result.insert(result.end(), items.begin(), items.end());
+	}
+private:
+	vector<void*>& result;
+};
+
+class ItemVisitorCaller
+{
+public:
+	ItemVisitorCaller(ItemVisitor& v) : visitor(v) {}
+	void operator()(const vector<void*>& items)
+	{
+		for (vector<void*>::const_iterator i=items.begin(), e=items.end();
+				i!=e; ++i)
+		{
+			visitor.visitItem(*i);
+		}
+	}
+private:
+	ItemVisitor& visitor;
+};
+
+class ItemCounter
+{
+public:
+	ItemCounter() : count(0) {}
+	void operator()(const vector<void*>& items) { count += items.size(); }
+	unsigned int count;
+};
+
+} // anonymous namespace
+
+/*private*/
+template <class ItemAction, class Stats>
+void
+NodeBase::traverse(const Envelope* searchEnv, NodeStack& stack,
+                   ItemAction& action, Stats& stats) const
+{
+	stack.clear();
+	stack.push_back(this);
+	while ( ! stack.empty() )
+	{
+		const NodeBase* node = stack.back();
+		stack.pop_back();
+		if ( searchEnv && ! node->isSearchMatch(*searchEnv) ) continue;
+		stats.visitNode();
+
+		// this node may have items as well as subnodes (since items may not
+		// be wholely contained in any single subnode
+		if ( ! node->items.empty() )
+		{
+			stats.testLeaf();
+			stats.returnItems(node->items.size());
+			action(node->items);
+		}
+
+		// pushed last first, so that they are visited in order
+		for (int i=3; i>=0; --i)
+		{
+			if ( node->subnode[i] ) stack.push_back(node->subnode[i]);
+		}
+	}
+}
+
 int
 NodeBase::getSubnodeIndex(const Envelope *env, const Coordinate& centre)
 {
@@ -71,14 +146,6 @@ NodeBase::NodeBase()
 
 NodeBase::~NodeBase()
 {
-	delete subnode[0];
-	delete subnode[1];
-	delete subnode[2];
-	delete subnode[3];
-	subnode[0]=NULL;
-	subnode[1]=NULL;
-	subnode[2]=NULL;
-	subnode[3]=NULL;
 }
 
 vector<void*>&
@@ -98,17 +165,10 @@ NodeBase::add(void* item)
 vector<void*>&
 NodeBase::addAllItems(vector<void*>& resultItems) const
 {
-	// this node may have items as well as subnodes (since items may not
-	// be wholely contained in any single subnode
-	resultItems.insert(resultItems.end(), items.begin(), items.end());
-
-	for(int i=0; i<4; ++i)
-	{
-		if ( subnode[i] )
-		{
-			subnode[i]->addAllItems(resultItems);
-		}
-	}
+	NodeStack stack;
+	ItemCollector collector(resultItems);
+	NoQueryStatistics stats;
+	traverse(0, stack, collector, stats);
 	return resultItems;
 }
 
@@ -116,21 +176,18 @@ void
 NodeBase::addAllItemsFromOverlapping(const Envelope& searchEnv,
                                      vector<void*>& resultItems) const
 {
-	if (!isSearchMatch(searchEnv))
-		return;
-
-	// this node may have items as well as subnodes (since items may not
-	// be wholely contained in any single subnode
-	resultItems.insert(resultItems.end(), items.begin(), items.end());
+	NodeStack stack;
+	addAllItemsFromOverlapping(searchEnv, resultItems, stack);
+}
 
-	for(int i=0; i<4; ++i)
-	{
-		if ( subnode[i] )
-		{
-			subnode[i]->addAllItemsFromOverlapping(searchEnv,
-			                                       resultItems);
-		}
-	}
+void
+NodeBase::addAllItemsFromOverlapping(const Envelope& searchEnv,
+                                     vector<void*>& resultItems,
+                                     NodeStack& stack) const
+{
+	ItemCollector collector(resultItems);
+	NoQueryStatistics stats;
+	traverse(&searchEnv, stack, collector, stats);
 }
 
 //<<TODO:RENAME?>> In Samet's terminology, I think what we're returning here is
@@ -154,15 +211,11 @@ NodeBase::depth() const
 unsigned int
 NodeBase::size() const
 {
-	unsigned int subSize=0;
-	for(int i=0; i<4; i++)
-	{
-		if (subnode[i] != NULL)
-		{
-			subSize += subnode[i]->size();
-		}
-	}
-	return subSize + items.size();
+	NodeStack stack;
+	ItemCounter counter;
+	NoQueryStatistics stats;
+	traverse(0, stack, counter, stats);
+	return counter.count;
 }
 
 unsigned int
@@ -197,39 +250,75 @@ NodeBase::toString() const
 
 /*public*/
 void
-NodeBase::visit(const Envelope* searchEnv, ItemVisitor& visitor)
+NodeBase::visit(const Envelope* searchEnv, ItemVisitor& visitor) const
 {
-	if (! isSearchMatch(*searchEnv)) return;
-
-	// this node may have items as well as subnodes (since items may not
-	// be wholely contained in any single subnode
-	visitItems(searchEnv, visitor);
-
-	for (int i = 0; i < 4; i++) {
-		if (subnode[i] != NULL) {
-			subnode[i]->visit(searchEnv, visitor);
-		}
-	}
+	NodeStack stack;
+	visit(searchEnv, visitor, stack);
 }
 
-/*private*/
+/*public*/
 void
-NodeBase::visitItems(const Envelope* searchEnv, ItemVisitor& visitor)
+NodeBase::visit(const Envelope* searchEnv, ItemVisitor& visitor,
+                NodeStack& stack) const
 {
-    ::geos::ignore_unused_variable_warning(searchEnv);
-
 	// would be nice to filter items based on search envelope, but can't
 	// until they contain an envelope
-	for (vector<void*>::iterator i=items.begin(), e=items.end();
-			i!=e; i++)
+	ItemVisitorCaller caller(visitor);
+	NoQueryStatistics stats;
+	traverse(searchEnv, stack, caller, stats);
+}
+
+/*public*/
+void
+NodeBase::visit(const Envelope* searchEnv, ItemVisitor& visitor,
+                NodeStack& stack, QueryStatistics& stats) const
+{
+	ItemVisitorCaller caller(visitor);
+	traverse(searchEnv, stack, caller, stats);
+}
+
+/*public*/
+void
+NodeBase::addStatistics(IndexStatistics& stats) const
+{
+	typedef std::pair<const NodeBase*, std::size_t> NodeDepth;
+	vector<NodeDepth> stack(1, NodeDepth(this, 1));
+	while ( ! stack.empty() )
 	{
-		visitor.visitItem(*i);
+		const NodeBase* node = stack.back().first;
+		std::size_t nodeDepth = stack.back().second;
+		stack.pop_back();
+
+		++stats.numNodes;
+		stats.numItems += node->items.size();
+		stats.memorySize += node->items.capacity() * sizeof(void*);
+		if ( nodeDepth > stats.depth ) stats.depth = nodeDepth;
+
+		for (int i=0; i<4; ++i)
+		{
+			if ( node->subnode[i] )
+				stack.push_back(NodeDepth(node->subnode[i], nodeDepth + 1));
+		}
 	}
 }
 
+/*public*/
+bool
+NodeBase::remove(const Envelope* itemEnv, void* item, NodePool& pool)
+{
+	return removeItem(itemEnv, item, &pool);
+}
+
 /*public*/
 bool
 NodeBase::remove(const Envelope* itemEnv, void* item)
+{
+	return removeItem(itemEnv, item, 0);
+}
+
+/*private*/
+bool
+NodeBase::removeItem(const Envelope* itemEnv, void* item, NodePool* pool)
 {
 	// use envelope to restrict nodes scanned
 	if (! isSearchMatch(*itemEnv)) return false;
@@ -239,13 +328,14 @@ NodeBase::remove(const Envelope* itemEnv, void* item)
 	{
 		if ( subnode[i] )
 		{
-			found = subnode[i]->remove(itemEnv, item);
+			found = subnode[i]->removeItem(itemEnv, item, pool);
 			if (found)
 			{
 				// trim subtree if empty
 				if (subnode[i]->isPrunable())
 				{
-					delete subnode[i];
+					if ( pool ) pool->release(subnode[i]);
+					else delete subnode[i];
 					subnode[i] = NULL;
 				}
 				break;
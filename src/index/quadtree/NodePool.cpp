@@ -0,0 +1,79 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/quadtree/NodePool.h>
+#include <geos/index/quadtree/Node.h>
+#include <geos/geom/Envelope.h>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace quadtree { // geos.index.quadtree
+
+/*public*/
+NodePool::NodePool()
+	:
+	numUsed(0)
+{
+}
+
+/*public*/
+NodePool::~NodePool()
+{
+}
+
+/*public*/
+Node*
+NodePool::create(const Envelope& env, int level)
+{
+	Node* node;
+	if ( ! freeNodes.empty() )
+	{
+		node = freeNodes.back();
+		freeNodes.pop_back();
+	}
+	else if ( numUsed < nodes.size() )
+	{
+		node = &nodes[numUsed++];
+	}
+	else
+	{
+		nodes.push_back(Node(env, level));
+		++numUsed;
+		nodes.back().ownsSubnodes = false;
+		return &nodes.back();
+	}
+
+	// reused, with the capacity of its item list
+	node->init(env, level);
+	return node;
+}
+
+/*public*/
+void
+NodePool::release(Node* node)
+{
+	freeNodes.push_back(node);
+}
+
+/*public*/
+void
+NodePool::clear()
+{
+	numUsed = 0;
+	freeNodes.clear();
+}
+
+} // namespace geos.index.quadtree
+} // namespace geos.index
+} // namespace geos
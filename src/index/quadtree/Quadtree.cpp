@@ -130,6 +130,28 @@ Quadtree::queryAll()
 	return foundItems;
 }
 
+/*public*/
+void
+Quadtree::clear()
+{
+	root.clear();
+	for (unsigned int i=0; i<newEnvelopes.size(); i++)
+		delete newEnvelopes[i];
+	newEnvelopes.clear();
+	minExtent = 1.0;
+}
+
+/*public*/
+IndexStatistics
+Quadtree::getStatistics() const
+{
+	IndexStatistics stats;
+	root.addStatistics(stats);
+	stats.memorySize += newEnvelopes.capacity() * sizeof(Envelope*)
+		+ newEnvelopes.size() * sizeof(Envelope);
+	return stats;
+}
+
 /*public*/
 bool
 Quadtree::remove(const Envelope* itemEnv, void* item)
@@ -20,6 +20,7 @@
 #include <geos/index/quadtree/Root.h>
 #include <geos/index/quadtree/Node.h>
 #include <geos/index/quadtree/IntervalSize.h>
+#include <geos/index/IndexStatistics.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Envelope.h>
 
@@ -78,19 +79,14 @@ Root::insert(const Envelope *itemEnv, void* item)
 	 */
 	if (node==NULL || !node->getEnvelope()->contains(itemEnv))
 	{
-		std::auto_ptr<Node> snode (node); // may be NULL
-		node = 0; subnode[index] = 0;
-
-		std::auto_ptr<Node> largerNode =
-			Node::createExpanded(snode, *itemEnv);
+		Node* largerNode = Node::createExpanded(node, *itemEnv, pool);
 
 #if GEOS_DEBUG
-		std::cerr<<"("<<this<<") created expanded node " << largerNode.get() << " containing previously reported subnode" << std::endl;
+		std::cerr<<"("<<this<<") created expanded node " << largerNode << " containing previously reported subnode" << std::endl;
 #endif
 
 		// Previous subnode was passed as a child of the larger one
-		assert(!subnode[index]);
-		subnode[index] = largerNode.release();
+		subnode[index] = largerNode;
 	}
 
 #if GEOS_DEBUG
@@ -110,6 +106,35 @@ Root::insert(const Envelope *itemEnv, void* item)
 	//System.out.println(" size = " + size());
 }
 
+/*public*/
+bool
+Root::remove(const Envelope* itemEnv, void* item)
+{
+	return NodeBase::remove(itemEnv, item, pool);
+}
+
+/*public*/
+void
+Root::clear()
+{
+	items.clear();
+	for (int i=0; i<4; ++i) subnode[i] = NULL;
+	pool.clear();
+}
+
+/*public*/
+void
+Root::addStatistics(IndexStatistics& stats) const
+{
+	std::size_t numNodes = stats.numNodes;
+	NodeBase::addStatistics(stats);
+	numNodes = stats.numNodes - numNodes;
+
+	// every node but this one fills a quadrant of its parent
+	stats.fillFactor = double(numNodes - 1) / double(4 * numNodes);
+	stats.memorySize += pool.getMemorySize();
+}
+
 /*private*/
 void
 Root::insertContained(Node *tree, const Envelope *itemEnv, void *item)
@@ -134,7 +159,7 @@ Root::insertContained(Node *tree, const Envelope *itemEnv, void *item)
 	}
 	else
 	{
-		node = tree->getNode(itemEnv);
+		node = tree->getNode(itemEnv, pool);
 	}
 
 	node->add(item);
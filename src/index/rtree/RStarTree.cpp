@@ -0,0 +1,569 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/rtree/RStarTree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+
+using namespace std;
+using geos::geom::Envelope;
+
+namespace geos {
+namespace index { // geos.index
+namespace rtree { // geos.index.rtree
+
+struct RStarTree::Entry
+{
+	Entry(const Envelope& e, Node* c, void* i)
+		: env(e), child(c), item(i) {}
+
+	Envelope env;
+
+	/// The node below, or 0 in a leaf
+	Node* child;
+
+	/// The item, in a leaf
+	void* item;
+};
+
+class RStarTree::Node
+{
+public:
+
+	explicit Node(size_t l) : level(l) {}
+
+	/// The height of the node above the leaves, 0 for a leaf
+	size_t level;
+
+	vector<Entry> entries;
+
+	Envelope bounds() const
+	{
+		Envelope b;
+		for (size_t i=0; i<entries.size(); ++i)
+			b.expandToInclude(&entries[i].env);
+		return b;
+	}
+};
+
+namespace {
+
+double
+area(const Envelope& e)
+{
+	return (e.getMaxX() - e.getMinX()) * (e.getMaxY() - e.getMinY());
+}
+
+/// Half the perimeter
+double
+margin(const Envelope& e)
+{
+	return (e.getMaxX() - e.getMinX()) + (e.getMaxY() - e.getMinY());
+}
+
+double
+overlap(const Envelope& a, const Envelope& b)
+{
+	double w = min(a.getMaxX(), b.getMaxX()) - max(a.getMinX(), b.getMinX());
+	if ( w <= 0 ) return 0;
+	double h = min(a.getMaxY(), b.getMaxY()) - max(a.getMinY(), b.getMinY());
+	if ( h <= 0 ) return 0;
+	return w * h;
+}
+
+/// Orders entries by their lower or upper bound on an axis,
+/// then by the other bound
+template <class E>
+class BoundLess
+{
+public:
+	BoundLess(int a, bool u) : axis(a), upper(u) {}
+
+	bool operator()(const E& a, const E& b) const
+	{
+		double a1 = lower(a.env), b1 = lower(b.env);
+		double a2 = higher(a.env), b2 = higher(b.env);
+		if ( upper ) { swap(a1, a2); swap(b1, b2); }
+		if ( a1 != b1 ) return a1 < b1;
+		return a2 < b2;
+	}
+
+private:
+	int axis;
+	bool upper;
+
+	double lower(const Envelope& e) const
+	{ return axis ? e.getMinY() : e.getMinX(); }
+
+	double higher(const Envelope& e) const
+	{ return axis ? e.getMaxY() : e.getMaxX(); }
+};
+
+/// Orders entries by decreasing distance of their centre to a point
+template <class E>
+class FartherFirst
+{
+public:
+	FartherFirst(double x, double y) : cx(2*x), cy(2*y) {}
+
+	bool operator()(const E& a, const E& b) const
+	{
+		return distance(a.env) > distance(b.env);
+	}
+
+private:
+	// the doubled centre, compared with min+max
+	double cx, cy;
+
+	double distance(const Envelope& e) const
+	{
+		double dx = e.getMinX() + e.getMaxX() - cx;
+		double dy = e.getMinY() + e.getMaxY() - cy;
+		return dx*dx + dy*dy;
+	}
+};
+
+/*
+ * Computes in lows[i] the bounds of entries [0, i] and in highs[i]
+ * the bounds of entries [i, n).
+ */
+template <class E>
+void
+groupBounds(const vector<E>& entries, vector<Envelope>& lows,
+		vector<Envelope>& highs)
+{
+	size_t n = entries.size();
+	lows.resize(n);
+	highs.resize(n);
+	lows[0] = entries[0].env;
+	for (size_t i=1; i<n; ++i)
+	{
+		lows[i] = lows[i-1];
+		lows[i].expandToInclude(&entries[i].env);
+	}
+	highs[n-1] = entries[n-1].env;
+	for (size_t i=n-1; i-- > 0; )
+	{
+		highs[i] = highs[i+1];
+		highs[i].expandToInclude(&entries[i].env);
+	}
+}
+
+struct MatchesCollector
+{
+	MatchesCollector(vector<void*>& m) : matches(m) {}
+	void operator()(void* item) { matches.push_back(item); }
+	vector<void*>& matches;
+};
+
+struct VisitorCaller
+{
+	VisitorCaller(ItemVisitor& v) : visitor(v) {}
+	void operator()(void* item) { visitor.visitItem(item); }
+	ItemVisitor& visitor;
+};
+
+} // anonymous namespace
+
+RStarTree::RStarTree(size_t nodeCapacity)
+	:
+	root(new Node(0)),
+	numItems(0),
+	maxEntries(nodeCapacity),
+	minEntries(max(size_t(1), nodeCapacity * 2 / 5)),
+	reinsertCount(nodeCapacity * 3 / 10)
+{
+	if ( nodeCapacity < 2 )
+	{
+		delete root;
+		throw util::IllegalArgumentException(
+			"RStarTree node capacity must be at least 2");
+	}
+}
+
+RStarTree::~RStarTree()
+{
+	deleteTree(root);
+}
+
+/*private static*/
+void
+RStarTree::deleteTree(Node* node)
+{
+	if ( node->level > 0 )
+	{
+		for (size_t i=0; i<node->entries.size(); ++i)
+			deleteTree(node->entries[i].child);
+	}
+	delete node;
+}
+
+/*public*/
+size_t
+RStarTree::depth() const
+{
+	return root->level + 1;
+}
+
+/*public*/
+void
+RStarTree::insert(const Envelope *itemEnv, void* item)
+{
+	if ( itemEnv->isNull() ) return;
+	insert(Entry(*itemEnv, 0, item), 0);
+	++numItems;
+}
+
+/*private*/
+void
+RStarTree::insert(const Entry& entry, size_t level)
+{
+	// Levels where a node has given up entries for reinsertion
+	vector<bool> overflowed;
+	vector<Entry> reinserts;
+
+	Entry next = entry;
+	for (;;)
+	{
+		overflowed.resize(root->level + 1, false);
+		Node* sibling = insert(root, next, level, overflowed, reinserts);
+		if ( sibling )
+		{
+			Node* newRoot = new Node(root->level + 1);
+			newRoot->entries.reserve(maxEntries + 1);
+			newRoot->entries.push_back(Entry(root->bounds(), root, 0));
+			newRoot->entries.push_back(Entry(sibling->bounds(), sibling, 0));
+			root = newRoot;
+		}
+
+		if ( reinserts.empty() ) break;
+
+		// The nearest to the centre of their node come last
+		next = reinserts.back();
+		reinserts.pop_back();
+		level = next.child ? next.child->level + 1 : 0;
+	}
+}
+
+/*
+ * Adds entry below node, and returns a new sibling of node
+ * if it had to be split.
+ */
+/*private*/
+RStarTree::Node*
+RStarTree::insert(Node* node, const Entry& entry, size_t level,
+		vector<bool>& overflowed, vector<Entry>& reinserts)
+{
+	if ( node->level == level )
+	{
+		node->entries.push_back(entry);
+	}
+	else
+	{
+		size_t i = chooseSubtree(*node, entry.env);
+		Node* child = node->entries[i].child;
+		Node* sibling = insert(child, entry, level, overflowed, reinserts);
+
+		// the child may have given up entries as well as gained one
+		node->entries[i].env = child->bounds();
+		if ( sibling )
+			node->entries.push_back(Entry(sibling->bounds(), sibling, 0));
+	}
+
+	if ( node->entries.size() <= maxEntries ) return 0;
+	return overflow(node, overflowed, reinserts);
+}
+
+/*private*/
+RStarTree::Node*
+RStarTree::overflow(Node* node, vector<bool>& overflowed,
+		vector<Entry>& reinserts)
+{
+	if ( node == root || overflowed[node->level] || ! reinsertCount )
+		return split(node);
+
+	overflowed[node->level] = true;
+
+	Envelope b = node->bounds();
+	double cx = (b.getMinX() + b.getMaxX()) / 2;
+	double cy = (b.getMinY() + b.getMaxY()) / 2;
+
+	vector<Entry>& entries = node->entries;
+	sort(entries.begin(), entries.end(), FartherFirst<Entry>(cx, cy));
+	reinserts.insert(reinserts.end(), entries.begin(),
+	                 entries.begin() + reinsertCount);
+	entries.erase(entries.begin(), entries.begin() + reinsertCount);
+	return 0;
+}
+
+/*private*/
+size_t
+RStarTree::chooseSubtree(const Node& node, const Envelope& env) const
+{
+	const vector<Entry>& entries = node.entries;
+	size_t n = entries.size();
+
+	// Where env is already covered, neither the area nor the overlap
+	// grow: the smallest such entry is the best
+	size_t best = n;
+	double bestArea = 0;
+	for (size_t i=0; i<n; ++i)
+	{
+		const Envelope& e = entries[i].env;
+		if ( ! e.covers(env) ) continue;
+		double a = area(e);
+		if ( best == n || a < bestArea )
+		{
+			best = i;
+			bestArea = a;
+		}
+	}
+	if ( best < n ) return best;
+
+	double bestOverlap = 0, bestEnlargement = 0;
+	for (size_t i=0; i<n; ++i)
+	{
+		const Envelope& e = entries[i].env;
+		Envelope enlarged(e);
+		enlarged.expandToInclude(&env);
+		double a = area(e);
+		double enlargement = area(enlarged) - a;
+
+		// Just above the leaves, the overlap with the siblings
+		// matters most. It only grows with those the enlarged
+		// envelope intersects.
+		double overlapGrowth = 0;
+		if ( node.level == 1 )
+		{
+			for (size_t j=0; j<n; ++j)
+			{
+				const Envelope& other = entries[j].env;
+				if ( j == i || ! enlarged.intersects(other) ) continue;
+				overlapGrowth += overlap(enlarged, other) - overlap(e, other);
+			}
+		}
+
+		if ( i == 0 ||
+		     overlapGrowth < bestOverlap ||
+		     ( overlapGrowth == bestOverlap &&
+		       ( enlargement < bestEnlargement ||
+		         ( enlargement == bestEnlargement && a < bestArea ) ) ) )
+		{
+			best = i;
+			bestOverlap = overlapGrowth;
+			bestEnlargement = enlargement;
+			bestArea = a;
+		}
+	}
+	return best;
+}
+
+/*
+ * Splits node in two, keeping the first group and returning a
+ * new node with the second one.
+ */
+/*private*/
+RStarTree::Node*
+RStarTree::split(Node* node) const
+{
+	vector<Entry>& entries = node->entries;
+	size_t n = entries.size();
+	size_t firstSplit = minEntries;
+	size_t lastSplit = n - minEntries;
+	assert(firstSplit <= lastSplit);
+
+	vector<Envelope> lows, highs;
+
+	// The axis along which the groups have the smallest margins
+	int bestAxis = 0;
+	double bestMargin = 0;
+	for (int axis=0; axis<2; ++axis)
+	{
+		double sum = 0;
+		for (int upper=0; upper<2; ++upper)
+		{
+			sort(entries.begin(), entries.end(),
+			     BoundLess<Entry>(axis, upper != 0));
+			groupBounds(entries, lows, highs);
+			for (size_t k=firstSplit; k<=lastSplit; ++k)
+				sum += margin(lows[k-1]) + margin(highs[k]);
+		}
+		if ( axis == 0 || sum < bestMargin )
+		{
+			bestAxis = axis;
+			bestMargin = sum;
+		}
+	}
+
+	// The split along it with the least overlap, then area
+	bool bestUpper = false;
+	size_t bestSplit = firstSplit;
+	double bestOverlap = 0, bestArea = 0;
+	for (int upper=0; upper<2; ++upper)
+	{
+		sort(entries.begin(), entries.end(),
+		     BoundLess<Entry>(bestAxis, upper != 0));
+		groupBounds(entries, lows, highs);
+		for (size_t k=firstSplit; k<=lastSplit; ++k)
+		{
+			double o = overlap(lows[k-1], highs[k]);
+			double a = area(lows[k-1]) + area(highs[k]);
+			if ( ( upper == 0 && k == firstSplit ) ||
+			     o < bestOverlap || ( o == bestOverlap && a < bestArea ) )
+			{
+				bestUpper = upper != 0;
+				bestSplit = k;
+				bestOverlap = o;
+				bestArea = a;
+			}
+		}
+	}
+
+	sort(entries.begin(), entries.end(), BoundLess<Entry>(bestAxis, bestUpper));
+
+	Node* sibling = new Node(node->level);
+	sibling->entries.reserve(maxEntries + 1);
+	sibling->entries.assign(entries.begin() + bestSplit, entries.end());
+	entries.erase(entries.begin() + bestSplit, entries.end());
+	return sibling;
+}
+
+/*public*/
+bool
+RStarTree::remove(const Envelope* itemEnv, void* item)
+{
+	if ( itemEnv->isNull() ) return false;
+
+	vector<Node*> orphans;
+	if ( ! remove(root, *itemEnv, item, orphans) ) return false;
+	--numItems;
+
+	// All the other entries may have been left in orphans
+	if ( root->entries.empty() ) root->level = 0;
+
+	for (size_t i=0; i<orphans.size(); ++i)
+		reinsertOrphan(orphans[i]);
+
+	while ( root->level > 0 && root->entries.size() == 1 )
+	{
+		Node* child = root->entries[0].child;
+		delete root;
+		root = child;
+	}
+	return true;
+}
+
+/*
+ * Removes the item from the subtree of node, taking out of it
+ * the nodes left with too few entries.
+ */
+/*private*/
+bool
+RStarTree::remove(Node* node, const Envelope& env, void* item,
+		vector<Node*>& orphans)
+{
+	vector<Entry>& entries = node->entries;
+	if ( node->level == 0 )
+	{
+		for (size_t i=0; i<entries.size(); ++i)
+		{
+			if ( entries[i].item == item && entries[i].env.intersects(env) )
+			{
+				entries.erase(entries.begin() + i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	for (size_t i=0; i<entries.size(); ++i)
+	{
+		if ( ! entries[i].env.intersects(env) ) continue;
+
+		Node* child = entries[i].child;
+		if ( ! remove(child, env, item, orphans) ) continue;
+
+		if ( child->entries.size() < minEntries )
+		{
+			orphans.push_back(child);
+			entries.erase(entries.begin() + i);
+		}
+		else
+		{
+			entries[i].env = child->bounds();
+		}
+		return true;
+	}
+	return false;
+}
+
+/*private*/
+void
+RStarTree::reinsertOrphan(Node* orphan)
+{
+	for (size_t i=0; i<orphan->entries.size(); ++i)
+	{
+		const Entry& e = orphan->entries[i];
+		if ( orphan->level <= root->level )
+			insert(e, orphan->level);
+		else
+			// the tree has become too low to take the subtree whole
+			reinsertOrphan(e.child);
+	}
+	delete orphan;
+}
+
+/*public*/
+void
+RStarTree::query(const Envelope *searchEnv, vector<void*>& matches)
+{
+	if ( ! numItems || searchEnv->isNull() ) return;
+	MatchesCollector visit(matches);
+	query(*root, *searchEnv, visit);
+}
+
+/*public*/
+void
+RStarTree::query(const Envelope *searchEnv, ItemVisitor& visitor)
+{
+	if ( ! numItems || searchEnv->isNull() ) return;
+	VisitorCaller visit(visitor);
+	query(*root, *searchEnv, visit);
+}
+
+/*private*/
+template <class Visit>
+void
+RStarTree::query(const Node& node, const Envelope& searchEnv,
+		Visit& visit) const
+{
+	const vector<Entry>& entries = node.entries;
+	for (size_t i=0; i<entries.size(); ++i)
+	{
+		const Entry& e = entries[i];
+		if ( ! e.env.intersects(searchEnv) ) continue;
+		if ( node.level == 0 )
+			visit(e.item);
+		else
+			query(*e.child, searchEnv, visit);
+	}
+}
+
+} // namespace geos.index.rtree
+} // namespace geos.index
+} // namespace geos
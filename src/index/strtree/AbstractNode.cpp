@@ -52,7 +52,7 @@ AbstractNode::getBounds() const
 * Returns 0 if this node is a leaf, 1 if a parent of a leaf, and so on; the
 * root node will have the highest level
 */
-int AbstractNode::getLevel() {
+int AbstractNode::getLevel() const {
 	return level;
 }
 
@@ -55,8 +55,15 @@ AbstractSTRtree::~AbstractSTRtree()
 void
 AbstractSTRtree::build()
 {
-	assert(!built);
+	if (built) return;
 	root=(itemBoundables->empty()?createNode(0):createHigherLevels(itemBoundables,-1));
+
+	// Compute the bounds cached by the nodes now, rather than
+	// lazily on the first queries
+	for (std::size_t i = 0, nsize = nodes->size(); i < nsize; i++)
+	{
+		(*nodes)[i]->getBounds();
+	}
 	built=true;
 }
 
@@ -123,7 +130,11 @@ AbstractSTRtree::query(const void* searchBounds, vector<void*>& matches)
 {
 	if (!built) build();
 
-	if (itemBoundables->empty()) assert(root->getBounds()==NULL);
+	if (itemBoundables->empty())
+	{
+		assert(root->getBounds()==NULL);
+		return;
+	}
 
 	if (getIntersectsOp()->intersects(root->getBounds(), searchBounds))
 	{
@@ -137,7 +148,11 @@ AbstractSTRtree::query(const void* searchBounds, ItemVisitor& visitor)
 {
 	if (!built) build();
 
-	if (itemBoundables->empty()) assert(root->getBounds()==NULL);
+	if (itemBoundables->empty())
+	{
+		assert(root->getBounds()==NULL);
+		return;
+	}
 	
 	if (getIntersectsOp()->intersects(root->getBounds(),searchBounds))
 	{
@@ -183,6 +198,7 @@ AbstractSTRtree::remove(const void* searchBounds, void* item)
 	if (!built) build();
 	if (itemBoundables->empty()) {
 		assert(root->getBounds() == NULL);
+		return false;
 	}
 	if (getIntersectsOp()->intersects(root->getBounds(), searchBounds)) {
 		return remove(searchBounds, *root, item);
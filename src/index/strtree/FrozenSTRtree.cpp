@@ -0,0 +1,355 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/AbstractNode.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+
+using namespace std;
+using geos::geom::Envelope;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+/// Pending nodes of a query kept on the call stack, if there is room
+const size_t LOCAL_PENDING = 128;
+
+/// Same test as Envelope::intersects, for non-null envelopes
+inline bool
+intersects(const double* b, double minX, double minY,
+		double maxX, double maxY)
+{
+	return b[0] <= maxX && b[2] >= minX && b[1] <= maxY && b[3] >= minY;
+}
+
+struct MatchesCollector
+{
+	MatchesCollector(vector<void*>& m) : matches(m) {}
+	void operator()(void* item) { matches.push_back(item); }
+	vector<void*>& matches;
+};
+
+struct VisitorCaller
+{
+	VisitorCaller(ItemVisitor& v) : visitor(v) {}
+	void operator()(void* item) { visitor.visitItem(item); }
+	ItemVisitor& visitor;
+};
+
+/*
+ * An item or node while bulk-loading. For nodes, the children are
+ * the entries [first, first+count) of the level below; for items,
+ * first is the index of the item in the input.
+ */
+struct BuildEntry
+{
+	double minX, minY, maxX, maxY;
+	size_t first;
+	size_t count;
+};
+
+// Centres are compared as min+max, which orders them the same
+
+bool
+lessCentreX(const BuildEntry& a, const BuildEntry& b)
+{
+	return a.minX + a.maxX < b.minX + b.maxX;
+}
+
+bool
+lessCentreY(const BuildEntry& a, const BuildEntry& b)
+{
+	return a.minY + a.maxY < b.minY + b.maxY;
+}
+
+/*
+ * Sorts the children as STR does, and appends to parents
+ * the nodes grouping them. The vertical slices are disjoint
+ * ranges of the array, but are sorted one after the other,
+ * the library having no threads of its own.
+ */
+void
+packLevel(vector<BuildEntry>& children, size_t nodeCapacity,
+		vector<BuildEntry>& parents)
+{
+	size_t n = children.size();
+	sort(children.begin(), children.end(), lessCentreX);
+
+	size_t minLeafCount = (n + nodeCapacity - 1) / nodeCapacity;
+	size_t sliceCount = size_t(ceil(sqrt(double(minLeafCount))));
+	// whole nodes per slice, as in STRtree::verticalSlices
+	size_t sliceCapacity = nodeCapacity *
+		((minLeafCount + sliceCount - 1) / sliceCount);
+
+	parents.reserve(minLeafCount + sliceCount);
+	for (size_t slice=0; slice<n; slice+=sliceCapacity)
+	{
+		size_t sliceEnd = min(slice + sliceCapacity, n);
+		sort(children.begin() + slice, children.begin() + sliceEnd,
+		     lessCentreY);
+
+		for (size_t first=slice; first<sliceEnd; first+=nodeCapacity)
+		{
+			size_t end = min(first + nodeCapacity, sliceEnd);
+			BuildEntry node = children[first];
+			node.first = first;
+			node.count = end - first;
+			for (size_t i=first+1; i<end; ++i)
+			{
+				const BuildEntry& c = children[i];
+				if ( c.minX < node.minX ) node.minX = c.minX;
+				if ( c.minY < node.minY ) node.minY = c.minY;
+				if ( c.maxX > node.maxX ) node.maxX = c.maxX;
+				if ( c.maxY > node.maxY ) node.maxY = c.maxY;
+			}
+			parents.push_back(node);
+		}
+	}
+}
+
+void
+appendBounds(const BuildEntry& e, vector<double>& bounds)
+{
+	bounds.push_back(e.minX);
+	bounds.push_back(e.minY);
+	bounds.push_back(e.maxX);
+	bounds.push_back(e.maxY);
+}
+
+} // anonymous namespace
+
+FrozenSTRtree::FrozenSTRtree(const vector< pair<Envelope, void*> >& entries,
+		size_t nodeCapacity)
+	:
+	firstItem(0),
+	maxPending(0)
+{
+	assert(nodeCapacity > 1);
+
+	// levels[0] holds the items, the last level the root
+	vector< vector<BuildEntry> > levels(1);
+	levels[0].reserve(entries.size());
+	for (size_t i=0; i<entries.size(); ++i)
+	{
+		const Envelope& env = entries[i].first;
+		if ( env.isNull() ) continue;
+		BuildEntry e = { env.getMinX(), env.getMinY(),
+		                 env.getMaxX(), env.getMaxY(), i, 0 };
+		levels[0].push_back(e);
+	}
+	if ( levels[0].empty() )
+	{
+		childStart.push_back(0);
+		return;
+	}
+
+	size_t total = levels[0].size();
+	while ( levels.size() == 1 || levels.back().size() > 1 )
+	{
+		levels.push_back(vector<BuildEntry>());
+		packLevel(levels[levels.size() - 2], nodeCapacity, levels.back());
+		total += levels.back().size();
+	}
+
+	size_t numItems = levels[0].size();
+	firstItem = total - numItems;
+	maxPending = (levels.size() - 1) * (nodeCapacity - 1) + 1;
+
+	// Number the entries breadth-first, from the root down, so that
+	// the children of each node follow those of the previous one
+	bounds.reserve(4 * total);
+	childStart.reserve(firstItem + 1);
+	items.reserve(numItems);
+
+	vector<size_t> order(1, 0);
+	vector<size_t> nextOrder;
+	size_t nextBase = 1;
+	for (size_t level=levels.size()-1; level>0; --level)
+	{
+		const vector<BuildEntry>& nodes = levels[level];
+		nextOrder.clear();
+		nextOrder.reserve(levels[level-1].size());
+		for (size_t i=0; i<order.size(); ++i)
+		{
+			const BuildEntry& node = nodes[order[i]];
+			appendBounds(node, bounds);
+			childStart.push_back(nextBase + nextOrder.size());
+			for (size_t c=node.first; c<node.first+node.count; ++c)
+				nextOrder.push_back(c);
+		}
+		nextBase += nextOrder.size();
+		order.swap(nextOrder);
+		vector<BuildEntry>().swap(levels[level]);
+	}
+	childStart.push_back(total);
+
+	const vector<BuildEntry>& itemEntries = levels[0];
+	for (size_t i=0; i<order.size(); ++i)
+	{
+		const BuildEntry& e = itemEntries[order[i]];
+		appendBounds(e, bounds);
+		items.push_back(entries[e.first].second);
+	}
+}
+
+FrozenSTRtree::FrozenSTRtree(STRtree& tree)
+	:
+	firstItem(0),
+	maxPending(0)
+{
+	tree.ensureBuilt();
+	AbstractNode* root = tree.getRoot();
+	if ( root->getChildBoundables()->empty() )
+	{
+		childStart.push_back(0);
+		return;
+	}
+
+	// Number the entries breadth-first. All items are at the
+	// same depth, so they come after all nodes.
+	vector<const Boundable*> entries;
+	entries.push_back(root);
+	size_t maxChildren = 0;
+	for (size_t i=0; i<entries.size(); ++i)
+	{
+		const AbstractNode* node =
+			dynamic_cast<const AbstractNode*>(entries[i]);
+		if ( ! node )
+		{
+			if ( ! firstItem ) firstItem = i;
+			items.push_back(
+				static_cast<const ItemBoundable*>(entries[i])->getItem());
+			continue;
+		}
+		assert(items.empty());
+
+		const BoundableList& children = *(node->getChildBoundables());
+		childStart.push_back(entries.size());
+		entries.insert(entries.end(), children.begin(), children.end());
+		if ( children.size() > maxChildren ) maxChildren = children.size();
+	}
+	childStart.push_back(entries.size());
+
+	// Each node level adds at most maxChildren-1 pending nodes
+	size_t numLevels = root->getLevel() + 1;
+	maxPending = numLevels * (maxChildren - 1) + 1;
+
+	// STRtree leaves out items with a null envelope,
+	// so no entry has one
+	bounds.reserve(4 * entries.size());
+	for (size_t i=0; i<entries.size(); ++i)
+	{
+		const Envelope* env =
+			static_cast<const Envelope*>(entries[i]->getBounds());
+		assert(env && ! env->isNull());
+		bounds.push_back(env->getMinX());
+		bounds.push_back(env->getMinY());
+		bounds.push_back(env->getMaxX());
+		bounds.push_back(env->getMaxY());
+	}
+}
+
+/*public*/
+size_t
+FrozenSTRtree::getMemorySize() const
+{
+	return sizeof(*this) +
+	       bounds.capacity() * sizeof(double) +
+	       childStart.capacity() * sizeof(size_t) +
+	       items.capacity() * sizeof(void*);
+}
+
+/*public*/
+void
+FrozenSTRtree::query(const Envelope *searchEnv, vector<void*>& matches) const
+{
+	MatchesCollector visit(matches);
+	query(*searchEnv, visit);
+}
+
+/*public*/
+void
+FrozenSTRtree::query(const Envelope *searchEnv, ItemVisitor& visitor) const
+{
+	VisitorCaller visit(visitor);
+	query(*searchEnv, visit);
+}
+
+/*private*/
+template <class Visit>
+void
+FrozenSTRtree::query(const Envelope& searchEnv, Visit& visit) const
+{
+	if ( ! firstItem || searchEnv.isNull() ) return;
+
+	const double qMinX = searchEnv.getMinX();
+	const double qMinY = searchEnv.getMinY();
+	const double qMaxX = searchEnv.getMaxX();
+	const double qMaxY = searchEnv.getMaxY();
+
+	const double* b = &bounds[0];
+	const size_t* start = &childStart[0];
+
+	size_t localPending[LOCAL_PENDING];
+	vector<size_t> heapPending;
+	size_t* pending = localPending;
+	if ( maxPending > LOCAL_PENDING )
+	{
+		heapPending.resize(maxPending);
+		pending = &heapPending[0];
+	}
+
+	size_t nPending = 0;
+	if ( intersects(b, qMinX, qMinY, qMaxX, qMaxY) ) pending[nPending++] = 0;
+
+	while ( nPending )
+	{
+		size_t node = pending[--nPending];
+		size_t first = start[node];
+		size_t end = start[node+1];
+
+		if ( first >= firstItem )
+		{
+			for (size_t i=first; i<end; ++i)
+			{
+				if ( intersects(b + 4*i, qMinX, qMinY, qMaxX, qMaxY) )
+					visit(items[i - firstItem]);
+			}
+		}
+		else
+		{
+			// pushed last to first, so that they are popped in order
+			for (size_t i=end; i-- > first; )
+			{
+				if ( intersects(b + 4*i, qMinX, qMinY, qMaxX, qMaxY) )
+					pending[nPending++] = i;
+			}
+		}
+	}
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -0,0 +1,149 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/HilbertPackedRtree.h>
+#include <geos/index/strtree/Boundable.h>
+#include <geos/geom/Envelope.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+/// The side of the grid the centres are mapped to
+const unsigned int GRID_SIZE = 65536;
+
+typedef pair<unsigned int, Boundable*> KeyedBoundable;
+
+bool
+lessKey(const KeyedBoundable& a, const KeyedBoundable& b)
+{
+	return a.first < b.first;
+}
+
+/// The cell of the grid over [min, min+width] containing v
+unsigned int
+gridCell(double v, double min, double width)
+{
+	if ( width <= 0 ) return 0;
+	double cell = (v - min) / width * (GRID_SIZE - 1);
+	if ( cell <= 0 ) return 0;
+	if ( cell >= GRID_SIZE - 1 ) return GRID_SIZE - 1;
+	return static_cast<unsigned int>(cell);
+}
+
+} // anonymous namespace
+
+/*public*/
+HilbertPackedRtree::HilbertPackedRtree(size_t nodeCapacity)
+	:
+	STRtree(nodeCapacity)
+{
+}
+
+/*public*/
+HilbertPackedRtree::~HilbertPackedRtree()
+{
+}
+
+/*public static*/
+unsigned int
+HilbertPackedRtree::hilbertIndex(unsigned int x, unsigned int y)
+{
+	assert(x < GRID_SIZE && y < GRID_SIZE);
+	unsigned int d = 0;
+	for (unsigned int s = GRID_SIZE / 2; s > 0; s /= 2)
+	{
+		unsigned int rx = (x & s) ? 1 : 0;
+		unsigned int ry = (y & s) ? 1 : 0;
+		d += s * s * ((3 * rx) ^ ry);
+
+		// rotate the quadrant, so the curve inside it
+		// starts and ends where the next level expects
+		if ( ry == 0 )
+		{
+			if ( rx == 1 )
+			{
+				x = GRID_SIZE - 1 - x;
+				y = GRID_SIZE - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+/*public static*/
+unsigned int
+HilbertPackedRtree::hilbertIndex(const Envelope& env, const Envelope& extent)
+{
+	unsigned int x = gridCell(centreX(&env), extent.getMinX(),
+	                          extent.getWidth());
+	unsigned int y = gridCell(centreY(&env), extent.getMinY(),
+	                          extent.getHeight());
+	return hilbertIndex(x, y);
+}
+
+/*private*/
+std::auto_ptr<BoundableList>
+HilbertPackedRtree::createParentBoundables(BoundableList* childBoundables,
+		int newLevel)
+{
+	// The sorted children are grouped in runs of nodeCapacity
+	return AbstractSTRtree::createParentBoundables(childBoundables, newLevel);
+}
+
+/*private*/
+std::auto_ptr<BoundableList>
+HilbertPackedRtree::sortBoundables(const BoundableList* input)
+{
+	assert(input);
+	assert(!input->empty());
+
+	Envelope extent;
+	for (BoundableList::const_iterator i=input->begin(), e=input->end();
+			i!=e; ++i)
+	{
+		extent.expandToInclude(
+			static_cast<const Envelope*>((*i)->getBounds()));
+	}
+
+	vector<KeyedBoundable> keyed;
+	keyed.reserve(input->size());
+	for (BoundableList::const_iterator i=input->begin(), e=input->end();
+			i!=e; ++i)
+	{
+		const Envelope* env = static_cast<const Envelope*>((*i)->getBounds());
+		keyed.push_back(KeyedBoundable(hilbertIndex(*env, extent), *i));
+	}
+	// stable, so equal keys keep the insertion order
+	stable_sort(keyed.begin(), keyed.end(), lessKey);
+
+	std::auto_ptr<BoundableList> output ( new BoundableList() );
+	output->reserve(keyed.size());
+	for (size_t i=0; i<keyed.size(); ++i)
+		output->push_back(keyed[i].second);
+	return output;
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
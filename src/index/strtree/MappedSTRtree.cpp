@@ -0,0 +1,355 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/MappedSTRtree.h>
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/io/ByteOrderValues.h>
+#include <geos/util/GEOSException.h>
+#include <geos/util/Machine.h> // for getMachineByteOrder
+#include <geos/geom/Envelope.h>
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cassert>
+#include <cstddef>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using geos::geom::Envelope;
+using geos::io::ByteOrderValues;
+using geos::util::GEOSException;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+const char MAGIC[8] = { 'G', 'E', 'O', 'S', 'S', 'T', 'R', 'T' };
+
+const size_t HEADER_SIZE = 32;
+
+const int FILE_BYTE_ORDER = ByteOrderValues::ENDIAN_LITTLE;
+
+/// Pending nodes of a query kept on the call stack, if there is room
+const size_t LOCAL_PENDING = 128;
+
+/// Bytes written at once
+const size_t WRITE_BUFFER_VALUES = 4096;
+
+void
+corrupt()
+{
+	throw GEOSException("MappedSTRtree: not a valid tree");
+}
+
+/// Buffers 64-bit values in little-endian order
+class ValueWriter
+{
+public:
+	ValueWriter(ostream& s) : os(s), n(0) {}
+
+	void putLong(int64 v)
+	{
+		ByteOrderValues::putLong(v, next(), FILE_BYTE_ORDER);
+	}
+
+	void putDouble(double v)
+	{
+		ByteOrderValues::putDouble(v, next(), FILE_BYTE_ORDER);
+	}
+
+	void flush()
+	{
+		os.write(reinterpret_cast<const char*>(buf), 8 * n);
+		n = 0;
+		if ( ! os ) throw GEOSException("MappedSTRtree: failed to write tree");
+	}
+
+private:
+	ostream& os;
+	unsigned char buf[8 * WRITE_BUFFER_VALUES];
+	size_t n;
+
+	unsigned char* next()
+	{
+		if ( n == WRITE_BUFFER_VALUES ) flush();
+		return buf + 8 * n++;
+	}
+};
+
+/// NaN bounds compare false, leaving them out
+inline bool
+intersects(const double* b, double minX, double minY,
+		double maxX, double maxY)
+{
+	return b[0] <= maxX && b[2] >= minX && b[1] <= maxY && b[3] >= minY;
+}
+
+} // anonymous namespace
+
+const int MappedSTRtree::VERSION;
+
+/*public static*/
+void
+MappedSTRtree::write(const FrozenSTRtree& tree, ItemIdentifier& itemIds,
+		ostream& os)
+{
+	unsigned char header[HEADER_SIZE];
+	memcpy(header, MAGIC, 8);
+	ByteOrderValues::putInt(VERSION, header + 8, FILE_BYTE_ORDER);
+	ByteOrderValues::putInt(0, header + 12, FILE_BYTE_ORDER);
+	ByteOrderValues::putLong(int64(tree.firstItem), header + 16, FILE_BYTE_ORDER);
+	ByteOrderValues::putLong(int64(tree.items.size()), header + 24,
+	                         FILE_BYTE_ORDER);
+	os.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+
+	ValueWriter out(os);
+	for (size_t i=0; i<tree.bounds.size(); ++i)
+		out.putDouble(tree.bounds[i]);
+	for (size_t i=0; i<tree.childStart.size(); ++i)
+		out.putLong(int64(tree.childStart[i]));
+	for (size_t i=0; i<tree.items.size(); ++i)
+		out.putLong(itemIds.getId(tree.items[i]));
+	out.flush();
+}
+
+/*public static*/
+void
+MappedSTRtree::write(const FrozenSTRtree& tree, ItemIdentifier& itemIds,
+		const string& filename)
+{
+	ofstream os(filename.c_str(), ios::out | ios::binary | ios::trunc);
+	if ( ! os ) throw GEOSException("MappedSTRtree: cannot create " + filename);
+	write(tree, itemIds, os);
+	os.close();
+	if ( ! os ) throw GEOSException("MappedSTRtree: failed to write " + filename);
+}
+
+MappedSTRtree::MappedSTRtree(const string& filename)
+	:
+	mapping(0),
+	mappingSize(0),
+	bounds(0),
+	childStart(0),
+	ids(0),
+	numNodes(0),
+	numItems(0),
+	maxPending(0)
+{
+	open(filename);
+}
+
+MappedSTRtree::MappedSTRtree(const void* data, size_t size)
+	:
+	mapping(0),
+	mappingSize(0),
+	bounds(0),
+	childStart(0),
+	ids(0),
+	numNodes(0),
+	numItems(0),
+	maxPending(0)
+{
+	attach(data, size, false);
+}
+
+MappedSTRtree::~MappedSTRtree()
+{
+#ifndef _WIN32
+	if ( mapping ) munmap(mapping, mappingSize);
+#endif
+}
+
+/*private*/
+void
+MappedSTRtree::open(const string& filename)
+{
+#ifndef _WIN32
+	if ( getMachineByteOrder() == FILE_BYTE_ORDER )
+	{
+		int fd = ::open(filename.c_str(), O_RDONLY);
+		if ( fd < 0 )
+			throw GEOSException("MappedSTRtree: cannot open " + filename);
+
+		struct stat st;
+		void* m = MAP_FAILED;
+		if ( fstat(fd, &st) == 0 && st.st_size > 0 )
+		{
+			m = mmap(0, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		}
+		::close(fd);
+
+		if ( m != MAP_FAILED )
+		{
+			mapping = m;
+			mappingSize = size_t(st.st_size);
+			attach(mapping, mappingSize, false);
+			return;
+		}
+	}
+#endif
+
+	ifstream is(filename.c_str(), ios::in | ios::binary);
+	if ( ! is ) throw GEOSException("MappedSTRtree: cannot open " + filename);
+	vector<char> data((istreambuf_iterator<char>(is)),
+	                  istreambuf_iterator<char>());
+	if ( is.bad() )
+		throw GEOSException("MappedSTRtree: failed to read " + filename);
+	attach(data.empty() ? 0 : &data[0], data.size(), true);
+}
+
+/*private*/
+void
+MappedSTRtree::attach(const void* data, size_t size, bool copy)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	if ( size < HEADER_SIZE || memcmp(p, MAGIC, 8) != 0 )
+		throw GEOSException("MappedSTRtree: not a tree file");
+	if ( ByteOrderValues::getInt(p + 8, FILE_BYTE_ORDER) != VERSION )
+		throw GEOSException("MappedSTRtree: unsupported version");
+
+	int64 nodes = ByteOrderValues::getLong(p + 16, FILE_BYTE_ORDER);
+	int64 items = ByteOrderValues::getLong(p + 24, FILE_BYTE_ORDER);
+	// bounding the counts first keeps the size below from overflowing
+	int64 maxValues = int64(size / 8);
+	if ( nodes < 0 || items < 0 || nodes > maxValues || items > maxValues ||
+	     ( nodes == 0 ) != ( items == 0 ) )
+		corrupt();
+	numNodes = size_t(nodes);
+	numItems = size_t(items);
+
+	size_t numBounds = 4 * (numNodes + numItems);
+	size_t numIndexes = numNodes + 1 + numItems;
+	if ( size != HEADER_SIZE + 8 * (numBounds + numIndexes) ) corrupt();
+
+	const unsigned char* b = p + HEADER_SIZE;
+	const unsigned char* c = b + 8 * numBounds;
+	bool aligned = reinterpret_cast<size_t>(p) % 8 == 0;
+
+	if ( copy || ! aligned || getMachineByteOrder() != FILE_BYTE_ORDER )
+	{
+		boundsCopy.resize(numBounds);
+		for (size_t i=0; i<numBounds; ++i)
+			boundsCopy[i] = ByteOrderValues::getDouble(b + 8 * i, FILE_BYTE_ORDER);
+		indexCopy.resize(numIndexes);
+		for (size_t i=0; i<numIndexes; ++i)
+			indexCopy[i] = ByteOrderValues::getLong(c + 8 * i, FILE_BYTE_ORDER);
+		bounds = boundsCopy.empty() ? 0 : &boundsCopy[0];
+		childStart = &indexCopy[0];
+	}
+	else
+	{
+		bounds = reinterpret_cast<const double*>(b);
+		childStart = reinterpret_cast<const int64*>(c);
+	}
+	ids = childStart + numNodes + 1;
+
+	// Each node must have its children after it, in a range following
+	// the one of the previous node, made either of nodes or of items
+	int64 numEntries = nodes + items;
+	if ( childStart[nodes] != numEntries ) corrupt();
+	if ( nodes && childStart[0] != 1 ) corrupt();
+	size_t maxChildren = 0;
+	for (int64 i=0; i<nodes; ++i)
+	{
+		int64 first = childStart[i];
+		int64 end = childStart[i+1];
+		if ( first <= i || end < first || ( first < nodes && end > nodes ) )
+			corrupt();
+		if ( size_t(end - first) > maxChildren )
+			maxChildren = size_t(end - first);
+	}
+
+	// All the leaves must be at the same depth, which bounds the
+	// stack of query: the children of each level follow the level,
+	// and are either all nodes or all items
+	size_t numLevels = 0;
+	for (int64 levelStart=0, levelEnd=(nodes ? 1 : 0);
+	     levelStart<nodes; ++numLevels)
+	{
+		int64 childrenStart = childStart[levelStart];
+		int64 childrenEnd = childStart[levelEnd];
+		if ( childrenStart < nodes && childrenEnd > nodes ) corrupt();
+		levelStart = childrenStart;
+		levelEnd = childrenEnd;
+	}
+	maxPending = maxChildren ? numLevels * (maxChildren - 1) + 1 : 1;
+}
+
+/*public*/
+void
+MappedSTRtree::query(const Envelope *searchEnv, vector<int64>& found) const
+{
+	if ( ! numNodes || searchEnv->isNull() ) return;
+
+	const double qMinX = searchEnv->getMinX();
+	const double qMinY = searchEnv->getMinY();
+	const double qMaxX = searchEnv->getMaxX();
+	const double qMaxY = searchEnv->getMaxY();
+	const size_t firstItem = numNodes;
+
+	size_t localPending[LOCAL_PENDING];
+	vector<size_t> heapPending;
+	size_t* pending = localPending;
+	if ( maxPending > LOCAL_PENDING )
+	{
+		heapPending.resize(maxPending);
+		pending = &heapPending[0];
+	}
+
+	size_t nPending = 0;
+	if ( intersects(bounds, qMinX, qMinY, qMaxX, qMaxY) )
+		pending[nPending++] = 0;
+
+	while ( nPending )
+	{
+		size_t node = pending[--nPending];
+		size_t first = size_t(childStart[node]);
+		size_t end = size_t(childStart[node+1]);
+
+		if ( first >= firstItem )
+		{
+			for (size_t i=first; i<end; ++i)
+			{
+				if ( intersects(bounds + 4*i, qMinX, qMinY, qMaxX, qMaxY) )
+					found.push_back(ids[i - firstItem]);
+			}
+		}
+		else
+		{
+			// attach checked that the leaves are at the same depth
+			assert(nPending + (end - first) <= maxPending);
+
+			// pushed last to first, so that they are popped in order
+			for (size_t i=end; i-- > first; )
+			{
+				if ( intersects(bounds + 4*i, qMinX, qMinY, qMaxX, qMaxY) )
+					pending[nPending++] = i;
+			}
+		}
+	}
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -18,9 +18,20 @@
  **********************************************************************/
 
 #include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/strtree/ItemPairVisitor.h>
+#include <geos/index/strtree/BatchQueryVisitor.h>
+#include <geos/index/strtree/HilbertPackedRtree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/index/QueryStatistics.h>
 #include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/IllegalStateException.h>
 
 #include <vector>
+#include <queue>
+#include <utility>
 #include <cassert>
 #include <cmath>
 #include <algorithm> // std::sort
@@ -87,6 +98,20 @@ static bool yComparator(Boundable *a, Boundable *b)
                                            STRtree::centreY(bEnv));
 }
 
+static bool xComparator(Boundable *a, Boundable *b)
+{
+	assert(a);
+	assert(b);
+	const Envelope* aEnv = static_cast<const Envelope*>(a->getBounds());
+	const Envelope* bEnv = static_cast<const Envelope*>(b->getBounds());
+	assert(aEnv);
+	assert(bEnv);
+
+	// See yComparator
+	return AbstractSTRtree::compareDoubles(STRtree::centreX(aEnv),
+	                                       STRtree::centreX(bEnv));
+}
+
 /*public*/
 STRtree::STRtree(size_t nodeCapacity): AbstractSTRtree(nodeCapacity)
 { 
@@ -110,7 +135,10 @@ STRtree::createParentBoundables(BoundableList* childBoundables, int newLevel)
 	assert(!childBoundables->empty());
 	int minLeafCount=(int) ceil((double)childBoundables->size()/(double)getNodeCapacity());
 
-	std::auto_ptr<BoundableList> sortedChildBoundables ( sortBoundables(childBoundables) );
+	// The slices are cut in the order of x, then each one is
+	// sorted by y (by sortBoundables) as its nodes are created
+	std::auto_ptr<BoundableList> sortedChildBoundables ( new BoundableList(*childBoundables) );
+	sort(sortedChildBoundables->begin(), sortedChildBoundables->end(), xComparator);
 
 	std::auto_ptr< vector<BoundableList*> > verticalSlicesV (
 			verticalSlices(sortedChildBoundables.get(), (int)ceil(sqrt((double)minLeafCount)))
@@ -162,21 +190,29 @@ STRtree::createParentBoundablesFromVerticalSlice(BoundableList* childBoundables,
 std::vector<BoundableList*>*
 STRtree::verticalSlices(BoundableList* childBoundables, size_t sliceCount)
 {
-	size_t sliceCapacity = (size_t) ceil((double)childBoundables->size() / (double) sliceCount);
-	vector<BoundableList*>* slices = new vector<BoundableList*>(sliceCount);
-
 	size_t i=0, nchilds=childBoundables->size();
 
-	for (size_t j=0; j<sliceCount; j++)
+	// the slices hold whole nodes, so that only the last node
+	// of the last slice may be partly filled
+	size_t nodeCapacity = getNodeCapacity();
+	size_t minLeafCount = (nchilds + nodeCapacity - 1) / nodeCapacity;
+	size_t sliceCapacity = nodeCapacity *
+		((minLeafCount + sliceCount - 1) / sliceCount);
+
+	vector<BoundableList*>* slices = new vector<BoundableList*>();
+	slices->reserve(sliceCount);
+
+	while (i<nchilds)
 	{
-		(*slices)[j]=new BoundableList(); 
-		(*slices)[j]->reserve(sliceCapacity); 
+		BoundableList* slice = new BoundableList();
+		slices->push_back(slice);
+		slice->reserve(sliceCapacity);
 		size_t boundablesAddedToSlice = 0;
 		while (i<nchilds && boundablesAddedToSlice<sliceCapacity)
 		{
 			Boundable *childBoundable=(*childBoundables)[i];
 			++i;
-			(*slices)[j]->push_back(childBoundable);
+			slice->push_back(childBoundable);
 			++boundablesAddedToSlice;
 		}
 	}
@@ -248,6 +284,538 @@ STRtree::sortBoundables(const BoundableList* input)
 	return output;
 }
 
+namespace {
+
+const Envelope*
+envelopeOf(const Boundable* b)
+{
+	return static_cast<const Envelope*>(b->getBounds());
+}
+
+/*
+ * A boundable of the tree, with its distance to the query item:
+ * the exact distance for an item, a lower bound for a node.
+ * Entries are popped from a std::priority_queue nearest first.
+ */
+struct NearestEntry
+{
+	NearestEntry(double d, const Boundable* b, bool item)
+		: distance(d), boundable(b), isItem(item)
+	{}
+
+	bool operator<(const NearestEntry& other) const {
+		return distance > other.distance;
+	}
+
+	double distance;
+	const Boundable* boundable;
+	bool isItem;
+};
+
+/*
+ * A boundable of each tree, with their distance as for NearestEntry.
+ */
+struct NearestPairEntry
+{
+	NearestPairEntry(double d, const Boundable* nb1, bool item1,
+	                 const Boundable* nb2, bool item2)
+		: distance(d), b1(nb1), b2(nb2), isItem1(item1), isItem2(item2)
+	{}
+
+	bool operator<(const NearestPairEntry& other) const {
+		return distance > other.distance;
+	}
+
+	double distance;
+	const Boundable* b1;
+	const Boundable* b2;
+	bool isItem1;
+	bool isItem2;
+};
+
+/*
+ * A boundable of each tree, with intersecting envelopes.
+ */
+struct IntersectingPair
+{
+	IntersectingPair(const Boundable* nb1, bool item1,
+	                 const Boundable* nb2, bool item2)
+		: b1(nb1), b2(nb2), isItem1(item1), isItem2(item2)
+	{}
+
+	const Boundable* b1;
+	const Boundable* b2;
+	bool isItem1;
+	bool isItem2;
+};
+
+/*
+ * Appends to pairs the children of a node of the given pair,
+ * the larger one if both are nodes, paired with the other
+ * boundable when their envelopes intersect.
+ */
+void
+expandIntersectingPair(const IntersectingPair& pair,
+		vector<IntersectingPair>& pairs)
+{
+	bool expand1 = ! pair.isItem1 && ( pair.isItem2 ||
+		envelopeOf(pair.b1)->getArea() >= envelopeOf(pair.b2)->getArea() );
+	const AbstractNode* node = static_cast<const AbstractNode*>(
+		expand1 ? pair.b1 : pair.b2);
+	const Envelope* otherEnv = envelopeOf(expand1 ? pair.b2 : pair.b1);
+
+	const BoundableList& children = *(node->getChildBoundables());
+	for (BoundableList::const_iterator i=children.begin(),
+			e=children.end(); i!=e; ++i)
+	{
+		const Boundable* child = *i;
+		if ( ! envelopeOf(child)->intersects(otherEnv) ) continue;
+
+		bool isItem = dynamic_cast<const ItemBoundable*>(child) != 0;
+		if ( expand1 )
+			pairs.push_back(IntersectingPair(child, isItem,
+			                                 pair.b2, pair.isItem2));
+		else
+			pairs.push_back(IntersectingPair(pair.b1, pair.isItem1,
+			                                 child, isItem));
+	}
+}
+
+/*
+ * Visits the items of a subtree whose envelopes intersect searchEnv,
+ * only reading the nodes and their bounds, and counts the work done
+ * in stats.
+ */
+template <class Stats>
+void
+queryNode(const AbstractNode& node, const Envelope* searchEnv,
+		ItemVisitor& visitor, Stats& stats)
+{
+	stats.visitNode();
+	if ( node.getLevel() == 0 ) stats.testLeaf();
+
+	const BoundableList& children = *(node.getChildBoundables());
+	for (BoundableList::const_iterator i=children.begin(),
+			e=children.end(); i!=e; ++i)
+	{
+		const Boundable* child = *i;
+		if ( ! envelopeOf(child)->intersects(searchEnv) ) continue;
+
+		if (const ItemBoundable* ib =
+				dynamic_cast<const ItemBoundable*>(child))
+		{
+			visitor.visitItem(ib->getItem());
+			stats.returnItems(1);
+		}
+		else
+		{
+			queryNode(*static_cast<const AbstractNode*>(child),
+			          searchEnv, visitor, stats);
+		}
+	}
+}
+
+/// The number of queries walking the tree together in queryMany
+const size_t QUERY_GROUP_SIZE = 64;
+
+/*
+ * Visits the items of a subtree intersecting the active queries,
+ * which intersect the node. scratch holds, for each depth below
+ * the node, the queries intersecting the child being visited.
+ */
+void
+queryNodeMany(const AbstractNode& node, const vector<size_t>& active,
+		const Envelope* searchEnvs, BatchQueryVisitor& visitor,
+		vector< vector<size_t> >& scratch, size_t depth)
+{
+	vector<size_t>& childActive = scratch[depth];
+	const BoundableList& children = *(node.getChildBoundables());
+	for (BoundableList::const_iterator i=children.begin(),
+			e=children.end(); i!=e; ++i)
+	{
+		const Boundable* child = *i;
+		const Envelope* childEnv = envelopeOf(child);
+		childActive.clear();
+		for (size_t q=0; q<active.size(); ++q)
+		{
+			if ( searchEnvs[active[q]].intersects(childEnv) )
+				childActive.push_back(active[q]);
+		}
+		if ( childActive.empty() ) continue;
+
+		if (const ItemBoundable* ib =
+				dynamic_cast<const ItemBoundable*>(child))
+		{
+			for (size_t q=0; q<childActive.size(); ++q)
+				visitor.visitItem(childActive[q], ib->getItem());
+		}
+		else
+		{
+			queryNodeMany(*static_cast<const AbstractNode*>(child),
+			              childActive, searchEnvs, visitor,
+			              scratch, depth + 1);
+		}
+	}
+}
+
+typedef pair<unsigned int, size_t> KeyedQuery;
+
+bool
+lessKey(const KeyedQuery& a, const KeyedQuery& b)
+{
+	return a.first < b.first;
+}
+
+class MatchesCollector : public ItemVisitor {
+public:
+	MatchesCollector(vector<void*>& m) : matches(m) {}
+	void visitItem(void* item) { matches.push_back(item); }
+private:
+	vector<void*>& matches;
+};
+
+} // anonymous namespace
+
+/*public*/
+void
+STRtree::query(const Envelope* searchEnv, vector<void*>& matches) const
+{
+	MatchesCollector collector(matches);
+	query(searchEnv, collector);
+}
+
+/*public*/
+void
+STRtree::query(const Envelope* searchEnv, ItemVisitor& visitor) const
+{
+	NoQueryStatistics stats;
+	queryTree(searchEnv, visitor, stats);
+}
+
+/*public*/
+void
+STRtree::query(const Envelope* searchEnv, ItemVisitor& visitor,
+               QueryStatistics& stats) const
+{
+	queryTree(searchEnv, visitor, stats);
+}
+
+/*private*/
+template <class Stats>
+void
+STRtree::queryTree(const Envelope* searchEnv, ItemVisitor& visitor,
+                   Stats& stats) const
+{
+	if ( ! isBuilt() )
+	{
+		throw util::IllegalStateException(
+			"STRtree must be built before a const query");
+	}
+
+	// the bounds of an empty root are not cached
+	if ( root->getChildBoundables()->empty() ) return;
+
+	if ( envelopeOf(root)->intersects(searchEnv) )
+		queryNode(*root, searchEnv, visitor, stats);
+}
+
+/*public*/
+IndexStatistics
+STRtree::getStatistics()
+{
+	ensureBuilt();
+
+	IndexStatistics stats;
+	size_t numChildren = 0;
+	vector<const AbstractNode*> level(1, root);
+	vector<const AbstractNode*> nextLevel;
+	while ( ! level.empty() )
+	{
+		++stats.depth;
+		nextLevel.clear();
+		for (size_t n=0; n<level.size(); ++n)
+		{
+			const BoundableList& children = *(level[n]->getChildBoundables());
+			++stats.numNodes;
+			numChildren += children.size();
+			stats.memorySize += sizeof(STRAbstractNode)
+				+ children.capacity() * sizeof(Boundable*);
+			if ( ! children.empty() ) stats.memorySize += sizeof(Envelope);
+
+			if ( level[n]->getLevel() == 0 )
+			{
+				stats.numItems += children.size();
+				stats.memorySize += children.size() * sizeof(ItemBoundable);
+				continue;
+			}
+
+			for (size_t i=0; i<children.size(); ++i)
+			{
+				nextLevel.push_back(
+					static_cast<const AbstractNode*>(children[i]));
+				const Envelope* env = envelopeOf(children[i]);
+				for (size_t j=0; j<i; ++j)
+				{
+					Envelope overlap;
+					if ( env->intersection(*envelopeOf(children[j]), overlap) )
+						stats.overlapArea += overlap.getArea();
+				}
+			}
+		}
+		level.swap(nextLevel);
+	}
+
+	// the list of the items, and of the nodes
+	stats.memorySize += stats.numItems * sizeof(Boundable*)
+		+ nodes->capacity() * sizeof(AbstractNode*);
+	stats.fillFactor = double(numChildren)
+		/ double(stats.numNodes * nodeCapacity);
+	return stats;
+}
+
+/*public*/
+void
+STRtree::nearestNeighbour(const Envelope* env, const void* item,
+		size_t k, ItemDistance& itemDist, vector<void*>& result)
+{
+	ensureBuilt();
+	const AbstractNode* node = getRoot();
+	if ( k == 0 || node->getChildBoundables()->empty() ) return;
+
+	ItemBoundable queryBoundable(env, const_cast<void*>(item));
+	priority_queue<NearestEntry> queue;
+	queue.push(NearestEntry(envelopeOf(node)->distance(env), node, false));
+
+	size_t found = 0;
+	while ( ! queue.empty() && found < k )
+	{
+		NearestEntry entry = queue.top();
+		queue.pop();
+
+		// no boundable left in the queue can be nearer
+		if ( entry.isItem )
+		{
+			const ItemBoundable* ib =
+				static_cast<const ItemBoundable*>(entry.boundable);
+			result.push_back(ib->getItem());
+			++found;
+			continue;
+		}
+
+		node = static_cast<const AbstractNode*>(entry.boundable);
+		const BoundableList& children = *(node->getChildBoundables());
+		for (BoundableList::const_iterator i=children.begin(),
+				e=children.end(); i!=e; ++i)
+		{
+			const Boundable* child = *i;
+			if (const ItemBoundable* ib =
+					dynamic_cast<const ItemBoundable*>(child))
+			{
+				double d = itemDist.distance(&queryBoundable, ib);
+				queue.push(NearestEntry(d, child, true));
+			}
+			else
+			{
+				double d = envelopeOf(child)->distance(env);
+				queue.push(NearestEntry(d, child, false));
+			}
+		}
+	}
+}
+
+/*public*/
+void
+STRtree::nearestNeighbour(STRtree& tree, size_t k, ItemDistance& itemDist,
+		vector< pair<void*, void*> >& result)
+{
+	ensureBuilt();
+	tree.ensureBuilt();
+	const AbstractNode* root1 = getRoot();
+	const AbstractNode* root2 = tree.getRoot();
+	if ( k == 0 || root1->getChildBoundables()->empty() ||
+	     root2->getChildBoundables()->empty() ) return;
+
+	priority_queue<NearestPairEntry> queue;
+	queue.push(NearestPairEntry(
+		envelopeOf(root1)->distance(envelopeOf(root2)),
+		root1, false, root2, false));
+
+	size_t found = 0;
+	while ( ! queue.empty() && found < k )
+	{
+		NearestPairEntry entry = queue.top();
+		queue.pop();
+
+		if ( entry.isItem1 && entry.isItem2 )
+		{
+			result.push_back(make_pair(
+				static_cast<const ItemBoundable*>(entry.b1)->getItem(),
+				static_cast<const ItemBoundable*>(entry.b2)->getItem()));
+			++found;
+			continue;
+		}
+
+		// expand a node, the larger one if both are
+		bool expand1 = ! entry.isItem1 && ( entry.isItem2 ||
+			envelopeOf(entry.b1)->getArea() >=
+			envelopeOf(entry.b2)->getArea() );
+		const AbstractNode* node = static_cast<const AbstractNode*>(
+			expand1 ? entry.b1 : entry.b2);
+
+		const BoundableList& children = *(node->getChildBoundables());
+		for (BoundableList::const_iterator i=children.begin(),
+				e=children.end(); i!=e; ++i)
+		{
+			const Boundable* child = *i;
+			bool isItem = dynamic_cast<const ItemBoundable*>(child) != 0;
+
+			const Boundable* b1 = expand1 ? child : entry.b1;
+			const Boundable* b2 = expand1 ? entry.b2 : child;
+			bool isItem1 = expand1 ? isItem : entry.isItem1;
+			bool isItem2 = expand1 ? entry.isItem2 : isItem;
+
+			double d;
+			if ( isItem1 && isItem2 )
+			{
+				d = itemDist.distance(
+					static_cast<const ItemBoundable*>(b1),
+					static_cast<const ItemBoundable*>(b2));
+			}
+			else
+			{
+				d = envelopeOf(b1)->distance(envelopeOf(b2));
+			}
+			queue.push(NearestPairEntry(d, b1, isItem1, b2, isItem2));
+		}
+	}
+}
+
+/*public*/
+void
+STRtree::intersectingPairs(STRtree& tree, ItemPairVisitor& visitor,
+		size_t part, size_t numParts)
+{
+	if ( part >= numParts )
+	{
+		throw util::IllegalArgumentException(
+			"STRtree::intersectingPairs: part must be less than numParts");
+	}
+
+	ensureBuilt();
+	tree.ensureBuilt();
+	const AbstractNode* root1 = getRoot();
+	const AbstractNode* root2 = tree.getRoot();
+	if ( root1->getChildBoundables()->empty() ||
+	     root2->getChildBoundables()->empty() ||
+	     ! envelopeOf(root1)->intersects(envelopeOf(root2)) ) return;
+
+	vector<IntersectingPair> stack;
+	stack.push_back(IntersectingPair(root1, false, root2, false));
+
+	if ( numParts > 1 )
+	{
+		// Expand the pairs breadth-first until there are enough
+		// of them to be dealt among the parts
+		size_t minPairs = 4 * numParts;
+		vector<IntersectingPair> next;
+		bool expanded = true;
+		while ( expanded && stack.size() < minPairs )
+		{
+			expanded = false;
+			next.clear();
+			for (size_t i=0; i<stack.size(); ++i)
+			{
+				if ( stack[i].isItem1 && stack[i].isItem2 )
+				{
+					next.push_back(stack[i]);
+					continue;
+				}
+				expandIntersectingPair(stack[i], next);
+				expanded = true;
+			}
+			stack.swap(next);
+		}
+
+		size_t n = 0;
+		for (size_t i=part; i<stack.size(); i+=numParts)
+			stack[n++] = stack[i];
+		stack.erase(stack.begin() + n, stack.end());
+	}
+
+	while ( ! stack.empty() )
+	{
+		IntersectingPair pair = stack.back();
+		stack.pop_back();
+
+		if ( pair.isItem1 && pair.isItem2 )
+		{
+			visitor.visitPair(
+				static_cast<const ItemBoundable*>(pair.b1)->getItem(),
+				static_cast<const ItemBoundable*>(pair.b2)->getItem());
+			continue;
+		}
+		expandIntersectingPair(pair, stack);
+	}
+}
+
+/*public*/
+void
+STRtree::queryMany(const Envelope* searchEnvs, size_t numEnvs,
+		BatchQueryVisitor& visitor, size_t part, size_t numParts)
+{
+	if ( part >= numParts )
+	{
+		throw util::IllegalArgumentException(
+			"STRtree::queryMany: part must be less than numParts");
+	}
+
+	ensureBuilt();
+	const AbstractNode* node = getRoot();
+	if ( node->getChildBoundables()->empty() ) return;
+	const Envelope* rootEnv = envelopeOf(node);
+
+	// Sort the queries which may find something along the curve
+	Envelope extent;
+	for (size_t i=0; i<numEnvs; ++i)
+	{
+		if ( searchEnvs[i].intersects(rootEnv) )
+			extent.expandToInclude(&searchEnvs[i]);
+	}
+	if ( extent.isNull() ) return;
+
+	vector<KeyedQuery> keyed;
+	for (size_t i=0; i<numEnvs; ++i)
+	{
+		const Envelope& env = searchEnvs[i];
+		if ( ! env.intersects(rootEnv) ) continue;
+		keyed.push_back(KeyedQuery(
+			HilbertPackedRtree::hilbertIndex(env, extent), i));
+	}
+	stable_sort(keyed.begin(), keyed.end(), lessKey);
+
+	// one list of active queries per level below the root
+	size_t depth = 0;
+	for (const Boundable* b = node; ; ++depth)
+	{
+		const AbstractNode* n = dynamic_cast<const AbstractNode*>(b);
+		if ( ! n || n->getChildBoundables()->empty() ) break;
+		b = n->getChildBoundables()->front();
+	}
+	vector< vector<size_t> > scratch(depth);
+
+	vector<size_t> group;
+	size_t numGroups = (keyed.size() + QUERY_GROUP_SIZE - 1) / QUERY_GROUP_SIZE;
+	for (size_t g=part; g<numGroups; g+=numParts)
+	{
+		size_t begin = g * QUERY_GROUP_SIZE;
+		size_t end = std::min(begin + QUERY_GROUP_SIZE, keyed.size());
+		group.clear();
+		for (size_t i=begin; i<end; ++i)
+			group.push_back(keyed[i].second);
+		queryNodeMany(*node, group, searchEnvs, visitor, scratch, 0);
+	}
+}
+
 } // namespace geos.index.strtree
 } // namespace geos.index
 } // namespace geos
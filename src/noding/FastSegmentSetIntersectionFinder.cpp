@@ -22,6 +22,10 @@
 #include <geos/noding/SegmentSetMutualIntersector.h>
 #include <geos/noding/MCIndexSegmentSetMutualIntersector.h>
 #include <geos/algorithm/LineIntersector.h>
+#include <geos/index/chain/MonotoneChain.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
 
 namespace geos {
 namespace noding { // geos::noding
@@ -73,6 +77,39 @@ intersects( noding::SegmentString::ConstVect * segStrings,
 	return intDetector->hasIntersection();
 }
 
+void
+FastSegmentSetIntersectionFinder::
+intersects( const noding::SegmentString::ConstVect & segStrings,
+			std::vector<bool> & results,
+			std::size_t part, std::size_t numParts)
+{
+	if ( part >= numParts )
+	{
+		throw util::IllegalArgumentException(
+			"FastSegmentSetIntersectionFinder::intersects: part must be less than numParts");
+	}
+
+	std::size_t n = segStrings.size();
+	std::size_t first = n * part / numParts;
+	std::size_t last = n * ( part + 1) / numParts;
+	results.assign( last - first, false);
+
+	// the shared one keeps the state of its last computation,
+	// so each call uses its own
+	LineIntersector li;
+	std::vector<index::chain::MonotoneChain *> chainBuf;
+	std::vector<void*> overlapBuf;
+
+	for ( std::size_t i = first; i < last; i++)
+	{
+		SegmentString * ss = const_cast<SegmentString *>( segStrings[ i ]);
+		SegmentIntersectionDetector intFinder( &li);
+
+		segSetMutInt->process( ss, intFinder, chainBuf, overlapBuf);
+		results[ i - first ] = intFinder.hasIntersection();
+	}
+}
+
 } // geos::noding
 } // geos
 
@@ -21,6 +21,7 @@
 #include <geos/noding/NodedSegmentString.h>
 #include <geos/index/chain/MonotoneChain.h> 
 #include <geos/index/chain/MonotoneChainBuilder.h> 
+#include <geos/algorithm/SegmentIntersectionBatch.h>
 
 #include <cassert>
 #include <functional>
@@ -62,6 +63,7 @@ MCIndexNoder::intersectChains()
 
 	SegmentOverlapAction overlapAction(*segInt);
 
+	vector<MonotoneChain*> overlapChains;
 	for (vector<MonotoneChain*>::iterator
 			i=monoChains.begin(), iEnd=monoChains.end();
 			i != iEnd;
@@ -70,14 +72,14 @@ MCIndexNoder::intersectChains()
 
 		MonotoneChain* queryChain = *i;
 		assert(queryChain);
-		vector<void*> overlapChains;
-		index.query(&(queryChain->getEnvelope()), overlapChains);
-		for (vector<void*>::iterator
+		overlapChains.clear();
+		index.query(queryChain->getEnvelope(), overlapChains);
+		for (vector<MonotoneChain*>::iterator
 			j=overlapChains.begin(), jEnd=overlapChains.end();
 			j != jEnd;
 			++j)
 		{
-			MonotoneChain* testChain = static_cast<MonotoneChain*>(*j);
+			MonotoneChain* testChain = *j;
 			assert(testChain);
 
 			/**
@@ -96,6 +98,8 @@ MCIndexNoder::intersectChains()
 
 		}
 	}
+
+	overlapAction.flush();
 }
 
 /*private*/
@@ -116,7 +120,7 @@ MCIndexNoder::add(SegmentString* segStr)
 		assert(mc);
 
 		mc->setId(idCounter++);
-		index.insert(&(mc->getEnvelope()), mc);
+		index.insert(mc->getEnvelope(), mc);
 
 		// MonotoneChain objects deletion delegated to destructor
 		monoChains.push_back(mc);
@@ -134,6 +138,23 @@ MCIndexNoder::~MCIndexNoder()
 	}
 }
 
+MCIndexNoder::SegmentOverlapAction::SegmentOverlapAction(
+		SegmentIntersector& newSi)
+	:
+	index::chain::MonotoneChainOverlapAction(),
+	si(newSi)
+{
+	if ( si.ignoresDisjointSegments() )
+	{
+		batch.reset(new algorithm::SegmentIntersectionBatch());
+		pending.reserve(algorithm::SegmentIntersectionBatch::CAPACITY);
+	}
+}
+
+MCIndexNoder::SegmentOverlapAction::~SegmentOverlapAction()
+{
+}
+
 void
 MCIndexNoder::SegmentOverlapAction::overlap(MonotoneChain& mc1, size_t start1,
 		MonotoneChain& mc2, size_t start2)
@@ -148,7 +169,35 @@ MCIndexNoder::SegmentOverlapAction::overlap(MonotoneChain& mc1, size_t start1,
 		);
 	assert(ss2);
 
-	si.processIntersections(ss1, start1, ss2, start2);
+	if ( ! batch.get() )
+	{
+		si.processIntersections(ss1, start1, ss2, start2);
+		return;
+	}
+
+	batch->add(ss1->getCoordinate(start1), ss1->getCoordinate(start1+1),
+	           ss2->getCoordinate(start2), ss2->getCoordinate(start2+1));
+	SegmentPair pair = { ss1, start1, ss2, start2 };
+	pending.push_back(pair);
+	if ( batch->isFull() ) flush();
+}
+
+void
+MCIndexNoder::SegmentOverlapAction::flush()
+{
+	if ( ! batch.get() || batch->isEmpty() ) return;
+
+	for (size_t i=0, n=batch->filter(); i<n; ++i)
+	{
+		// short-circuit if possible
+		if (si.isDone()) break;
+		const SegmentPair& pair = pending[batch->getCandidate(i)];
+		si.processIntersections(pair.ss1, pair.start1,
+		                        pair.ss2, pair.start2);
+	}
+
+	batch->clear();
+	pending.clear();
 }
 
 
@@ -27,12 +27,39 @@
 #include <geos/index/strtree/STRtree.h>
 // std
 #include <cstddef>
+#include <cassert>
 
 using namespace geos::index::chain;
 
 namespace geos {
 namespace noding { // geos::noding
 
+namespace {
+
+/// Deletes the chains of a vector and empties it when going out of
+/// scope, whether or not an exception is thrown
+class ChainsReleaser
+{
+public:
+    ChainsReleaser(std::vector<MonotoneChain*>& chains) : chains(chains) {}
+
+    ~ChainsReleaser()
+    {
+        for (std::size_t i = 0, n = chains.size(); i < n; ++i)
+            delete chains[i];
+        chains.clear();
+    }
+
+private:
+    std::vector<MonotoneChain*>& chains;
+
+    // Declare type as noncopyable
+    ChainsReleaser(const ChainsReleaser& other);
+    ChainsReleaser& operator=(const ChainsReleaser& rhs);
+};
+
+} // anonymous namespace
+
 /*private*/
 void 
 MCIndexSegmentSetMutualIntersector::addToIndex(SegmentString* segStr)
@@ -157,6 +184,38 @@ MCIndexSegmentSetMutualIntersector::process(SegmentString::ConstVect * segString
     intersectChains();
 }
 
+/*public*/
+void
+MCIndexSegmentSetMutualIntersector::process(SegmentString* segStr,
+    SegmentIntersector& si, MonoChains& chainBuf,
+    std::vector<void*>& overlapBuf)
+{
+    assert(chainBuf.empty());
+
+    ChainsReleaser releaser(chainBuf);
+    MonotoneChainBuilder::getChains(segStr->getCoordinates(),
+                                    segStr, chainBuf);
+
+    MCIndexSegmentSetMutualIntersector::SegmentOverlapAction overlapAction(si);
+
+    for (MonoChains::size_type i = 0, ni = chainBuf.size();
+         i < ni && ! si.isDone(); ++i)
+    {
+        MonotoneChain * queryChain = chainBuf[i];
+
+        overlapBuf.clear();
+        index->query( &(queryChain->getEnvelope()), overlapBuf);
+
+        for (std::size_t j = 0, nj = overlapBuf.size(); j < nj; j++)
+        {
+            MonotoneChain * testChain = (MonotoneChain *)(overlapBuf[j]);
+
+            queryChain->computeOverlaps( testChain, &overlapAction);
+            if (si.isDone())
+                break;
+        }
+    }
+}
 
 /* public */
 void 
@@ -99,6 +99,17 @@ GeometryGraphOperation::getArgGeometry(unsigned int i) const
 	return arg[i]->getGeometry();
 }
 
+/*public*/
+void
+GeometryGraphOperation::setEdgeSetIntersectorType(
+		GeometryGraph::EdgeSetIntersectorType type)
+{
+	for(unsigned int i=0; i<arg.size(); ++i)
+	{
+		arg[i]->setEdgeSetIntersectorType(type);
+	}
+}
+
 /*protected*/
 void
 GeometryGraphOperation::setComputationPrecision(const PrecisionModel* pm)
@@ -35,8 +35,10 @@
 #include <geos/geom/util/LinearComponentExtracter.h>
 #include <geos/geom/util/PointExtracter.h>
 #include <geos/util/IllegalArgumentException.h>
+#include <geos/index/strtree/TemplateSTRtree.h>
 
 #include <vector>
+#include <memory>
 #include <iostream>
 
 #ifndef GEOS_DEBUG
@@ -54,6 +56,117 @@ namespace distance { // geos.operation.distance
 using namespace geom;
 //using namespace geom::util;
 
+namespace {
+
+/// Below this number of pairs of segments, they are all compared
+const size_t MAX_BRUTE_FORCE_PAIRS = 1000;
+
+/// A segment of a line, or a point, as a zero-length segment
+struct Facet
+{
+	Facet(const Geometry* g, int i, const Coordinate& c0,
+	      const Coordinate& c1)
+		: component(g), segIndex(i), p0(c0), p1(c1)
+	{}
+
+	bool isPoint() const { return segIndex < 0; }
+
+	const Geometry* component;
+
+	/// -1 for a point
+	int segIndex;
+
+	Coordinate p0;
+	Coordinate p1;
+};
+
+typedef index::strtree::TemplateSTRtree<Facet> FacetTree;
+
+struct FacetDistance
+{
+	double boundsDistance(const Envelope& env0, const Envelope& env1) const
+	{
+		return env0.distance(&env1);
+	}
+
+	double itemDistance(const Facet& f0, const Facet& f1) const
+	{
+		return algorithm::CGAlgorithms::distanceLineLine(f0.p0, f0.p1,
+		                                                 f1.p0, f1.p1);
+	}
+};
+
+size_t
+countFacets(const LineString::ConstVect& lines, const Point::ConstVect& points)
+{
+	size_t n = points.size();
+	for (size_t i=0, ni=lines.size(); i<ni; ++i)
+	{
+		size_t npts = lines[i]->getNumPoints();
+		if ( npts > 1 ) n += npts - 1;
+	}
+	return n;
+}
+
+/// Adds to tree the facets whose envelopes intersect searchEnv
+void
+addFacets(const LineString::ConstVect& lines, const Point::ConstVect& points,
+          const Envelope& searchEnv, FacetTree& tree)
+{
+	for (size_t i=0, ni=lines.size(); i<ni; ++i)
+	{
+		const CoordinateSequence *coord = lines[i]->getCoordinatesRO();
+		for (size_t j=1, nj=coord->getSize(); j<nj; ++j)
+		{
+			const Coordinate& p0 = coord->getAt(j - 1);
+			const Coordinate& p1 = coord->getAt(j);
+			Envelope env(p0, p1);
+			if ( searchEnv.intersects(env) )
+				tree.insert(env, Facet(lines[i], int(j - 1), p0, p1));
+		}
+	}
+	for (size_t i=0, ni=points.size(); i<ni; ++i)
+	{
+		const Coordinate *p = points[i]->getCoordinate();
+		if ( p && searchEnv.intersects(*p) )
+			tree.insert(Envelope(*p), Facet(points[i], -1, *p, *p));
+	}
+}
+
+/// Sets locGeom to the nearest locations on f0 and f1
+void
+setNearestLocations(const Facet& f0, const Facet& f1,
+                    vector<GeometryLocation*>& locGeom)
+{
+	Coordinate c0 = f0.p0;
+	Coordinate c1 = f1.p0;
+	if ( ! f0.isPoint() && ! f1.isPoint() )
+	{
+		LineSegment seg0(f0.p0, f0.p1);
+		LineSegment seg1(f1.p0, f1.p1);
+		std::auto_ptr<CoordinateSequence> closestPt(seg0.closestPoints(seg1));
+		c0 = closestPt->getAt(0);
+		c1 = closestPt->getAt(1);
+	}
+	else if ( ! f0.isPoint() )
+	{
+		LineSegment(f0.p0, f0.p1).closestPoint(f1.p0, c0);
+	}
+	else if ( ! f1.isPoint() )
+	{
+		LineSegment(f1.p0, f1.p1).closestPoint(f0.p0, c1);
+	}
+
+	delete locGeom[0];
+	locGeom[0] = new GeometryLocation(f0.component,
+	                                  f0.isPoint() ? 0 : f0.segIndex, c0);
+	delete locGeom[1];
+	locGeom[1] = new GeometryLocation(f1.component,
+	                                  f1.isPoint() ? 0 : f1.segIndex, c1);
+}
+
+} // anonymous namespace
+
 /*public static (deprecated)*/
 double
 DistanceOp::distance(const Geometry *g0, const Geometry *g1)
@@ -89,6 +202,7 @@ DistanceOp::nearestPoints(const Geometry *g0, const Geometry *g1)
 DistanceOp::DistanceOp(const Geometry *g0, const Geometry *g1):
 	geom(2),
 	terminateDistance(0.0),
+	withinTerminateDistanceOnly(false),
 	minDistanceLocation(0),
 	minDistance(DoubleMax)
 {
@@ -99,6 +213,7 @@ DistanceOp::DistanceOp(const Geometry *g0, const Geometry *g1):
 DistanceOp::DistanceOp(const Geometry& g0, const Geometry& g1):
 	geom(2),
 	terminateDistance(0.0),
+	withinTerminateDistanceOnly(false),
 	minDistanceLocation(0),
 	minDistance(DoubleMax)
 {
@@ -110,6 +225,7 @@ DistanceOp::DistanceOp(const Geometry& g0, const Geometry& g1, double tdist)
 	:
 	geom(2),
 	terminateDistance(tdist),
+	withinTerminateDistanceOnly(false),
 	minDistanceLocation(0),
 	minDistance(DoubleMax)
 {
@@ -413,6 +529,14 @@ DistanceOp::computeFacetDistance()
 	          << std::endl;
 #endif
 
+	if ( countFacets(lines0, pts0) * countFacets(lines1, pts1) >
+	     MAX_BRUTE_FORCE_PAIRS )
+	{
+		computeMinDistanceIndexed(lines0, pts0, lines1, pts1, locGeom);
+		updateMinDistance(locGeom, false);
+		return;
+	}
+
 	// exit whenever minDistance goes LE than terminateDistance
 	computeMinDistanceLines(lines0, lines1, locGeom);
 	updateMinDistance(locGeom, false);
@@ -473,6 +597,48 @@ DistanceOp::computeMinDistanceLines(
 	}
 }
 
+/*private*/
+void
+DistanceOp::computeMinDistanceIndexed(
+		const LineString::ConstVect& lines0,
+		const Point::ConstVect& points0,
+		const LineString::ConstVect& lines1,
+		const Point::ConstVect& points1,
+		vector<GeometryLocation*>& locGeom)
+{
+	// only the facets within the search distance of the envelope of
+	// the other geometry may be nearer
+	Envelope searchEnv0(*geom[1]->getEnvelopeInternal());
+	Envelope searchEnv1(*geom[0]->getEnvelopeInternal());
+	double searchDistance = getSearchDistance();
+	if ( searchDistance < DoubleMax )
+	{
+		searchEnv0.expandBy(searchDistance);
+		searchEnv1.expandBy(searchDistance);
+	}
+	else
+	{
+		searchEnv0 = searchEnv1 = Envelope(-DoubleInfinity, DoubleInfinity,
+		                                   -DoubleInfinity, DoubleInfinity);
+	}
+
+	FacetTree tree0;
+	FacetTree tree1;
+	addFacets(lines0, points0, searchEnv0, tree0);
+	addFacets(lines1, points1, searchEnv1, tree1);
+
+	// exit at the first pair within terminateDistance
+	FacetDistance metric;
+	double dist;
+	std::pair<const Facet*, const Facet*> nearest =
+		tree0.nearestPair(tree1, metric, dist, getSearchDistance(),
+		                  terminateDistance);
+	if ( ! nearest.first ) return;
+
+	minDistance = dist;
+	setNearestLocations(*nearest.first, *nearest.second, locGeom);
+}
+
 /*private*/
 void
 DistanceOp::computeMinDistancePoints(
@@ -541,7 +707,7 @@ DistanceOp::computeMinDistance(
 
 	const Envelope *env0=line0->getEnvelopeInternal();
 	const Envelope *env1=line1->getEnvelopeInternal();
-	if (env0->distance(env1)>minDistance) {
+	if (env0->distance(env1)>getSearchDistance()) {
 		return;
 	}
 
@@ -588,7 +754,7 @@ DistanceOp::computeMinDistance(const LineString *line,
 
 	const Envelope *env0=line->getEnvelopeInternal();
 	const Envelope *env1=pt->getEnvelopeInternal();
-	if (env0->distance(env1)>minDistance) {
+	if (env0->distance(env1)>getSearchDistance()) {
 		return;
 	}
 	const CoordinateSequence *coord0=line->getCoordinatesRO();
@@ -621,7 +787,15 @@ DistanceOp::isWithinDistance(const geom::Geometry& g0,
 	                     const geom::Geometry& g1,
 	                     double distance)
 {
+	// an empty geometry is within no distance of anything
+	if ( g0.isEmpty() || g1.isEmpty() ) return false;
+
+	const Envelope *env0 = g0.getEnvelopeInternal();
+	const Envelope *env1 = g1.getEnvelopeInternal();
+	if ( env0->distance(env1) > distance ) return false;
+
 	DistanceOp distOp(g0, g1, distance);
+	distOp.withinTerminateDistanceOnly = true;
 	return distOp.distance() <= distance;
 }
 
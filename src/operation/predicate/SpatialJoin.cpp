@@ -0,0 +1,184 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/predicate/SpatialJoin.h>
+#include <geos/index/strtree/ItemPairVisitor.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+using namespace geos::geom;
+using geos::geom::prep::PreparedGeometry;
+using geos::geom::prep::PreparedGeometryFactory;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace predicate { // geos.operation.predicate
+
+namespace {
+
+/*
+ * Tests predicate(prep, g), or predicate(g, prep) if converse.
+ */
+bool
+holds(SpatialJoin::Predicate predicate, const PreparedGeometry& prep,
+		const Geometry* g, bool converse)
+{
+	switch (predicate)
+	{
+		case SpatialJoin::INTERSECTS:
+			return prep.intersects(g);
+		case SpatialJoin::CONTAINS:
+			return converse ? prep.within(g) : prep.contains(g);
+		case SpatialJoin::COVERS:
+			return converse ? prep.coveredBy(g) : prep.covers(g);
+		case SpatialJoin::WITHIN:
+			return converse ? prep.contains(g) : prep.within(g);
+		case SpatialJoin::COVERED_BY:
+			return converse ? prep.covers(g) : prep.coveredBy(g);
+		case SpatialJoin::TOUCHES:
+			return prep.touches(g);
+		case SpatialJoin::CROSSES:
+			return prep.crosses(g);
+		case SpatialJoin::OVERLAPS:
+			return prep.overlaps(g);
+	}
+	throw util::IllegalArgumentException("SpatialJoin: unknown predicate");
+}
+
+/*
+ * Tests the candidate pairs of the trees, and passes on those
+ * satisfying the predicate. Prepared geometries are kept until
+ * the end of the join.
+ */
+class PairRefiner : public index::strtree::ItemPairVisitor {
+
+public:
+
+	PairRefiner(SpatialJoin::Predicate p,
+	            const vector<const Geometry*>& g1,
+	            const vector<const Geometry*>& g2,
+	            SpatialJoin::PairVisitor& v)
+		:
+		predicate(p),
+		geoms1(g1),
+		geoms2(g2),
+		visitor(v),
+		prepared1(g1.size(), 0),
+		prepared2(g2.size(), 0),
+		count(0)
+	{}
+
+	~PairRefiner()
+	{
+		destroy(prepared1);
+		destroy(prepared2);
+	}
+
+	void visitPair(void* item1, void* item2)
+	{
+		size_t i1 = static_cast<const Geometry**>(item1) - &geoms1[0];
+		size_t i2 = static_cast<const Geometry**>(item2) - &geoms2[0];
+		const Geometry* g1 = geoms1[i1];
+		const Geometry* g2 = geoms2[i2];
+
+		bool found;
+		if ( g1->getNumPoints() >= g2->getNumPoints() )
+			found = holds(predicate, prepared(prepared1, i1, g1), g2, false);
+		else
+			found = holds(predicate, prepared(prepared2, i2, g2), g1, true);
+
+		if ( found )
+		{
+			++count;
+			visitor.visitPair(i1, i2);
+		}
+	}
+
+	size_t getCount() const { return count; }
+
+private:
+
+	static const PreparedGeometry&
+	prepared(vector<const PreparedGeometry*>& cache, size_t i,
+	         const Geometry* g)
+	{
+		if ( ! cache[i] ) cache[i] = PreparedGeometryFactory::prepare(g);
+		return *cache[i];
+	}
+
+	static void destroy(vector<const PreparedGeometry*>& cache)
+	{
+		for (size_t i=0; i<cache.size(); ++i)
+			PreparedGeometryFactory::destroy(cache[i]);
+	}
+
+	SpatialJoin::Predicate predicate;
+	const vector<const Geometry*>& geoms1;
+	const vector<const Geometry*>& geoms2;
+	SpatialJoin::PairVisitor& visitor;
+	vector<const PreparedGeometry*> prepared1;
+	vector<const PreparedGeometry*> prepared2;
+	size_t count;
+
+	// Declare type as noncopyable
+	PairRefiner(const PairRefiner& other);
+	PairRefiner& operator=(const PairRefiner& rhs);
+};
+
+void
+insertGeometries(vector<const Geometry*>& geoms, index::strtree::STRtree& tree)
+{
+	for (size_t i=0; i<geoms.size(); ++i)
+	{
+		const Geometry* g = geoms[i];
+		if ( ! g || g->isEmpty() ) continue;
+		tree.insert(g->getEnvelopeInternal(), &geoms[i]);
+	}
+	tree.build();
+}
+
+} // anonymous namespace
+
+/*public*/
+SpatialJoin::SpatialJoin(const vector<const Geometry*>& g1,
+		const vector<const Geometry*>& g2)
+	:
+	geoms1(g1),
+	geoms2(g2)
+{
+	insertGeometries(geoms1, tree1);
+	insertGeometries(geoms2, tree2);
+}
+
+/*public*/
+size_t
+SpatialJoin::join(Predicate predicate, PairVisitor& visitor,
+		size_t part, size_t numParts)
+{
+	if ( predicate < INTERSECTS || predicate > OVERLAPS )
+		throw util::IllegalArgumentException("SpatialJoin: unknown predicate");
+
+	PairRefiner refiner(predicate, geoms1, geoms2, visitor);
+	tree1.intersectingPairs(tree2, refiner, part, numParts);
+	return refiner.getCount();
+}
+
+} // namespace geos.operation.predicate
+} // namespace geos.operation
+} // namespace geos
@@ -18,7 +18,7 @@
 
 #include <memory> // for auto_ptr
 #include <cassert> // for assert
-#include <algorithm> // for copy
+#include <algorithm> // for sort
 #include <geos/operation/union/PointGeometryUnion.h> 
 #include <geos/geom/Coordinate.h> 
 #include <geos/geom/Puntal.h> 
@@ -29,6 +29,7 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/util/GeometryCombiner.h>
 #include <geos/algorithm/PointLocator.h>
+#include <geos/index/kdtree/KdTree.h>
 
 namespace geos {
 namespace operation { // geos::operation
@@ -43,17 +44,22 @@ PointGeometryUnion::Union() const
   using geom::util::GeometryCombiner;
 
   PointLocator locater;
-  // use a set to eliminate duplicates, as required for union
-  std::set<Coordinate> exteriorCoords;
+  // collapse duplicates first, as required for union, so that
+  // each distinct point is located once
+  index::kdtree::KdTree uniquePoints;
+  std::vector<Coordinate> exteriorCoords;
 
   for (std::size_t i=0, n=pointGeom.getNumGeometries(); i<n; ++i) {
       const Point* point = dynamic_cast<const Point*>(pointGeom.getGeometryN(i));
       assert(point);
       const Coordinate* coord = point->getCoordinate();
+      if ( ! coord ) continue;
+      if ( uniquePoints.insert(*coord)->isRepeated() ) continue;
       int loc = locater.locate(*coord, &otherGeom);
       if (loc == Location::EXTERIOR)
-              exteriorCoords.insert(*coord);
+              exteriorCoords.push_back(*coord);
   }
+  std::sort(exteriorCoords.begin(), exteriorCoords.end());
 
   // if no points are in exterior, return the other geom
   if (exteriorCoords.empty())
@@ -63,13 +69,11 @@ PointGeometryUnion::Union() const
   std::auto_ptr<Geometry> ptComp;
 
   if (exteriorCoords.size() == 1) {
-    ptComp.reset( geomFact->createPoint(*(exteriorCoords.begin())) );
+    ptComp.reset( geomFact->createPoint(exteriorCoords[0]) );
   }
   else
   {
-    std::vector<Coordinate> coords(exteriorCoords.size());
-    std::copy(exteriorCoords.begin(), exteriorCoords.end(), coords.begin());
-    ptComp.reset( geomFact->createMultiPoint(coords) );
+    ptComp.reset( geomFact->createMultiPoint(exteriorCoords) );
   }
 
   // add point component to the other geometry
@@ -0,0 +1,259 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares the STR packing of STRtree with the Hilbert packing of
+ * HilbertPackedRtree: build time, window query time and the number
+ * of nodes whose envelope intersects the windows, over uniform,
+ * clustered and elongated (road-like) deterministic datasets.
+ *
+ * Usage: HilbertPackedRtreePerfTest [numItems [numQueries [nodeCapacity]]]
+ *
+ * Output is one CSV record per dataset and tree on stdout,
+ * preceded by a header.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/HilbertPackedRtree.h>
+#include <geos/index/strtree/AbstractNode.h>
+#include <geos/geom/Envelope.h>
+#include <geos/profiler.h>
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+
+using namespace geos::geom;
+using namespace geos::index::strtree;
+using namespace std;
+
+namespace {
+
+/*
+ * Linear congruential generator, so that workloads are identical
+ * across platforms and C library implementations.
+ */
+class Random
+{
+public:
+  Random(unsigned int seed) : state(seed) {}
+
+  /// @return a value in [0, 1)
+  double next()
+  {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0;
+  }
+
+  double next(double min, double max)
+  {
+    return min + next() * (max - min);
+  }
+
+private:
+  unsigned int state;
+};
+
+/// Squares of side up to 10, spread evenly
+void
+uniformEnvelopes(Random& rnd, size_t n, double side, vector<Envelope>& out)
+{
+  for (size_t i=0; i<n; ++i)
+  {
+    double x = rnd.next(0, side);
+    double y = rnd.next(0, side);
+    double size = rnd.next(0, 10);
+    out.push_back(Envelope(x, x + size, y, y + size));
+  }
+}
+
+/// Small squares in a few dense clusters, as buildings in towns
+void
+clusteredEnvelopes(Random& rnd, size_t n, double side, vector<Envelope>& out)
+{
+  const size_t numClusters = 50;
+  vector<double> cx, cy, spread;
+  for (size_t i=0; i<numClusters; ++i)
+  {
+    cx.push_back(rnd.next(0, side));
+    cy.push_back(rnd.next(0, side));
+    spread.push_back(rnd.next(0.005, 0.05) * side);
+  }
+  for (size_t i=0; i<n; ++i)
+  {
+    size_t c = size_t(rnd.next() * numClusters);
+    // roughly normal offsets
+    double dx = (rnd.next() + rnd.next() + rnd.next() - 1.5) * spread[c];
+    double dy = (rnd.next() + rnd.next() + rnd.next() - 1.5) * spread[c];
+    double size = rnd.next(0, 2);
+    out.push_back(Envelope(cx[c] + dx, cx[c] + dx + size,
+                           cy[c] + dy, cy[c] + dy + size));
+  }
+}
+
+/// Envelopes of segments up to 200 long, mostly near the axes, as roads
+void
+elongatedEnvelopes(Random& rnd, size_t n, double side, vector<Envelope>& out)
+{
+  const double pi = 3.14159265358979323846;
+  for (size_t i=0; i<n; ++i)
+  {
+    double x = rnd.next(0, side);
+    double y = rnd.next(0, side);
+    double length = rnd.next(10, 200);
+    double angle = rnd.next(-0.05, 0.05);
+    if ( rnd.next() < 0.5 ) angle += pi / 2;
+    double x1 = x + length * cos(angle);
+    double y1 = y + length * sin(angle);
+    out.push_back(Envelope(x, x1, y, y1));
+  }
+}
+
+/// Envelopes of the items, and query windows centred on items
+struct Workload
+{
+  Workload(const string& dataset, size_t nItems, size_t nQueries)
+  {
+    Random rnd(1);
+    double side = 10.0 * sqrt(double(nItems));
+    items.reserve(nItems);
+    if ( dataset == "uniform" ) uniformEnvelopes(rnd, nItems, side, items);
+    else if ( dataset == "clustered" )
+      clusteredEnvelopes(rnd, nItems, side, items);
+    else elongatedEnvelopes(rnd, nItems, side, items);
+
+    Random qrnd(2);
+    for (size_t i=0; i<nQueries; ++i)
+    {
+      const Envelope& e = items[size_t(qrnd.next() * nItems)];
+      double x = e.getMinX() + qrnd.next(-25, 0);
+      double y = e.getMinY() + qrnd.next(-25, 0);
+      windows.push_back(Envelope(x, x + 50, y, y + 50));
+    }
+  }
+
+  vector<Envelope> items;
+  vector<Envelope> windows;
+};
+
+/// Counts the nodes a query visits, with access to the root
+template <class Tree>
+class VisitCounter : public Tree
+{
+public:
+  VisitCounter(size_t nodeCapacity) : Tree(nodeCapacity) {}
+
+  size_t countVisits(const Envelope* env)
+  {
+    return countVisits(this->getRoot(), env);
+  }
+
+private:
+  size_t countVisits(const AbstractNode* node, const Envelope* env)
+  {
+    size_t count = 1;
+    const BoundableList& children = *(node->getChildBoundables());
+    for (size_t i=0; i<children.size(); ++i)
+    {
+      const AbstractNode* child =
+        dynamic_cast<const AbstractNode*>(children[i]);
+      if ( child && static_cast<const Envelope*>(
+             child->getBounds())->intersects(env) )
+      {
+        count += countVisits(child, env);
+      }
+    }
+    return count;
+  }
+};
+
+template <class Tree>
+void
+runCase(const string& dataset, const string& name, const Workload& w,
+        size_t nodeCapacity)
+{
+  size_t nItems = w.items.size();
+  geos::util::Profile build(name + " build");
+  geos::util::Profile queries(name + " query");
+
+  VisitCounter<Tree> tree(nodeCapacity);
+  build.start();
+  for (size_t i=0; i<nItems; ++i)
+    tree.insert(&w.items[i], const_cast<Envelope*>(&w.items[i]));
+  tree.build();
+  build.stop();
+
+  const Tree& builtTree = tree;
+  vector<void*> found;
+  size_t nFound = 0;
+  queries.start();
+  for (size_t i=0; i<w.windows.size(); ++i)
+  {
+    found.clear();
+    builtTree.query(&w.windows[i], found);
+    nFound += found.size();
+  }
+  queries.stop();
+
+  size_t visits = 0;
+  for (size_t i=0; i<w.windows.size(); ++i)
+    visits += tree.countVisits(&w.windows[i]);
+
+  double secs = queries.getTot() / 1000000.0;
+  size_t nQueries = w.windows.size();
+  cout << dataset << "," << name << "," << nItems << "," << nQueries << ","
+       << build.getTot() / 1000.0 << "," << queries.getTot() / 1000.0 << ","
+       << ( secs > 0 ? nQueries / secs : 0 ) << ","
+       << nFound << ","
+       << ( nQueries ? double(visits) / nQueries : 0 ) << endl;
+}
+
+const char* const datasets[] = {
+  "uniform",
+  "clustered",
+  "elongated",
+  0
+};
+
+} // anonymous namespace
+
+int
+main(int argc, char** argv)
+{
+  size_t nItems = 1000000;
+  size_t nQueries = 100000;
+  size_t nodeCapacity = 10;
+
+  if ( argc > 1 ) nItems = size_t(atol(argv[1]));
+  if ( argc > 2 ) nQueries = size_t(atol(argv[2]));
+  if ( argc > 3 ) nodeCapacity = size_t(atol(argv[3]));
+  if ( nItems == 0 || nodeCapacity < 2 )
+  {
+    cerr << "Usage: " << argv[0]
+         << " [numItems [numQueries [nodeCapacity]]]" << endl;
+    return 1;
+  }
+
+  cout << "dataset,tree,items,queries,build_millis,query_millis,"
+       << "queries_per_sec,found,node_visits_per_query" << endl;
+
+  for (const char* const* d = datasets; *d; ++d)
+  {
+    Workload w(*d, nItems, nQueries);
+    runCase<STRtree>(*d, "STRtree", w, nodeCapacity);
+    runCase<HilbertPackedRtree>(*d, "HilbertPackedRtree", w, nodeCapacity);
+  }
+
+  return 0;
+}
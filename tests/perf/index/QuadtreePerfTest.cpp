@@ -0,0 +1,152 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Times a Quadtree through rounds of building, querying and removing
+ * half of the items, over deterministically generated envelopes,
+ * as the indexes of the simplifier and of the snapping code are used.
+ *
+ * Usage: QuadtreePerfTest [numItems [numRounds]]
+ *
+ * Each round inserts the items in a new tree, runs two window queries
+ * per item, one with an ItemVisitor and one filling a vector, then
+ * removes every other item. Output is one CSV record per phase on
+ * stdout, preceded by a header, with the times summed over the rounds.
+ *
+ **********************************************************************/
+
+#include <geos/index/quadtree/Quadtree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/profiler.h>
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace geos::geom;
+using geos::index::quadtree::Quadtree;
+using namespace std;
+
+namespace {
+
+/*
+ * Linear congruential generator, so that workloads are identical
+ * across platforms and C library implementations.
+ */
+class Random
+{
+public:
+  Random(unsigned int seed) : state(seed) {}
+
+  /// @return a value in [0, 1)
+  double next()
+  {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0;
+  }
+
+  double next(double min, double max)
+  {
+    return min + next() * (max - min);
+  }
+
+private:
+  unsigned int state;
+};
+
+/// Counts the items visited
+struct CountingVisitor : public geos::index::ItemVisitor
+{
+  CountingVisitor() : count(0) {}
+  void visitItem(void*) { ++count; }
+  size_t count;
+};
+
+void
+report(const geos::util::Profile& prof, size_t nItems, size_t nRounds,
+       size_t count)
+{
+  cout << prof.name << "," << nItems << "," << nRounds << ","
+       << prof.getTot() / 1000.0 << "," << count << endl;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char** argv)
+{
+  size_t nItems = 2000;
+  size_t nRounds = 300;
+
+  if ( argc > 1 ) nItems = size_t(atol(argv[1]));
+  if ( argc > 2 ) nRounds = size_t(atol(argv[2]));
+
+  // square envelopes of side up to 5 over a 1000 x 1000 square,
+  // queried through windows 10 units larger on each side
+  vector<Envelope> items;
+  vector<Envelope> windows;
+  Random rnd(1);
+  items.reserve(nItems);
+  windows.reserve(nItems);
+  for (size_t i=0; i<nItems; ++i)
+  {
+    double x = rnd.next(0, 1000);
+    double y = rnd.next(0, 1000);
+    double size = rnd.next(0, 5);
+    items.push_back(Envelope(x, x + size, y, y + size));
+    windows.push_back(items.back());
+    windows.back().expandBy(10);
+  }
+
+  geos::util::Profile build("build");
+  geos::util::Profile query("query");
+  geos::util::Profile removal("remove");
+  size_t nFound = 0;
+  size_t nRemoved = 0;
+
+  for (size_t r=0; r<nRounds; ++r)
+  {
+    Quadtree tree;
+
+    build.start();
+    for (size_t i=0; i<nItems; ++i)
+      tree.insert(&items[i], &items[i]);
+    build.stop();
+
+    CountingVisitor visitor;
+    vector<void*> found;
+    query.start();
+    for (size_t i=0; i<nItems; ++i)
+    {
+      tree.query(&windows[i], visitor);
+      found.clear();
+      tree.query(&windows[i], found);
+      nFound += found.size();
+    }
+    query.stop();
+    nFound += visitor.count;
+
+    removal.start();
+    for (size_t i=0; i<nItems; i+=2)
+    {
+      if ( tree.remove(&items[i], &items[i]) ) ++nRemoved;
+    }
+    removal.stop();
+  }
+
+  cout << "phase,items,rounds,millis,count" << endl;
+  report(build, nItems, nRounds, nItems * nRounds);
+  report(query, nItems, nRounds, nFound);
+  report(removal, nItems, nRounds, nRemoved);
+
+  return 0;
+}
@@ -0,0 +1,324 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Times the building of STRtree, of its FrozenSTRtree copy, of a
+ * bulk-loaded FrozenSTRtree, the opening of a MappedSTRtree file and
+ * the insertion of the items one by one in an RStarTree, and window
+ * queries on each of them, over deterministically generated item
+ * and query envelopes. STRtree-batch runs all the queries of an
+ * STRtree in one call to queryMany.
+ *
+ * Usage: STRtreePerfTest [numItems [numQueries [index]]]
+ *
+ * Each index runs in a child process, so the reported peak resident
+ * set size, which includes the workload, belongs to that index only.
+ * Output is one CSV record per index on stdout, preceded by a header.
+ * The build time of the FrozenSTRtree copy is that of the copy only,
+ * and the one of MappedSTRtree that of opening its file, written to
+ * the current directory. The size of the index is left empty for
+ * STRtree, MappedSTRtree and RStarTree, which do not report it.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/MappedSTRtree.h>
+#include <geos/index/strtree/BatchQueryVisitor.h>
+#include <geos/index/rtree/RStarTree.h>
+#include <geos/geom/Envelope.h>
+#include <geos/profiler.h>
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace geos::geom;
+using namespace geos::index::strtree;
+using geos::index::rtree::RStarTree;
+using namespace std;
+
+namespace {
+
+/*
+ * Linear congruential generator, so that workloads are identical
+ * across platforms and C library implementations.
+ */
+class Random
+{
+public:
+  Random(unsigned int seed) : state(seed) {}
+
+  /// @return a value in [0, 1)
+  double next()
+  {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0;
+  }
+
+  double next(double min, double max)
+  {
+    return min + next() * (max - min);
+  }
+
+private:
+  unsigned int state;
+};
+
+/*
+ * Square envelopes of side up to maxSize, scattered over a square
+ * whose side grows with sqrt(n), keeping the density constant.
+ */
+void
+randomEnvelopes(unsigned int seed, size_t n, double maxSize,
+                double side, vector<Envelope>& out)
+{
+  Random rnd(seed);
+  out.reserve(n);
+  for (size_t i=0; i<n; ++i)
+  {
+    double x = rnd.next(0, side);
+    double y = rnd.next(0, side);
+    double size = rnd.next(0, maxSize);
+    out.push_back(Envelope(x, x + size, y, y + size));
+  }
+}
+
+/// Envelopes of the items and of the query windows
+struct Workload
+{
+  Workload(size_t nItems, size_t nQueries)
+  {
+    double side = 10.0 * sqrt(double(nItems));
+    randomEnvelopes(1, nItems, 10, side, items);
+    randomEnvelopes(2, nQueries, 50, side, windows);
+  }
+
+  vector<Envelope> items;
+  vector<Envelope> windows;
+};
+
+/// found is used as scratch space, of the type filled by the index
+template <class Index, class Found>
+size_t
+runQueries(const Index& index, const Workload& w,
+           geos::util::Profile& prof, Found& found)
+{
+  size_t nFound = 0;
+  prof.start();
+  for (size_t i=0; i<w.windows.size(); ++i)
+  {
+    found.clear();
+    index.query(&w.windows[i], found);
+    nFound += found.size();
+  }
+  prof.stop();
+  return nFound;
+}
+
+/// Items are saved as their offset in the workload
+struct ItemOffset : public MappedSTRtree::ItemIdentifier
+{
+  ItemOffset(const Envelope* b) : base(b) {}
+  int64 getId(void* item)
+  {
+    return static_cast<Envelope*>(item) - base;
+  }
+  const Envelope* base;
+};
+
+/// Counts the items found by STRtree::queryMany
+struct BatchCounter : public BatchQueryVisitor
+{
+  BatchCounter() : count(0) {}
+  void visitItem(size_t, void*) { ++count; }
+  size_t count;
+};
+
+/// STRtree::query and RStarTree::query are not const
+template <class Tree>
+struct NonConstQuery
+{
+  NonConstQuery(Tree& t) : tree(t) {}
+  void query(const Envelope* env, vector<void*>& found) const
+  {
+    tree.query(env, found);
+  }
+  Tree& tree;
+};
+
+/*
+ * Build an index and time queries on it.
+ * @return the number of items found, or 0 for unknown indexes
+ */
+size_t
+runCase(const string& index, const Workload& w)
+{
+  size_t nItems = w.items.size();
+  geos::util::Profile build(index + " build");
+  geos::util::Profile queries(index + " query");
+  size_t nFound = 0;
+  vector<void*> found;
+  // 0 when the index does not report it
+  size_t indexBytes = 0;
+
+  if ( index == "STRtree" || index == "STRtree-batch" ||
+       index == "FrozenSTRtree" )
+  {
+    STRtree tree;
+    if ( index != "FrozenSTRtree" ) build.start();
+    for (size_t i=0; i<nItems; ++i)
+      tree.insert(&w.items[i], const_cast<Envelope*>(&w.items[i]));
+    tree.build();
+    if ( index == "STRtree" )
+    {
+      build.stop();
+      nFound = runQueries(NonConstQuery<STRtree>(tree), w, queries, found);
+    }
+    else if ( index == "STRtree-batch" )
+    {
+      build.stop();
+      BatchCounter counter;
+      queries.start();
+      tree.queryMany(&w.windows[0], w.windows.size(), counter);
+      queries.stop();
+      nFound = counter.count;
+    }
+    else
+    {
+      // the time of the copy only
+      build.start();
+      FrozenSTRtree frozen(tree);
+      build.stop();
+      nFound = runQueries(frozen, w, queries, found);
+      indexBytes = frozen.getMemorySize();
+    }
+  }
+  else if ( index == "FrozenSTRtree-bulk" || index == "MappedSTRtree" )
+  {
+    vector< pair<Envelope, void*> > entries;
+    entries.reserve(nItems);
+    for (size_t i=0; i<nItems; ++i)
+      entries.push_back(make_pair(w.items[i],
+                                  const_cast<Envelope*>(&w.items[i])));
+    if ( index == "FrozenSTRtree-bulk" ) build.start();
+    FrozenSTRtree frozen(entries);
+    if ( index == "FrozenSTRtree-bulk" )
+    {
+      build.stop();
+      nFound = runQueries(frozen, w, queries, found);
+      indexBytes = frozen.getMemorySize();
+    }
+    else
+    {
+      // the time of opening the file only, as at a restart
+      ItemOffset ids(&w.items[0]);
+      const string filename = "STRtreePerfTest.bin";
+      MappedSTRtree::write(frozen, ids, filename);
+      build.start();
+      MappedSTRtree mapped(filename);
+      build.stop();
+      vector<int64> foundIds;
+      nFound = runQueries(mapped, w, queries, foundIds);
+      remove(filename.c_str());
+    }
+  }
+  else if ( index == "RStarTree" )
+  {
+    RStarTree tree;
+    build.start();
+    for (size_t i=0; i<nItems; ++i)
+      tree.insert(&w.items[i], const_cast<Envelope*>(&w.items[i]));
+    build.stop();
+    nFound = runQueries(NonConstQuery<RStarTree>(tree), w, queries, found);
+  }
+  else
+  {
+    return 0;
+  }
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  double secs = queries.getTot() / 1000000.0;
+  cout << index << "," << nItems << "," << w.windows.size() << ","
+       << build.getTot() / 1000.0 << "," << queries.getTot() / 1000.0 << ","
+       << ( secs > 0 ? w.windows.size() / secs : 0 ) << ","
+       << nFound << ",";
+  if ( indexBytes ) cout << indexBytes;
+  cout << "," << usage.ru_maxrss << endl;
+  return nFound;
+}
+
+const char* const indexes[] = {
+  "STRtree",
+  "STRtree-batch",
+  "FrozenSTRtree",
+  "FrozenSTRtree-bulk",
+  "MappedSTRtree",
+  "RStarTree",
+  0
+};
+
+} // anonymous namespace
+
+int
+main(int argc, char** argv)
+{
+  size_t nItems = 1000000;
+  size_t nQueries = 100000;
+  const char* onlyIndex = 0;
+
+  if ( argc > 1 ) nItems = size_t(atol(argv[1]));
+  if ( argc > 2 ) nQueries = size_t(atol(argv[2]));
+  if ( argc > 3 ) onlyIndex = argv[3];
+
+  cout << "index,items,queries,build_millis,query_millis,"
+       << "queries_per_sec,found,index_bytes,peak_rss_kb" << endl;
+
+  for (const char* const* i = indexes; *i; ++i)
+  {
+    if ( onlyIndex && strcmp(onlyIndex, *i) ) continue;
+
+    // Each index is built in a child process, so that the
+    // reported peak resident set size belongs to it only
+    cout.flush();
+    pid_t pid = fork();
+    if ( pid == 0 )
+    {
+      Workload w(nItems, nQueries);
+      runCase(*i, w);
+      cout.flush();
+      _exit(0);
+    }
+
+    int status = 0;
+    if ( pid < 0 || waitpid(pid, &status, 0) < 0 ||
+         ! WIFEXITED(status) || WEXITSTATUS(status) != 0 )
+    {
+      cout << *i << "," << nItems << "," << nQueries
+           << ",crashed,,,,," << endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,413 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Times the available Noder implementations against a set of
+ * deterministically generated workloads.
+ *
+ * Usage: NodingPerfTest [maxSegments [noder [workload]]]
+ *
+ * Each (noder, workload, size) case runs in a child process, so
+ * the reported peak resident set size belongs to that case only.
+ * Output is one CSV record per case on stdout, preceded by a header.
+ *
+ **********************************************************************/
+
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/util/SineStarFactory.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/noding/SegmentString.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/SimpleNoder.h>
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/IteratedNoder.h>
+#include <geos/noding/ScaledNoder.h>
+#include <geos/noding/snapround/SimpleSnapRounder.h>
+#include <geos/noding/snapround/MCIndexSnapRounder.h>
+#include <geos/profiler.h>
+#include <geos/util/GEOSException.h>
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace geos::geom;
+using namespace geos::noding;
+using namespace std;
+
+namespace {
+
+typedef SegmentString::NonConstVect SegStrVect;
+
+/*
+ * Linear congruential generator, so that workloads are identical
+ * across platforms and C library implementations.
+ */
+class Random
+{
+public:
+  Random(unsigned int seed) : state(seed) {}
+
+  /// @return a value in [0, 1)
+  double next()
+  {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0;
+  }
+
+  double next(double min, double max)
+  {
+    return min + next() * (max - min);
+  }
+
+private:
+  unsigned int state;
+};
+
+class WorkloadGenerator
+{
+public:
+
+  WorkloadGenerator(const GeometryFactory& f)
+    :
+    fact(f)
+  {}
+
+  /// Segment strings totalling about nSegs segments are appended to out
+  void generate(const string& name, size_t nSegs, SegStrVect& out)
+  {
+    if ( name == "random" ) randomSegments(nSegs, out);
+    else if ( name == "sinestar" ) sineStars(nSegs, out);
+    else if ( name == "parallel" ) nearParallelLines(nSegs, out);
+    else if ( name == "grid" ) denseGrid(nSegs, out);
+  }
+
+private:
+
+  const GeometryFactory& fact;
+
+  void addLine(CoordinateSequence* pts, SegStrVect& out)
+  {
+    out.push_back(new NodedSegmentString(pts, 0));
+  }
+
+  /*
+   * Short segments scattered over a square whose side grows with
+   * sqrt(nSegs), keeping the number of crossings per segment constant.
+   */
+  void randomSegments(size_t nSegs, SegStrVect& out)
+  {
+    Random rnd(1);
+    double side = 10.0 * sqrt(double(nSegs));
+    for (size_t i=0; i<nSegs; ++i)
+    {
+      double x = rnd.next(0, side);
+      double y = rnd.next(0, side);
+      CoordinateSequence* pts = new CoordinateArraySequence();
+      pts->add(Coordinate(x, y));
+      pts->add(Coordinate(x + rnd.next(-10, 10), y + rnd.next(-10, 10)));
+      addLine(pts, out);
+    }
+  }
+
+  /*
+   * Two overlapping sine star boundaries, crossing each other
+   * along most of their arms.
+   */
+  void sineStars(size_t nSegs, SegStrVect& out)
+  {
+    using geos::geom::util::SineStarFactory;
+
+    int nPts = int(nSegs / 2);
+    for (int i=0; i<2; ++i)
+    {
+      SineStarFactory gsf(&fact);
+      gsf.setCentre(Coordinate(i * 10.0, i * 5.0));
+      gsf.setSize(1000);
+      gsf.setNumPoints(nPts);
+      gsf.setArmLengthRatio(0.5);
+      gsf.setNumArms(20);
+      auto_ptr<Polygon> poly = gsf.createSineStar();
+      addLine(poly->getExteriorRing()->getCoordinates(), out);
+    }
+  }
+
+  /*
+   * Long horizontal polylines, spaced one unit apart and wobbling
+   * enough to touch or cross their neighbours now and then.
+   */
+  void nearParallelLines(size_t nSegs, SegStrVect& out)
+  {
+    Random rnd(2);
+    size_t nLines = size_t(sqrt(double(nSegs)));
+    if ( ! nLines ) nLines = 1;
+    size_t nLineSegs = nSegs / nLines;
+    for (size_t i=0; i<nLines; ++i)
+    {
+      CoordinateSequence* pts = new CoordinateArraySequence();
+      for (size_t j=0; j<=nLineSegs; ++j)
+      {
+        double y = double(i) + rnd.next(-0.55, 0.55);
+        pts->add(Coordinate(double(j), y));
+      }
+      addLine(pts, out);
+    }
+  }
+
+  /*
+   * A square lattice of horizontal and vertical polylines, every
+   * vertex of one direction lying on a line of the other.
+   */
+  void denseGrid(size_t nSegs, SegStrVect& out)
+  {
+    size_t n = size_t(sqrt(double(nSegs) / 2.0));
+    if ( ! n ) n = 1;
+    for (size_t i=0; i<n; ++i)
+    {
+      CoordinateSequence* h = new CoordinateArraySequence();
+      CoordinateSequence* v = new CoordinateArraySequence();
+      for (size_t j=0; j<=n; ++j)
+      {
+        h->add(Coordinate(double(j), i + 0.5));
+        v->add(Coordinate(i + 0.5, double(j)));
+      }
+      addLine(h, out);
+      addLine(v, out);
+    }
+  }
+};
+
+struct Result
+{
+  Result() : intersections(-1), substrings(0) {}
+
+  /// -1 when the noder does not expose an intersection count
+  long intersections;
+  size_t substrings;
+};
+
+class NodingPerfTest
+{
+public:
+
+  NodingPerfTest()
+    :
+    pm(1000.0),
+    fact(&pm, 0)
+  {}
+
+  static const char* const noders[];
+  static const char* const workloads[];
+
+  /*
+   * Run a single case in a child process and print its record.
+   */
+  void run(const string& noder, const string& workload, size_t nSegs)
+  {
+    cout.flush();
+    pid_t pid = fork();
+    if ( pid == 0 )
+    {
+      int ret = runCase(noder, workload, nSegs);
+      cout.flush();
+      _exit(ret);
+    }
+
+    int status = 0;
+    if ( pid < 0 || waitpid(pid, &status, 0) < 0 ||
+         ! WIFEXITED(status) || WEXITSTATUS(status) > 1 )
+    {
+      cout << noder << "," << workload << "," << nSegs
+           << ",crashed,,,,," << endl;
+    }
+  }
+
+  static size_t maxSegmentsFor(const string& noder)
+  {
+    // Quadratic noders are not worth running on large inputs
+    if ( noder == "SimpleNoder" || noder == "SimpleSnapRounder" )
+      return 10000;
+    return size_t(-1);
+  }
+
+private:
+
+  PrecisionModel pm;
+  GeometryFactory fact;
+
+  int runCase(const string& noder, const string& workload, size_t nSegs)
+  {
+    SegStrVect segStrings;
+    WorkloadGenerator gen(fact);
+    gen.generate(workload, nSegs, segStrings);
+
+    size_t actualSegs = 0;
+    for (size_t i=0; i<segStrings.size(); ++i)
+      actualSegs += segStrings[i]->size() - 1;
+
+    Result res;
+    string status = "ok";
+    geos::util::Profile sw(noder);
+
+    try
+    {
+      sw.start();
+      node(noder, segStrings, res);
+      sw.stop();
+    }
+    catch (const geos::util::GEOSException&)
+    {
+      sw.stop();
+      status = "failed";
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    double secs = sw.getTot() / 1000000.0;
+    cout << noder << "," << workload << "," << actualSegs << ","
+         << status << "," << sw.getTot() / 1000.0 << ","
+         << ( secs > 0 ? actualSegs / secs : 0 ) << ","
+         << res.intersections << "," << res.substrings << ","
+         << usage.ru_maxrss << endl;
+
+    // Inputs and noded substrings are left for process exit to reclaim
+    return status == "ok" ? 0 : 1;
+  }
+
+  void node(const string& name, SegStrVect& segStrings, Result& res)
+  {
+    using geos::algorithm::LineIntersector;
+    using namespace geos::noding::snapround;
+
+    LineIntersector li(&pm);
+    IntersectionAdder si(li);
+    auto_ptr<SegStrVect> noded;
+
+    if ( name == "SimpleNoder" )
+    {
+      SimpleNoder noder(&si);
+      noder.computeNodes(&segStrings);
+      noded.reset(noder.getNodedSubstrings());
+      res.intersections = si.numIntersections;
+    }
+    else if ( name == "MCIndexNoder" )
+    {
+      MCIndexNoder noder(&si);
+      noder.computeNodes(&segStrings);
+      noded.reset(noder.getNodedSubstrings());
+      res.intersections = si.numIntersections;
+    }
+    else if ( name == "IteratedNoder" )
+    {
+      IteratedNoder noder(&pm);
+      noder.computeNodes(&segStrings);
+      noded.reset(noder.getNodedSubstrings());
+    }
+    else if ( name == "SimpleSnapRounder" )
+    {
+      // Nodes are added to the inputs, which are returned as they are
+      SimpleSnapRounder noder(pm);
+      noder.computeNodes(&segStrings);
+      noded.reset(NodedSegmentString::getNodedSubstrings(segStrings));
+    }
+    else if ( name == "MCIndexSnapRounder" )
+    {
+      MCIndexSnapRounder noder(pm);
+      noder.computeNodes(&segStrings);
+      noded.reset(noder.getNodedSubstrings());
+    }
+    else if ( name == "ScaledNoder" )
+    {
+      // Snap-round on the integer grid, as BufferBuilder would
+      PrecisionModel unitPm(1.0);
+      MCIndexSnapRounder snapRounder(unitPm);
+      ScaledNoder noder(snapRounder, pm.getScale());
+      noder.computeNodes(&segStrings);
+      noded.reset(noder.getNodedSubstrings());
+    }
+
+    if ( noded.get() ) res.substrings = noded->size();
+  }
+};
+
+const char* const NodingPerfTest::noders[] = {
+  "SimpleNoder",
+  "MCIndexNoder",
+  "IteratedNoder",
+  "ScaledNoder",
+  "SimpleSnapRounder",
+  "MCIndexSnapRounder",
+  0
+};
+
+const char* const NodingPerfTest::workloads[] = {
+  "random",
+  "sinestar",
+  "parallel",
+  "grid",
+  0
+};
+
+} // anonymous namespace
+
+int
+main(int argc, char** argv)
+{
+  size_t maxSegs = 1000000;
+  const char* onlyNoder = 0;
+  const char* onlyWorkload = 0;
+
+  if ( argc > 1 ) maxSegs = size_t(atol(argv[1]));
+  if ( argc > 2 ) onlyNoder = argv[2];
+  if ( argc > 3 ) onlyWorkload = argv[3];
+
+  NodingPerfTest tester;
+
+  cout << "noder,workload,segments,status,millis,segments_per_sec,"
+       << "intersections,substrings,peak_rss_kb" << endl;
+
+  for (const char* const* n = NodingPerfTest::noders; *n; ++n)
+  {
+    if ( onlyNoder && strcmp(onlyNoder, *n) ) continue;
+    size_t noderMax = NodingPerfTest::maxSegmentsFor(*n);
+    for (const char* const* w = NodingPerfTest::workloads; *w; ++w)
+    {
+      if ( onlyWorkload && strcmp(onlyWorkload, *w) ) continue;
+      for (size_t nSegs = 1000; nSegs <= maxSegs && nSegs <= noderMax;
+           nSegs *= 10)
+      {
+        tester.run(*n, *w, nSegs);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Times TopologyPreservingSimplifier against deterministically
+ * generated noisy rings: a single ring of all the vertices ("ring"),
+ * and the same vertices as many separate 60-vertex polygons, each
+ * simplified on its own ("rings").
+ *
+ * Usage: TopologyPreservingSimplifierPerfTest [numVertices [workload]]
+ *
+ * Output is one CSV record per workload on stdout, preceded by
+ * a header.
+ *
+ **********************************************************************/
+
+#include <geos/simplify/TopologyPreservingSimplifier.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/profiler.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+using namespace geos::geom;
+using geos::simplify::TopologyPreservingSimplifier;
+using namespace std;
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+/// Vertices of each polygon of the "rings" workload
+const size_t SMALL_RING_VERTICES = 60;
+
+/*
+ * Linear congruential generator, so that workloads are identical
+ * across platforms and C library implementations.
+ */
+class Random
+{
+public:
+  Random(unsigned int seed) : state(seed) {}
+
+  /// @return a value in [0, 1)
+  double next()
+  {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0;
+  }
+
+  double next(double min, double max)
+  {
+    return min + next() * (max - min);
+  }
+
+private:
+  unsigned int state;
+};
+
+/*
+ * A star-shaped polygon of n vertices around the origin, each at
+ * a random distance between 0.8 and 1 times the radius.
+ */
+auto_ptr<Geometry>
+noisyRing(const GeometryFactory& fact, Random& rnd, size_t n, double radius)
+{
+  CoordinateSequence* pts = new CoordinateArraySequence();
+  for (size_t i=0; i<n; ++i)
+  {
+    double angle = 2 * PI * i / n;
+    double r = radius * rnd.next(0.8, 1);
+    pts->add(Coordinate(r * cos(angle), r * sin(angle)));
+  }
+  pts->add(pts->getAt(0));
+  return auto_ptr<Geometry>(
+    fact.createPolygon(fact.createLinearRing(pts), 0));
+}
+
+/*
+ * Simplify the workload, with a tolerance of a quarter of the
+ * radial noise of its rings.
+ * @return the number of vertices left, or 0 for unknown workloads
+ */
+size_t
+runCase(const string& workload, size_t nVertices)
+{
+  GeometryFactory fact;
+  Random rnd(1);
+  geos::util::Profile prof(workload);
+  size_t nLeft = 0;
+
+  if ( workload == "ring" )
+  {
+    auto_ptr<Geometry> g = noisyRing(fact, rnd, nVertices, 1000);
+    prof.start();
+    auto_ptr<Geometry> s = TopologyPreservingSimplifier::simplify(g.get(), 50);
+    prof.stop();
+    nLeft = s->getNumPoints();
+  }
+  else if ( workload == "rings" )
+  {
+    for (size_t i=0; i<nVertices; i+=SMALL_RING_VERTICES)
+    {
+      auto_ptr<Geometry> g = noisyRing(fact, rnd, SMALL_RING_VERTICES, 10);
+      prof.start();
+      auto_ptr<Geometry> s =
+        TopologyPreservingSimplifier::simplify(g.get(), 0.5);
+      prof.stop();
+      nLeft += s->getNumPoints();
+    }
+  }
+  else
+  {
+    return 0;
+  }
+
+  cout << workload << "," << nVertices << "," << prof.getTot() / 1000.0
+       << "," << nLeft << endl;
+  return nLeft;
+}
+
+const char* const workloads[] = {
+  "ring",
+  "rings",
+  0
+};
+
+} // anonymous namespace
+
+int
+main(int argc, char** argv)
+{
+  size_t nVertices = 200000;
+  const char* onlyWorkload = 0;
+
+  if ( argc > 1 ) nVertices = size_t(atol(argv[1]));
+  if ( argc > 2 ) onlyWorkload = argv[2];
+
+  cout << "workload,vertices,millis,vertices_left" << endl;
+
+  for (const char* const* w = workloads; *w; ++w)
+  {
+    if ( onlyWorkload && strcmp(onlyWorkload, *w) ) continue;
+    runCase(*w, nVertices);
+  }
+
+  return 0;
+}
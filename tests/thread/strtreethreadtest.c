@@ -0,0 +1,208 @@
+/************************************************************************
+ *
+ *
+ * Multithreaded queries of a shared STRtree, with the C-Wrapper
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ ***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#include "geos_c.h"
+
+#define NUMBOXES 20000
+#define NUMQUERIES 500
+#define NUMROUNDS 5
+#define MAXTHREADS 64
+
+/* A box inserted in the tree, its index being the item */
+typedef struct
+{
+	double minx, miny, maxx, maxy;
+} Box;
+
+static Box boxes[NUMBOXES];
+static Box queries[NUMQUERIES];
+static int expected[NUMQUERIES];
+static GEOSSTRtree *tree;
+
+typedef struct
+{
+	int id;
+	int failures;
+} ThreadData;
+
+void
+notice(const char *fmt, ...) {
+	va_list ap;
+
+        fprintf( stdout, "NOTICE: ");
+        
+	va_start (ap, fmt);
+        vfprintf( stdout, fmt, ap);
+        va_end(ap);
+        fprintf( stdout, "\n" );
+}
+
+void
+log_and_exit(const char *fmt, ...) {
+	va_list ap;
+
+        fprintf( stdout, "ERROR: ");
+        
+	va_start (ap, fmt);
+        vfprintf( stdout, fmt, ap);
+        va_end(ap);
+        fprintf( stdout, "\n" );
+	exit(1);
+}
+
+/* Deterministic values in [0, 1) */
+double
+randomValue(unsigned int *seed)
+{
+	*seed = *seed * 1664525u + 1013904223u;
+	return (*seed >> 8) / 16777216.0;
+}
+
+GEOSGeometry *
+boxGeometry(GEOSContextHandle_t handle, const Box *b)
+{
+	char wkt[256];
+	sprintf(wkt, "POLYGON((%.17g %.17g, %.17g %.17g, %.17g %.17g, "
+	             "%.17g %.17g, %.17g %.17g))",
+	        b->minx, b->miny, b->maxx, b->miny, b->maxx, b->maxy,
+	        b->minx, b->maxy, b->minx, b->miny);
+	return GEOSGeomFromWKT_r(handle, wkt);
+}
+
+int
+intersects(const Box *a, const Box *b)
+{
+	return a->minx <= b->maxx && a->maxx >= b->minx &&
+	       a->miny <= b->maxy && a->maxy >= b->miny;
+}
+
+/* Counts the items found, checking they intersect the query */
+typedef struct
+{
+	const Box *query;
+	int count;
+	int wrong;
+} QueryResult;
+
+void
+countItem(void *item, void *userdata)
+{
+	QueryResult *result = (QueryResult *)userdata;
+	const Box *b = (const Box *)item;
+	if ( ! intersects(b, result->query) ) result->wrong++;
+	result->count++;
+}
+
+void *threadfunc( void *arg )
+{
+	ThreadData *data = (ThreadData *)arg;
+	GEOSContextHandle_t handle = initGEOS_r( notice, log_and_exit );
+	GEOSGeometry *geoms[NUMQUERIES];
+	QueryResult result;
+	int i, round;
+
+	for (i=0; i<NUMQUERIES; i++)
+		geoms[i] = boxGeometry(handle, &queries[i]);
+
+	for (round=0; round<NUMROUNDS; round++)
+	{
+		/* each thread goes through the queries in its own order */
+		for (i=0; i<NUMQUERIES; i++)
+		{
+			int q = (i * 7 + data->id * 131) % NUMQUERIES;
+			result.query = &queries[q];
+			result.count = 0;
+			result.wrong = 0;
+			GEOSSTRtree_query_r(handle, tree, geoms[q], countItem, &result);
+			if ( result.count != expected[q] || result.wrong )
+				data->failures++;
+		}
+	}
+
+	for (i=0; i<NUMQUERIES; i++)
+		GEOSGeom_destroy_r(handle, geoms[i]);
+	finishGEOS_r(handle);
+
+	pthread_exit(NULL);
+}
+
+int
+main(int argc, char **argv)
+{
+	pthread_t threads[MAXTHREADS];
+	ThreadData data[MAXTHREADS];
+	GEOSContextHandle_t handle;
+	GEOSGeometry *geoms[NUMBOXES];
+	unsigned int seed = 1;
+	int numThreads = 8;
+	int i, j, failures = 0;
+
+	if ( argc > 1 ) numThreads = atoi(argv[1]);
+	if ( numThreads < 1 || numThreads > MAXTHREADS )
+	{
+		fprintf(stderr, "Usage: %s [numThreads, at most %d]\n",
+		        argv[0], MAXTHREADS);
+		exit(1);
+	}
+
+	handle = initGEOS_r( notice, log_and_exit );
+	tree = GEOSSTRtree_create_r(handle, 10);
+	for (i=0; i<NUMBOXES; i++)
+	{
+		boxes[i].minx = randomValue(&seed) * 1000;
+		boxes[i].miny = randomValue(&seed) * 1000;
+		boxes[i].maxx = boxes[i].minx + randomValue(&seed) * 10;
+		boxes[i].maxy = boxes[i].miny + randomValue(&seed) * 10;
+		geoms[i] = boxGeometry(handle, &boxes[i]);
+		GEOSSTRtree_insert_r(handle, tree, geoms[i], &boxes[i]);
+	}
+	for (i=0; i<NUMQUERIES; i++)
+	{
+		queries[i].minx = randomValue(&seed) * 1000;
+		queries[i].miny = randomValue(&seed) * 1000;
+		queries[i].maxx = queries[i].minx + randomValue(&seed) * 50;
+		queries[i].maxy = queries[i].miny + randomValue(&seed) * 50;
+		expected[i] = 0;
+		for (j=0; j<NUMBOXES; j++)
+			if ( intersects(&boxes[j], &queries[i]) ) expected[i]++;
+	}
+
+	/* after this, queries do not modify the tree */
+	if ( ! GEOSSTRtree_build_r(handle, tree) )
+		log_and_exit("Could not build the tree");
+
+	for (i=0; i<numThreads; i++)
+	{
+		data[i].id = i;
+		data[i].failures = 0;
+		pthread_create( &threads[i], NULL, threadfunc, &data[i] );
+	}
+	for (i=0; i<numThreads; i++)
+	{
+		pthread_join( threads[i], NULL );
+		failures += data[i].failures;
+	}
+
+	GEOSSTRtree_destroy_r(handle, tree);
+	for (i=0; i<NUMBOXES; i++)
+		GEOSGeom_destroy_r(handle, geoms[i]);
+	finishGEOS_r(handle);
+
+	printf("%d threads, %d queries each, %d failures\n",
+	       numThreads, NUMQUERIES * NUMROUNDS, failures);
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+//
+// Test Suite for geos::algorithm::SegmentIntersectionBatch
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/algorithm/SegmentIntersectionBatch.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/Coordinate.h>
+// std
+#include <vector>
+#include <cstddef>
+
+using geos::geom::Coordinate;
+using geos::algorithm::LineIntersector;
+using geos::algorithm::SegmentIntersectionBatch;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_segmentintersectionbatch_data : public RandomValues
+	{
+		SegmentIntersectionBatch batch;
+		LineIntersector li;
+		std::vector<Coordinate> pts;
+
+		// Filters the pairs of segments in pts, four points per pair,
+		// checking no intersecting pair is left out.
+		// @return the number of pairs left out
+		std::size_t filterAndCheck()
+		{
+			std::size_t nRejected = 0;
+			for (std::size_t first = 0; first < pts.size();
+			     first += 4 * SegmentIntersectionBatch::CAPACITY)
+			{
+				batch.clear();
+				for (std::size_t i = first;
+				     i < pts.size() && ! batch.isFull(); i += 4)
+				{
+					batch.add(pts[i], pts[i+1], pts[i+2], pts[i+3]);
+				}
+
+				std::size_t n = batch.filter();
+				std::size_t next = 0;
+				for (std::size_t j = 0; j < batch.size(); ++j)
+				{
+					if (next < n && batch.getCandidate(next) == j)
+					{
+						++next;
+						continue;
+					}
+					const Coordinate* p = &pts[first + 4 * j];
+					li.computeIntersection(p[0], p[1], p[2], p[3]);
+					ensure(!li.hasIntersection());
+					++nRejected;
+				}
+				ensure_equals(next, n);
+			}
+			return nRejected;
+		}
+	};
+
+	typedef test_group<test_segmentintersectionbatch_data> group;
+	typedef group::object object;
+
+	group test_segmentintersectionbatch_group(
+		"geos::algorithm::SegmentIntersectionBatch");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Crossing, touching, collinear and disjoint pairs
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		const double c[][8] = {
+			{ 0, 0, 10, 10,   0, 10, 10, 0 },   // crossing
+			{ 0, 0, 10, 10,  10, 10, 20, 0 },   // touching at an end
+			{ 0, 0, 10, 0,    5, 0, 15, 0 },    // collinear overlap
+			{ 0, 0, 10, 0,   20, 0, 30, 0 },    // collinear apart
+			{ 0, 0, 10, 10,   1, 0, 10, 9 },    // parallel
+			{ 0, 0, 10, 10,   6, 5, 9, 0 },     // envelopes overlap
+			{ 0, 0, 1, 1,     5, 5, 6, 6 },     // envelopes apart
+			{ 0, 0, 10, 0,    5, 0, 5, 5 }      // touching inside
+		};
+		for (std::size_t i = 0; i < sizeof(c) / sizeof(c[0]); ++i)
+		{
+			batch.add(Coordinate(c[i][0], c[i][1]),
+			          Coordinate(c[i][2], c[i][3]),
+			          Coordinate(c[i][4], c[i][5]),
+			          Coordinate(c[i][6], c[i][7]));
+		}
+		ensure_equals(batch.size(), 8u);
+
+		ensure_equals(batch.filter(), 4u);
+		ensure_equals(batch.getCandidate(0), 0u);
+		ensure_equals(batch.getCandidate(1), 1u);
+		ensure_equals(batch.getCandidate(2), 2u);
+		ensure_equals(batch.getCandidate(3), 7u);
+
+		batch.clear();
+		ensure(batch.isEmpty());
+		ensure_equals(batch.filter(), 0u);
+	}
+
+	// 2 - No intersecting pair is left out, on a coarse grid
+	// where many points are collinear
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		for (int i = 0; i < 4 * 2000; ++i)
+		{
+			pts.push_back(Coordinate(double(int(random() * 8)),
+			                         double(int(random() * 8))));
+		}
+		std::size_t nRejected = filterAndCheck();
+		ensure(nRejected > 0);
+	}
+
+	// 3 - No intersecting pair is left out, with nearly collinear
+	// points far from the origin
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		for (int i = 0; i < 2000; ++i)
+		{
+			double x0 = 1e12 + random() * 1e-3;
+			double y0 = 1e12 + random() * 1e-3;
+			double dx = random() - 0.5;
+			double dy = random() - 0.5;
+			pts.push_back(Coordinate(x0 - dx, y0 - dy));
+			pts.push_back(Coordinate(x0 + dx, y0 + dy));
+			double t = random() - 0.5;
+			double e = (random() - 0.5) * 1e-4;
+			pts.push_back(Coordinate(x0 + t * dx - e, y0 + t * dy));
+			pts.push_back(Coordinate(x0 + t * dx + e, y0 + t * dy + 1e-3));
+		}
+		filterAndCheck();
+	}
+
+} // namespace tut
@@ -0,0 +1,201 @@
+//
+// Test Suite for geos::algorithm::distance::DiscreteFrechetDistance
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/io/WKTReader.h>
+#include <geos/algorithm/distance/DiscreteFrechetDistance.h>
+#include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+using namespace geos::geom;
+using geos::algorithm::distance::DiscreteFrechetDistance;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_discretefrechetdistance_data : public RandomValues
+	{
+		typedef std::auto_ptr<Geometry> GeomPtr;
+
+		GeometryFactory gf;
+		geos::io::WKTReader reader;
+
+		test_discretefrechetdistance_data()
+			: reader(&gf)
+		{}
+
+		GeomPtr read(const std::string& wkt)
+		{
+			return GeomPtr(reader.read(wkt));
+		}
+
+		// A random walk of n steps from x y
+		GeomPtr randomLine(int n, double x, double y)
+		{
+			std::ostringstream wkt;
+			wkt.precision(17);
+			wkt << "LINESTRING (" << x << " " << y;
+			for (int i = 0; i < n; ++i)
+			{
+				x += random() * 10 - 4;
+				y += random() * 10 - 5;
+				wkt << ", " << x << " " << y;
+			}
+			wkt << ")";
+			return read(wkt.str());
+		}
+
+		// The distance over the whole matrix of pairs of vertices
+		static double bruteForceDistance(const Geometry& g0, const Geometry& g1)
+		{
+			std::auto_ptr<CoordinateSequence> p(g0.getCoordinates());
+			std::auto_ptr<CoordinateSequence> q(g1.getCoordinates());
+			std::size_t n = p->size();
+			std::size_t m = q->size();
+			std::vector<double> ca(n * m);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				for (std::size_t j = 0; j < m; ++j)
+				{
+					double d = p->getAt(i).distance(q->getAt(j));
+					double prev;
+					if ( i == 0 && j == 0 ) prev = d;
+					else if ( i == 0 ) prev = ca[j - 1];
+					else if ( j == 0 ) prev = ca[(i - 1) * m];
+					else prev = std::min(std::min(ca[(i - 1) * m + j],
+					                              ca[i * m + j - 1]),
+					                     ca[(i - 1) * m + j - 1]);
+					ca[i * m + j] = std::max(d, prev);
+				}
+			}
+			return ca[n * m - 1];
+		}
+
+		void runTest(const std::string& wkt0, const std::string& wkt1,
+		             double expected)
+		{
+			GeomPtr g0(read(wkt0));
+			GeomPtr g1(read(wkt1));
+			DiscreteFrechetDistance dfd(*g0, *g1);
+			double distance = dfd.distance();
+			ensure_distance(distance, expected, 1e-12);
+			const std::vector<Coordinate>& pts = dfd.getCoordinates();
+			ensure_equals(pts[0].distance(pts[1]), distance);
+			ensure(dfd.isFrechetWithin(distance));
+			ensure(! dfd.isFrechetWithin(distance * 0.99));
+		}
+	};
+
+	typedef test_group<test_discretefrechetdistance_data> group;
+	typedef group::object object;
+
+	group test_discretefrechetdistance_group("geos::algorithm::distance::DiscreteFrechetDistance");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Lines and points
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		runTest("LINESTRING (0 0, 2 1)", "LINESTRING (0 0, 2 0)", 1.0);
+		runTest("LINESTRING (0 0, 2 0)", "LINESTRING (0 1, 1 2, 2 1)",
+		        std::sqrt(5.0));
+		runTest("LINESTRING (0 0, 2 0)", "MULTIPOINT (0 1, 1 0, 2 1)", 1.0);
+		runTest("POINT (1 1)", "LINESTRING (0 0, 2 0)", std::sqrt(2.0));
+	}
+
+	// 2 - The order of the points matters, unlike for Hausdorff
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		GeomPtr g0(read("LINESTRING (0 0, 5 0, 10 0)"));
+		GeomPtr g1(read("LINESTRING (10 0, 5 0, 0 0)"));
+		ensure_equals(DiscreteFrechetDistance::distance(*g0, *g1), 10.0);
+		ensure_equals(geos::algorithm::distance::DiscreteHausdorffDistance::distance(*g0, *g1), 0.0);
+		ensure_equals(DiscreteFrechetDistance::distance(*g0, *g0), 0.0);
+	}
+
+	// 3 - Densified
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		GeomPtr g0(read("LINESTRING (0 0, 100 0)"));
+		GeomPtr g1(read("LINESTRING (0 0, 50 50, 100 0)"));
+		ensure_distance(DiscreteFrechetDistance::distance(*g0, *g1),
+		                std::sqrt(5000.0), 1e-9);
+		ensure_distance(DiscreteFrechetDistance::distance(*g0, *g1, 0.5),
+		                50.0, 1e-9);
+		ensure(DiscreteFrechetDistance::isFrechetWithin(*g0, *g1, 0.5, 50.0));
+		ensure(! DiscreteFrechetDistance::isFrechetWithin(*g0, *g1, 0.5, 49.9));
+		ensure(! DiscreteFrechetDistance::isFrechetWithin(*g0, *g1, 50.0));
+	}
+
+	// 4 - Random walks against the whole matrix
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		for (int i = 0; i < 20; ++i)
+		{
+			GeomPtr g0(randomLine(50 + i * 7, 0, 0));
+			GeomPtr g1(randomLine(80 - i * 3, 3, 2));
+			double expected = bruteForceDistance(*g0, *g1);
+			DiscreteFrechetDistance dfd(*g0, *g1);
+			ensure_equals(dfd.distance(), expected);
+			ensure(dfd.isFrechetWithin(expected));
+			ensure(! dfd.isFrechetWithin(expected * 0.999));
+			ensure_equals(DiscreteFrechetDistance::distance(*g1, *g0), expected);
+		}
+	}
+
+	// 5 - Empty geometries and invalid fractions
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		GeomPtr g0(read("LINESTRING (0 0, 2 0)"));
+		GeomPtr empty(read("LINESTRING EMPTY"));
+		try
+		{
+			DiscreteFrechetDistance::distance(*g0, *empty);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+
+		DiscreteFrechetDistance dfd(*g0, *g0);
+		try
+		{
+			dfd.setDensifyFraction(0);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+		ensure(! dfd.isFrechetWithin(-1));
+	}
+
+} // namespace tut
@@ -4,10 +4,12 @@
 
 
 #include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
 // geos
 #include <geos/platform.h>
 #include <geos/io/WKTReader.h>
 #include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
+#include <geos/algorithm/distance/PointPairDistance.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h> // required for use in auto_ptr
@@ -17,6 +19,7 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace geos {
 	namespace geom {
@@ -34,7 +37,7 @@ namespace tut
 	//
 
 	// Test data, not used
-	struct test_DiscreteHausdorffDistance_data {
+	struct test_DiscreteHausdorffDistance_data : public RandomValues {
 
 	typedef std::auto_ptr<Geometry> GeomPtr;
 
@@ -72,6 +75,62 @@ namespace tut
 		ensure( diff <= TOLERANCE );
 	}
 
+	// A random walk of n steps from x y
+	std::string randomLine(int n, double x, double y)
+	{
+		std::ostringstream wkt;
+		wkt.precision(17);
+		wkt << "LINESTRING (" << x << " " << y;
+		for (int i = 0; i < n; ++i)
+		{
+			x += random() * 10 - 5;
+			y += random() * 10 - 5;
+			wkt << ", " << x << " " << y;
+		}
+		wkt << ")";
+		return wkt.str();
+	}
+
+	// The largest distance from the points of discreteGeom to geom,
+	// measured to every segment
+	static void bruteForceOrientedDistance(const Geometry& discreteGeom,
+	                                       const Geometry& geom,
+	                                       double densifyFrac,
+	                                       PointPairDistance& ptDist)
+	{
+		DiscreteHausdorffDistance::MaxPointDistanceFilter distFilter(geom);
+		discreteGeom.apply_ro(&distFilter);
+		ptDist.setMaximum(distFilter.getMaxPointDistance());
+		if ( densifyFrac > 0 )
+		{
+			DiscreteHausdorffDistance::MaxDensifiedByFractionDistanceFilter
+				fracFilter(geom, densifyFrac);
+			discreteGeom.apply_ro(fracFilter);
+			ptDist.setMaximum(fracFilter.getMaxPointDistance());
+		}
+	}
+
+	// Checks the distance and its points against the brute force
+	// computation, and the threshold tests around it
+	void checkAgainstBruteForce(const Geometry& g0, const Geometry& g1,
+	                            double densifyFrac)
+	{
+		PointPairDistance expected;
+		bruteForceOrientedDistance(g0, g1, densifyFrac, expected);
+		bruteForceOrientedDistance(g1, g0, densifyFrac, expected);
+
+		DiscreteHausdorffDistance hd(g0, g1);
+		if ( densifyFrac > 0 ) hd.setDensifyFraction(densifyFrac);
+		double distance = hd.distance();
+		ensure_equals(distance, expected.getDistance());
+		const std::vector<Coordinate> pts = hd.getCoordinates();
+		ensure_equals(pts[0].distance(pts[1]), distance);
+
+		ensure(hd.isHausdorffWithin(distance));
+		ensure(hd.isHausdorffWithin(distance * 1.01));
+		ensure(! hd.isHausdorffWithin(distance * 0.99));
+	}
+
 	PrecisionModel pm;
 	GeometryFactory gf;
         geos::io::WKTReader reader;
@@ -128,5 +187,49 @@ runTest("LINESTRING (130 0, 0 0, 0 150)", "LINESTRING (10 10, 10 150, 130 10)",
 runTest("LINESTRING (130 0, 0 0, 0 150)", "LINESTRING (10 10, 10 150, 130 10)", 0.5, 70.0);
 	}
 
+	// 5 - Random lines, polygons and points against the distances
+	// to every segment
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		for (int i = 0; i < 10; ++i)
+		{
+			GeomPtr g0(reader.read(randomLine(300, 0, 0)));
+			GeomPtr g1(reader.read(randomLine(200, 10, 5)));
+			checkAgainstBruteForce(*g0, *g1, 0);
+			checkAgainstBruteForce(*g0, *g1, 0.25);
+		}
+
+		GeomPtr line(reader.read(randomLine(500, 0, 0)));
+		GeomPtr poly(line->buffer(3));
+		GeomPtr points(reader.read(
+			"MULTIPOINT ((0 0), (20 -10), (-15 30), (40 40))"));
+		checkAgainstBruteForce(*poly, *line, 0);
+		checkAgainstBruteForce(*line, *poly, 0.1);
+		checkAgainstBruteForce(*points, *line, 0);
+		checkAgainstBruteForce(*points, *poly, 0.5);
+	}
+
+	// 6 - Threshold tests
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		GeomPtr g0(reader.read("LINESTRING (130 0, 0 0, 0 150)"));
+		GeomPtr g1(reader.read("LINESTRING (10 10, 10 150, 130 10)"));
+		ensure(DiscreteHausdorffDistance::isHausdorffWithin(*g0, *g1, 14.2));
+		ensure(! DiscreteHausdorffDistance::isHausdorffWithin(*g0, *g1, 14.1));
+		ensure(DiscreteHausdorffDistance::isHausdorffWithin(*g0, *g1, 0.5, 70.0));
+		ensure(! DiscreteHausdorffDistance::isHausdorffWithin(*g0, *g1, 0.5, 69.9));
+
+		ensure(DiscreteHausdorffDistance::isHausdorffWithin(*g0, *g0, 0));
+		ensure(! DiscreteHausdorffDistance::isHausdorffWithin(*g0, *g1, -1));
+
+		GeomPtr empty(reader.read("LINESTRING EMPTY"));
+		ensure(! DiscreteHausdorffDistance::isHausdorffWithin(*g0, *empty, 1000));
+		ensure(DiscreteHausdorffDistance::isHausdorffWithin(*empty, *empty, 0));
+	}
+
 } // namespace tut
 
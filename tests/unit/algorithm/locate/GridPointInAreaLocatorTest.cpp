@@ -0,0 +1,172 @@
+//
+// Test Suite for geos::algorithm::locate::GridPointInAreaLocator class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/algorithm/locate/GridPointInAreaLocator.h>
+#include <geos/algorithm/PointLocator.h>
+#include <geos/geom/prep/PreparedPolygon.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Location.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <memory>
+#include <string>
+#include <cstddef>
+
+using geos::algorithm::locate::GridPointInAreaLocator;
+using geos::geom::Coordinate;
+using geos::geom::Geometry;
+using geos::geom::Location;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_gridpointinarealocator_data : public RandomValues
+	{
+		typedef std::auto_ptr<Geometry> GeomPtr;
+
+		geos::geom::GeometryFactory factory;
+		geos::io::WKTReader reader;
+
+		test_gridpointinarealocator_data()
+			: reader(&factory)
+		{}
+
+		GeomPtr read(const std::string& wkt)
+		{
+			return GeomPtr(reader.read(wkt));
+		}
+
+		void checkLocation(GridPointInAreaLocator& locator,
+		                   const Geometry& g, const Coordinate& p)
+		{
+			geos::algorithm::PointLocator pointLocator;
+			int expected = pointLocator.locate(p, &g);
+			ensure_equals(locator.locate(&p), expected);
+		}
+
+		// Checks random points around g, its vertices and the
+		// midpoints of its segments
+		void checkLocations(const Geometry& g, int numPoints)
+		{
+			GridPointInAreaLocator locator(g);
+			const geos::geom::Envelope* env = g.getEnvelopeInternal();
+			double w = env->getWidth();
+			double h = env->getHeight();
+			for (int i = 0; i < numPoints; ++i)
+			{
+				Coordinate p(env->getMinX() - w / 10 + random() * w * 1.2,
+				             env->getMinY() - h / 10 + random() * h * 1.2);
+				checkLocation(locator, g, p);
+			}
+
+			std::auto_ptr<geos::geom::CoordinateSequence> pts(g.getCoordinates());
+			for (std::size_t i = 0; i < pts->size(); ++i)
+			{
+				checkLocation(locator, g, pts->getAt(i));
+				if ( i == 0 ) continue;
+				const Coordinate& p0 = pts->getAt(i - 1);
+				const Coordinate& p1 = pts->getAt(i);
+				Coordinate mid((p0.x + p1.x) / 2, (p0.y + p1.y) / 2);
+				checkLocation(locator, g, mid);
+			}
+		}
+	};
+
+	typedef test_group<test_gridpointinarealocator_data> group;
+	typedef group::object object;
+
+	group test_gridpointinarealocator_group("geos::algorithm::locate::GridPointInAreaLocator");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Polygons with holes, and multipolygons
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		checkLocations(*read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"), 500);
+		checkLocations(*read("POLYGON((0 0, 100 0, 100 100, 0 100, 0 0), "
+		                     "(10 10, 40 10, 40 40, 10 40, 10 10), "
+		                     "(60 60, 90 60, 75 90, 60 60))"), 2000);
+		checkLocations(*read("MULTIPOLYGON(((0 0, 10 0, 5 8, 0 0)), "
+		                     "((20 0, 30 0, 30 40, 20 40, 20 0)))"), 2000);
+	}
+
+	// 2 - Many vertices, from a buffer, points on a coarse grid
+	// falling on cell edges and on the segments
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		GeomPtr point(read("POINT(0 0)"));
+		GeomPtr star(point->buffer(100, 200));
+		GeomPtr g(star->difference(read("POLYGON((-50 -50, 50 -50, 0 50, -50 -50))").get()));
+		checkLocations(*g, 5000);
+
+		GridPointInAreaLocator locator(*g);
+		ensure(locator.getNumBoundaryCells() <
+		       locator.getNumCellsX() * locator.getNumCellsY());
+		for (int x = -110; x <= 110; x += 5)
+		{
+			for (int y = -110; y <= 110; y += 5)
+				checkLocation(locator, *g, Coordinate(x, y));
+		}
+	}
+
+	// 3 - Selected by PreparedPolygon, non-polygonal arguments
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		GeomPtr g(read("POLYGON((0 0, 100 0, 100 100, 0 100, 0 0), "
+		               "(10 10, 40 10, 40 40, 10 40, 10 10))"));
+		geos::geom::prep::PreparedPolygon indexed(g.get());
+		geos::geom::prep::PreparedPolygon grid(g.get());
+		grid.setPointLocatorType(geos::geom::prep::PreparedPolygon::GRID_LOCATOR);
+		ensure(grid.getPointLocatorType() ==
+		       geos::geom::prep::PreparedPolygon::GRID_LOCATOR);
+
+		const char* wkts[] = {
+			"POINT(5 5)", "POINT(20 20)", "POINT(10 20)",
+			"MULTIPOINT((5 5), (50 50))", "MULTIPOINT((5 5), (20 20))",
+			"LINESTRING(5 5, 95 95)", "POLYGON((50 50, 60 50, 60 60, 50 50))"
+		};
+		for (std::size_t i = 0; i < sizeof(wkts) / sizeof(wkts[0]); ++i)
+		{
+			GeomPtr other(read(wkts[i]));
+			ensure_equals(grid.contains(other.get()), indexed.contains(other.get()));
+			ensure_equals(grid.covers(other.get()), indexed.covers(other.get()));
+			ensure_equals(grid.intersects(other.get()), indexed.intersects(other.get()));
+		}
+
+		try
+		{
+			GeomPtr line(read("LINESTRING(0 0, 1 1)"));
+			GridPointInAreaLocator locator(*line);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+
+		GeomPtr empty(read("POLYGON EMPTY"));
+		GridPointInAreaLocator emptyLocator(*empty);
+		Coordinate p(0, 0);
+		ensure_equals(emptyLocator.locate(&p), int(Location::EXTERIOR));
+	}
+
+} // namespace tut
@@ -0,0 +1,227 @@
+//
+// Test Suite for geos::algorithm::locate::IndexedPointInAreaLocator class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/algorithm/locate/GridPointInAreaLocator.h>
+#include <geos/algorithm/PointLocator.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Location.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using geos::algorithm::locate::IndexedPointInAreaLocator;
+using geos::algorithm::locate::PointOnGeometryLocator;
+using geos::geom::Coordinate;
+using geos::geom::Geometry;
+using geos::geom::Location;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_indexedpointinarealocator_data : public RandomValues
+	{
+		typedef std::auto_ptr<Geometry> GeomPtr;
+
+		geos::geom::GeometryFactory factory;
+		geos::io::WKTReader reader;
+
+		test_indexedpointinarealocator_data()
+			: reader(&factory)
+		{}
+
+		GeomPtr read(const std::string& wkt)
+		{
+			return GeomPtr(reader.read(wkt));
+		}
+
+		// Random points around g, its vertices and the midpoints of
+		// its segments, as consecutive x and y values
+		std::vector<double> getPoints(const Geometry& g, int numPoints)
+		{
+			std::vector<double> xy;
+			const geos::geom::Envelope* env = g.getEnvelopeInternal();
+			double w = env->getWidth();
+			double h = env->getHeight();
+			for (int i = 0; i < numPoints; ++i)
+			{
+				xy.push_back(env->getMinX() - w / 10 + random() * w * 1.2);
+				xy.push_back(env->getMinY() - h / 10 + random() * h * 1.2);
+			}
+
+			std::auto_ptr<geos::geom::CoordinateSequence> pts(g.getCoordinates());
+			for (std::size_t i = 0; i < pts->size(); ++i)
+			{
+				const Coordinate& p1 = pts->getAt(i);
+				xy.push_back(p1.x);
+				xy.push_back(p1.y);
+				if ( i == 0 ) continue;
+				const Coordinate& p0 = pts->getAt(i - 1);
+				xy.push_back((p0.x + p1.x) / 2);
+				xy.push_back((p0.y + p1.y) / 2);
+			}
+			return xy;
+		}
+
+		// Checks locateAll against PointLocator, on all the points,
+		// on the first ones only, and in parts
+		void checkLocateAll(PointOnGeometryLocator& locator,
+		                    const Geometry& g, const std::vector<double>& xy)
+		{
+			std::size_t n = xy.size() / 2;
+			std::vector<int> locations(n, -1);
+			locator.locateAll(&xy[0], n, &locations[0]);
+
+			std::vector<int> firstLocations(n / 10 + 1, -1);
+			locator.locateAll(&xy[0], firstLocations.size(), &firstLocations[0]);
+
+			std::vector<int> partLocations(n, -1);
+			for (std::size_t part = 0; part < 3; ++part)
+				locator.locateAll(&xy[0], n, &partLocations[0], part, 3);
+
+			geos::algorithm::PointLocator pointLocator;
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				Coordinate p(xy[2 * i], xy[2 * i + 1]);
+				int expected = pointLocator.locate(p, &g);
+				ensure_equals(locations[i], expected);
+				ensure_equals(partLocations[i], expected);
+				ensure_equals(locator.locate(&p), expected);
+				if ( i < firstLocations.size() )
+					ensure_equals(firstLocations[i], expected);
+			}
+		}
+
+		void checkLocations(const Geometry& g, int numPoints)
+		{
+			IndexedPointInAreaLocator locator(g);
+			checkLocateAll(locator, g, getPoints(g, numPoints));
+		}
+	};
+
+	typedef test_group<test_indexedpointinarealocator_data> group;
+	typedef group::object object;
+
+	group test_indexedpointinarealocator_group("geos::algorithm::locate::IndexedPointInAreaLocator");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Polygons with holes, and multipolygons
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		checkLocations(*read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"), 500);
+		checkLocations(*read("POLYGON((0 0, 100 0, 100 100, 0 100, 0 0), "
+		                     "(10 10, 40 10, 40 40, 10 40, 10 10), "
+		                     "(60 60, 90 60, 75 90, 60 60))"), 2000);
+		checkLocations(*read("MULTIPOLYGON(((0 0, 10 0, 5 8, 0 0)), "
+		                     "((20 0, 30 0, 30 40, 20 40, 20 0)))"), 2000);
+	}
+
+	// 2 - Many vertices, from a buffer, points on a coarse grid
+	// falling on the segments, and the default locateAll
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		GeomPtr point(read("POINT(0 0)"));
+		GeomPtr star(point->buffer(100, 200));
+		GeomPtr g(star->difference(read("POLYGON((-50 -50, 50 -50, 0 50, -50 -50))").get()));
+		checkLocations(*g, 5000);
+
+		std::vector<double> xy;
+		for (int x = -110; x <= 110; x += 5)
+		{
+			for (int y = -110; y <= 110; y += 5)
+			{
+				xy.push_back(x);
+				xy.push_back(y);
+			}
+		}
+		IndexedPointInAreaLocator locator(*g);
+		checkLocateAll(locator, *g, xy);
+
+		geos::algorithm::locate::GridPointInAreaLocator gridLocator(*g);
+		checkLocateAll(gridLocator, *g, xy);
+	}
+
+	// 3 - Flat and empty geometries, no points
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		GeomPtr flat(read("POLYGON((0 0, 10 0, 20 0, 0 0))"));
+		std::vector<double> xy;
+		for (int x = -5; x <= 25; ++x)
+		{
+			xy.push_back(x);
+			xy.push_back(0);
+			xy.push_back(x);
+			xy.push_back(1);
+		}
+		IndexedPointInAreaLocator flatLocator(*flat);
+		checkLocateAll(flatLocator, *flat, xy);
+
+		GeomPtr empty(read("POLYGON EMPTY"));
+		IndexedPointInAreaLocator emptyLocator(*empty);
+		int location = -1;
+		emptyLocator.locateAll(&xy[0], 1, &location);
+		ensure_equals(location, int(Location::EXTERIOR));
+		emptyLocator.locateAll(&xy[0], 0, &location);
+	}
+
+	// 4 - Parts out of range
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		GeomPtr g(read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"));
+		double xy[] = { 5, 5 };
+		int location = -1;
+
+		IndexedPointInAreaLocator locator(*g);
+		try
+		{
+			locator.locateAll(xy, 1, &location, 1, 1);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+
+		geos::algorithm::locate::GridPointInAreaLocator gridLocator(*g);
+		try
+		{
+			gridLocator.locateAll(xy, 1, &location, 2, 1);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+		ensure_equals(location, -1);
+
+		// more parts than points
+		locator.locateAll(xy, 1, &location, 0, 2);
+		ensure_equals(location, -1);
+		locator.locateAll(xy, 1, &location, 1, 2);
+		ensure_equals(location, int(Location::INTERIOR));
+	}
+
+} // namespace tut
@@ -0,0 +1,106 @@
+// 
+// Test Suite for C-API GEOSDWithin
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosdwithin_data
+    {
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeosdwithin_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeosdwithin_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            geom1_ = 0;
+            geom2_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeosdwithin_data> group;
+    typedef group::object object;
+
+    group test_capigeosdwithin_group("capi::GEOSDWithin");
+
+    //
+    // Test Cases
+    //
+
+    // Points and lines
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("POINT(10 10)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING(0 0, 20 0)");
+
+        ensure_equals(GEOSDWithin(geom1_, geom2_, 10.0), 1);
+        ensure_equals(GEOSDWithin(geom1_, geom2_, 9.99), 0);
+        ensure_equals(GEOSDWithin(geom2_, geom1_, 10.0), 1);
+    }
+
+    // A line inside a polygon, far from its boundary
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 100 0, 100 100, 0 100, 0 0))");
+        geom2_ = GEOSGeomFromWKT("LINESTRING(40 40, 60 60)");
+
+        ensure_equals(GEOSDWithin(geom1_, geom2_, 0.0), 1);
+        ensure_equals(GEOSDWithin(geom2_, geom1_, 0.0), 1);
+
+        GEOSGeom_destroy(geom2_);
+        geom2_ = GEOSGeomFromWKT("LINESTRING(140 40, 160 60)");
+        ensure_equals(GEOSDWithin(geom1_, geom2_, 40.0), 1);
+        ensure_equals(GEOSDWithin(geom1_, geom2_, 39.0), 0);
+    }
+
+    // Empty geometries are within no distance of anything
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        geom1_ = GEOSGeomFromWKT("POINT(10 10)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING EMPTY");
+
+        ensure_equals(GEOSDWithin(geom1_, geom2_, 1000.0), 0);
+        ensure_equals(GEOSDWithin(geom2_, geom1_, 1000.0), 0);
+        ensure_equals(GEOSDWithin(geom2_, geom2_, 0.0), 0);
+    }
+
+} // namespace tut
+
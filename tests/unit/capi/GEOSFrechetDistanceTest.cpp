@@ -0,0 +1,97 @@
+// 
+// Test Suite for C-API GEOSFrechetDistance
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosfrechetdistance_data
+    {
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeosfrechetdistance_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeosfrechetdistance_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            geom1_ = 0;
+            geom2_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeosfrechetdistance_data> group;
+    typedef group::object object;
+
+    group test_capigeosfrechetdistance_group("capi::GEOSFrechetDistance");
+
+    //
+    // Test Cases
+    //
+
+    // Distances and threshold tests
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (0 0, 100 0)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING (0 0, 50 50, 100 0)");
+
+        double dist;
+        ensure_equals(GEOSFrechetDistance(geom1_, geom2_, &dist), 1);
+        ensure_distance(dist, 70.710678118654755, 1e-12);
+        ensure_equals(GEOSFrechetDistanceWithin(geom1_, geom2_, dist), 1);
+        ensure_equals(GEOSFrechetDistanceWithin(geom1_, geom2_, 70.7), 0);
+
+        ensure_equals(GEOSFrechetDistanceDensify(geom1_, geom2_, 0.5, &dist), 1);
+        ensure_distance(dist, 50.0, 1e-12);
+        ensure_equals(GEOSFrechetDistanceDensifyWithin(geom1_, geom2_, 0.5, 50.0), 1);
+        ensure_equals(GEOSFrechetDistanceDensifyWithin(geom1_, geom2_, 0.5, 49.9), 0);
+    }
+
+    // Empty geometries and invalid densify fractions
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (0 0, 2 1)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING EMPTY");
+
+        double dist;
+        ensure_equals(GEOSFrechetDistance(geom1_, geom2_, &dist), 0);
+        ensure_equals(GEOSFrechetDistanceWithin(geom1_, geom2_, 1.0), 2);
+        ensure_equals(GEOSFrechetDistanceDensifyWithin(geom1_, geom1_, 2.0, 1.0), 2);
+    }
+
+} // namespace tut
+
@@ -0,0 +1,94 @@
+// 
+// Test Suite for C-API GEOSHausdorffDistance
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeoshausdorffdistance_data
+    {
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeoshausdorffdistance_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeoshausdorffdistance_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            geom1_ = 0;
+            geom2_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeoshausdorffdistance_data> group;
+    typedef group::object object;
+
+    group test_capigeoshausdorffdistance_group("capi::GEOSHausdorffDistance");
+
+    //
+    // Test Cases
+    //
+
+    // Distances and threshold tests
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (130 0, 0 0, 0 150)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING (10 10, 10 150, 130 10)");
+
+        double dist;
+        ensure_equals(GEOSHausdorffDistance(geom1_, geom2_, &dist), 1);
+        ensure_distance(dist, 14.142135623730951, 1e-12);
+        ensure_equals(GEOSHausdorffDistanceWithin(geom1_, geom2_, dist), 1);
+        ensure_equals(GEOSHausdorffDistanceWithin(geom1_, geom2_, 14.1), 0);
+
+        ensure_equals(GEOSHausdorffDistanceDensify(geom1_, geom2_, 0.5, &dist), 1);
+        ensure_distance(dist, 70.0, 1e-12);
+        ensure_equals(GEOSHausdorffDistanceDensifyWithin(geom1_, geom2_, 0.5, 70.0), 1);
+        ensure_equals(GEOSHausdorffDistanceDensifyWithin(geom1_, geom2_, 0.5, 69.9), 0);
+    }
+
+    // Invalid densify fraction
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (0 0, 2 1)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING (0 0, 2 0)");
+
+        ensure_equals(GEOSHausdorffDistanceDensifyWithin(geom1_, geom2_, 2.0, 1.0), 2);
+    }
+
+} // namespace tut
+
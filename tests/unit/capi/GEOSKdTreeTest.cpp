@@ -0,0 +1,126 @@
+//
+// Test Suite for C-API GEOSKdTree
+//
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeoskdtree_data
+    {
+        struct Found
+        {
+            double x, y;
+            unsigned int count;
+            void *item;
+        };
+
+        std::vector<Found> found_;
+        GEOSKdTree* tree_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+
+            std::fprintf(stdout, "\n");
+        }
+
+        static void collect(double x, double y, unsigned int count,
+                            void *item, void *userdata)
+        {
+            test_capigeoskdtree_data* data =
+                static_cast<test_capigeoskdtree_data*>(userdata);
+            Found f = { x, y, count, item };
+            data->found_.push_back(f);
+        }
+
+        test_capigeoskdtree_data()
+            : tree_(0)
+        {
+            initGEOS(notice, notice);
+        }
+
+        ~test_capigeoskdtree_data()
+        {
+            GEOSKdTree_destroy(tree_);
+            tree_ = 0;
+            finishGEOS();
+        }
+
+        int query(const char* wkt)
+        {
+            found_.clear();
+            GEOSGeometry* g = GEOSGeomFromWKT(wkt);
+            int n = GEOSKdTree_query(tree_, g, collect, this);
+            GEOSGeom_destroy(g);
+            return n;
+        }
+    };
+
+    typedef test_group<test_capigeoskdtree_data> group;
+    typedef group::object object;
+
+    group test_capigeoskdtree_group("capi::GEOSKdTree");
+
+    //
+    // Test Cases
+    //
+
+    // Points snapped within the tolerance
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        int a, b;
+        tree_ = GEOSKdTree_create(0.5);
+        ensure(tree_ != 0);
+
+        ensure_equals(GEOSKdTree_insert(tree_, 0, 0, &a), 1u);
+        ensure_equals(GEOSKdTree_insert(tree_, 0.3, 0.1, &b), 2u);
+        ensure_equals(GEOSKdTree_insert(tree_, 10, 10, &b), 1u);
+        ensure_equals(GEOSKdTree_insert(tree_, 0, 0, 0), 3u);
+
+        ensure_equals(query("POLYGON((-1 -1, 1 -1, 1 1, -1 1, -1 -1))"), 1);
+        ensure_equals(found_.size(), 1u);
+        ensure_equals(found_[0].x, 0.0);
+        ensure_equals(found_[0].y, 0.0);
+        ensure_equals(found_[0].count, 3u);
+        ensure(found_[0].item == &a);
+
+        ensure_equals(query("LINESTRING(0 0, 10 10)"), 2);
+        ensure_equals(query("POINT(5 5)"), 0);
+    }
+
+    // Equal points only with a zero tolerance
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        tree_ = GEOSKdTree_create(0);
+        for (int i = 0; i < 100; ++i)
+        {
+            ensure_equals(GEOSKdTree_insert(tree_, i % 10, 0, 0),
+                          unsigned(i / 10 + 1));
+        }
+        ensure_equals(query("LINESTRING(0 0, 4.5 0)"), 5);
+        for (std::size_t i = 0; i < found_.size(); ++i)
+            ensure_equals(found_[i].count, 10u);
+    }
+
+} // namespace tut
@@ -0,0 +1,98 @@
+// 
+// Test Suite for C-API GEOSPreparedLocatePoints
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeospreparedlocatepoints_data
+    {
+        GEOSGeometry* geom_;
+        const GEOSPreparedGeometry* prepGeom_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeospreparedlocatepoints_data()
+            : geom_(0), prepGeom_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeospreparedlocatepoints_data()
+        {
+            GEOSPreparedGeom_destroy(prepGeom_);
+            GEOSGeom_destroy(geom_);
+            prepGeom_ = 0;
+            geom_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeospreparedlocatepoints_data> group;
+    typedef group::object object;
+
+    group test_capigeospreparedlocatepoints_group("capi::GEOSPreparedLocatePoints");
+
+    //
+    // Test Cases
+    //
+
+    // A polygon with a hole
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom_ = GEOSGeomFromWKT("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0), "
+                                "(4 4, 6 4, 6 6, 4 6, 4 4))");
+        prepGeom_ = GEOSPrepare(geom_);
+
+        const double xy[] = { 1, 1,  5, 5,  0, 5,  6, 5,  20, 5,  5, -1 };
+        int locations[6];
+        ensure_equals(GEOSPreparedLocatePoints(prepGeom_, xy, 6, locations), 1);
+
+        ensure_equals(locations[0], GEOSLOC_INTERIOR);
+        ensure_equals(locations[1], GEOSLOC_EXTERIOR);
+        ensure_equals(locations[2], GEOSLOC_BOUNDARY);
+        ensure_equals(locations[3], GEOSLOC_BOUNDARY);
+        ensure_equals(locations[4], GEOSLOC_EXTERIOR);
+        ensure_equals(locations[5], GEOSLOC_EXTERIOR);
+
+        ensure_equals(GEOSPreparedLocatePoints(prepGeom_, xy, 0, locations), 1);
+    }
+
+    // Non-polygonal geometries are refused
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom_ = GEOSGeomFromWKT("LINESTRING(0 0, 10 10)");
+        prepGeom_ = GEOSPrepare(geom_);
+
+        const double xy[] = { 1, 1 };
+        int location;
+        ensure_equals(GEOSPreparedLocatePoints(prepGeom_, xy, 1, &location), 0);
+    }
+
+} // namespace tut
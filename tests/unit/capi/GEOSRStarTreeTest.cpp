@@ -0,0 +1,127 @@
+//
+// Test Suite for C-API GEOSRStarTree
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosrstartree_data
+    {
+        std::vector<GEOSGeometry*> geoms_;
+        std::vector<GEOSGeometry*> found_;
+        GEOSRStarTree* tree_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+
+            std::fprintf(stdout, "\n");
+        }
+
+        static void collect(void *item, void *userdata)
+        {
+            test_capigeosrstartree_data* data =
+                static_cast<test_capigeosrstartree_data*>(userdata);
+            data->found_.push_back(static_cast<GEOSGeometry*>(item));
+        }
+
+        test_capigeosrstartree_data()
+            : tree_(0)
+        {
+            initGEOS(notice, notice);
+            tree_ = GEOSRStarTree_create(4);
+        }
+
+        ~test_capigeosrstartree_data()
+        {
+            GEOSRStarTree_destroy(tree_);
+            for (std::size_t i = 0; i < geoms_.size(); ++i)
+                GEOSGeom_destroy(geoms_[i]);
+            tree_ = 0;
+            finishGEOS();
+        }
+
+        GEOSGeometry* geom(const char* wkt)
+        {
+            GEOSGeometry* g = GEOSGeomFromWKT(wkt);
+            geoms_.push_back(g);
+            return g;
+        }
+
+        GEOSGeometry* insert(const char* wkt)
+        {
+            GEOSGeometry* g = geom(wkt);
+            GEOSRStarTree_insert(tree_, g, g);
+            return g;
+        }
+
+        void query(GEOSGeometry* g)
+        {
+            found_.clear();
+            GEOSRStarTree_query(tree_, g, collect, this);
+            std::sort(found_.begin(), found_.end());
+        }
+
+    };
+
+    typedef test_group<test_capigeosrstartree_data> group;
+    typedef group::object object;
+
+    group test_capigeosrstartree_group("capi::GEOSRStarTree");
+
+    //
+    // Test Cases
+    //
+
+    // Queries between inserts and removes
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        GEOSGeometry* line = insert("LINESTRING(0 0, 10 10)");
+        GEOSGeometry* point = insert("POINT(20 0)");
+        GEOSGeometry* box = geom("POLYGON((5 0, 25 0, 25 5, 5 5, 5 0))");
+
+        query(box);
+        ensure_equals(found_.size(), 2u);
+
+        ensure_equals(GEOSRStarTree_remove(tree_, line, line), 1);
+        ensure_equals(GEOSRStarTree_remove(tree_, line, line), 0);
+        query(box);
+        ensure_equals(found_.size(), 1u);
+        ensure(found_[0] == point);
+
+        GEOSGeometry* near = insert("POINT(6 4)");
+        for (int i = 0; i < 20; ++i) insert("POINT(100 100)");
+        query(box);
+        ensure_equals(found_.size(), 2u);
+        ensure(std::find(found_.begin(), found_.end(), near) != found_.end());
+    }
+
+    // An invalid node capacity
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        ensure(GEOSRStarTree_create(1) == 0);
+    }
+
+} // namespace tut
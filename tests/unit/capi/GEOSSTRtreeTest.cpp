@@ -0,0 +1,276 @@
+// 
+// Test Suite for C-API GEOSSTRtree
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosstrtree_data
+    {
+        std::vector<GEOSGeometry*> geoms_;
+        std::vector<GEOSGeometry*> found_;
+        std::vector<GEOSItemId> ids_;
+        GEOSSTRtree* tree_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        static int distance(const void *item1, const void *item2,
+                            double *d, void *)
+        {
+            return GEOSDistance(static_cast<const GEOSGeometry*>(item1),
+                                static_cast<const GEOSGeometry*>(item2), d);
+        }
+
+        static int failingDistance(const void *, const void *,
+                                   double *, void *)
+        {
+            return 0;
+        }
+
+        static GEOSItemId itemId(const void *item, void *userdata)
+        {
+            test_capigeosstrtree_data* data =
+                static_cast<test_capigeosstrtree_data*>(userdata);
+            for (std::size_t i = 0; i < data->geoms_.size(); ++i)
+                if ( data->geoms_[i] == item ) return 1000 + i;
+            return -1;
+        }
+
+        static void collectId(GEOSItemId id, void *userdata)
+        {
+            test_capigeosstrtree_data* data =
+                static_cast<test_capigeosstrtree_data*>(userdata);
+            data->ids_.push_back(id);
+        }
+
+        static void collectMany(unsigned int queryIndex, void *item,
+                                void *userdata)
+        {
+            test_capigeosstrtree_data* data =
+                static_cast<test_capigeosstrtree_data*>(userdata);
+            data->ids_.push_back(queryIndex);
+            data->found_.push_back(static_cast<GEOSGeometry*>(item));
+        }
+
+        static void collect(void *item, void *userdata)
+        {
+            test_capigeosstrtree_data* data =
+                static_cast<test_capigeosstrtree_data*>(userdata);
+            data->found_.push_back(static_cast<GEOSGeometry*>(item));
+        }
+
+        test_capigeosstrtree_data()
+            : tree_(0)
+        {
+            initGEOS(notice, notice);
+            tree_ = GEOSSTRtree_create(4);
+        }       
+
+        ~test_capigeosstrtree_data()
+        {
+            GEOSSTRtree_destroy(tree_);
+            for (std::size_t i = 0; i < geoms_.size(); ++i)
+                GEOSGeom_destroy(geoms_[i]);
+            tree_ = 0;
+            finishGEOS();
+        }
+
+        GEOSGeometry* geom(const char* wkt)
+        {
+            GEOSGeometry* g = GEOSGeomFromWKT(wkt);
+            geoms_.push_back(g);
+            return g;
+        }
+
+        GEOSGeometry* insert(const char* wkt)
+        {
+            GEOSGeometry* g = geom(wkt);
+            GEOSSTRtree_insert(tree_, g, g);
+            return g;
+        }
+
+    };
+
+    typedef test_group<test_capigeosstrtree_data> group;
+    typedef group::object object;
+
+    group test_capigeosstrtree_group("capi::GEOSSTRtree");
+
+    //
+    // Test Cases
+    //
+
+    // GEOSSTRtree_nearest visits the nearest items first
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        GEOSGeometry* line = insert("LINESTRING(0 0, 10 10)");
+        GEOSGeometry* far = insert("POINT(20 0)");
+        GEOSGeometry* near = insert("POINT(6 4)");
+        insert("POINT(100 100)");
+
+        // the envelope of the line is nearer than the point,
+        // but the line itself is farther
+        GEOSGeometry* query = GEOSGeomFromWKT("POINT(9 0)");
+        geoms_.push_back(query);
+
+        int ret = GEOSSTRtree_nearest(tree_, query, query, 3,
+                                      distance, collect, this);
+        ensure_equals(ret, 3);
+        ensure_equals(found_.size(), 3u);
+        ensure(found_[0] == near);
+        ensure(found_[1] == line);
+        ensure(found_[2] == far);
+    }
+
+    // GEOSSTRtree_nearest fails with the distance callback
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        insert("POINT(1 1)");
+        GEOSGeometry* query = GEOSGeomFromWKT("POINT(0 0)");
+        geoms_.push_back(query);
+
+        int ret = GEOSSTRtree_nearest(tree_, query, query, 1,
+                                      failingDistance, collect, this);
+        ensure_equals(ret, -1);
+        ensure(found_.empty());
+    }
+
+    // GEOSSTRtree_write saves a tree for GEOSMappedSTRtree_open
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        const char* filename = "capi_strtree_test.bin";
+        insert("LINESTRING(0 0, 10 10)");
+        insert("POINT(20 0)");
+        insert("POINT(6 4)");
+        GEOSGeometry* query = GEOSGeomFromWKT("POLYGON((5 0, 25 0, 25 5, 5 5, 5 0))");
+        geoms_.push_back(query);
+
+        ensure_equals(GEOSSTRtree_write(tree_, filename, itemId, this), 1);
+        GEOSMappedSTRtree* mapped = GEOSMappedSTRtree_open(filename);
+        std::remove(filename);
+        ensure(mapped != 0);
+
+        int ret = GEOSMappedSTRtree_query(mapped, query, collectId, this);
+        GEOSMappedSTRtree_destroy(mapped);
+
+        ensure_equals(ret, 3);
+        std::sort(ids_.begin(), ids_.end());
+        ensure_equals(ids_[0], 1000);
+        ensure_equals(ids_[1], 1001);
+        ensure_equals(ids_[2], 1002);
+
+        ensure(GEOSMappedSTRtree_open("no/such/file") == 0);
+    }
+
+    // Queries of an explicitly built tree
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        GEOSGeometry* line = insert("LINESTRING(0 0, 10 10)");
+        insert("POINT(20 20)");
+        GEOSGeometry* query = GEOSGeomFromWKT("POINT(5 5)");
+        geoms_.push_back(query);
+
+        ensure_equals(GEOSSTRtree_build(tree_), 1);
+        ensure_equals(GEOSSTRtree_build(tree_), 1);
+
+        GEOSSTRtree_query(tree_, query, collect, this);
+        ensure_equals(found_.size(), 1u);
+        ensure(found_[0] == line);
+    }
+
+    // Batches of queries
+    template<>
+    template<>
+    void object::test<5>()
+    {
+        GEOSGeometry* line = insert("LINESTRING(0 0, 10 10)");
+        GEOSGeometry* point = insert("POINT(20 20)");
+        const GEOSGeometry* queries[3];
+        queries[0] = geom("POINT(20 20)");
+        queries[1] = 0;
+        queries[2] = geom("POINT(5 5)");
+
+        std::size_t count = 0;
+        int ret = GEOSSTRtree_query_many(tree_, queries, 3, collectMany, this,
+                                         &count);
+        ensure_equals(ret, 1);
+        ensure_equals(count, 2u);
+        ensure_equals(found_.size(), 2u);
+        for (std::size_t i = 0; i < found_.size(); ++i)
+        {
+            if ( ids_[i] == 0 ) ensure(found_[i] == point);
+            else ensure(ids_[i] == 2 && found_[i] == line);
+        }
+
+        ret = GEOSSTRtree_query_many(tree_, queries, 3, collectMany, this, 0);
+        ensure_equals(ret, 1);
+        ensure_equals(found_.size(), 4u);
+    }
+
+    // Shape of the tree and work of a query
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        GEOSGeometry* line = insert("LINESTRING(0 0, 10 10)");
+        insert("POINT(20 20)");
+        GEOSGeometry* query = geom("POINT(5 5)");
+
+        unsigned int nodesVisited = 0;
+        unsigned int leavesTested = 0;
+        int ret = GEOSSTRtree_query_statistics(tree_, query, collect, this,
+                                               &nodesVisited, &leavesTested);
+        ensure_equals(ret, 1);
+        ensure_equals(found_.size(), 1u);
+        ensure(found_[0] == line);
+        ensure_equals(nodesVisited, 1u);
+        ensure_equals(leavesTested, 1u);
+
+        unsigned int depth = 0;
+        unsigned int numNodes = 0;
+        double fillFactor = 0;
+        double overlapArea = -1;
+        size_t memorySize = 0;
+        ensure_equals(GEOSSTRtree_statistics(tree_, &depth, &numNodes,
+                                             &fillFactor, &overlapArea,
+                                             &memorySize), 1);
+        ensure_equals(depth, 1u);
+        ensure_equals(numNodes, 1u);
+        ensure(fillFactor > 0);
+        ensure_equals(overlapArea, 0.0);
+        ensure(memorySize > 0);
+        ensure_equals(GEOSSTRtree_statistics(tree_, 0, 0, 0, 0, 0), 1);
+    }
+
+} // namespace tut
@@ -0,0 +1,126 @@
+//
+// Test Suite for C-API GEOSSpatialJoin
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosspatialjoin_data
+    {
+        std::vector<GEOSGeometry*> geoms_;
+        std::vector< std::pair<unsigned int, unsigned int> > pairs_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+
+            std::fprintf(stdout, "\n");
+        }
+
+        static void collect(unsigned int index1, unsigned int index2,
+                            void *userdata)
+        {
+            test_capigeosspatialjoin_data* data =
+                static_cast<test_capigeosspatialjoin_data*>(userdata);
+            data->pairs_.push_back(std::make_pair(index1, index2));
+        }
+
+        test_capigeosspatialjoin_data()
+        {
+            initGEOS(notice, notice);
+        }
+
+        ~test_capigeosspatialjoin_data()
+        {
+            for (std::size_t i = 0; i < geoms_.size(); ++i)
+                GEOSGeom_destroy(geoms_[i]);
+            finishGEOS();
+        }
+
+        GEOSGeometry* geom(const char* wkt)
+        {
+            GEOSGeometry* g = GEOSGeomFromWKT(wkt);
+            geoms_.push_back(g);
+            return g;
+        }
+
+    };
+
+    typedef test_group<test_capigeosspatialjoin_data> group;
+    typedef group::object object;
+
+    group test_capigeosspatialjoin_group("capi::GEOSSpatialJoin");
+
+    //
+    // Test Cases
+    //
+
+    // Points within polygons
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        const GEOSGeometry* points[4];
+        points[0] = geom("POINT(1 1)");
+        points[1] = geom("POINT(10 10)");
+        points[2] = geom("POINT(5 0)");
+        points[3] = geom("POINT(15 15)");
+
+        const GEOSGeometry* polygons[2];
+        polygons[0] = geom("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+        polygons[1] = geom("POLYGON((9 9, 20 9, 20 20, 9 20, 9 9))");
+
+        int count = GEOSSpatialJoin(points, 4, polygons, 2,
+                                    GEOSJOIN_WITHIN, collect, this);
+        ensure_equals(count, 3);
+        ensure_equals(pairs_.size(), 3u);
+        std::sort(pairs_.begin(), pairs_.end());
+        ensure(pairs_[0] == std::make_pair(0u, 0u));
+        ensure(pairs_[1] == std::make_pair(1u, 1u));
+        ensure(pairs_[2] == std::make_pair(3u, 1u));
+
+        pairs_.clear();
+        count = GEOSSpatialJoin(points, 4, polygons, 2,
+                                GEOSJOIN_COVEREDBY, collect, this);
+        ensure_equals(count, 5);
+
+        pairs_.clear();
+        count = GEOSSpatialJoin(polygons, 2, points, 4,
+                                GEOSJOIN_CONTAINS, collect, this);
+        ensure_equals(count, 3);
+        std::sort(pairs_.begin(), pairs_.end());
+        ensure(pairs_[0] == std::make_pair(0u, 0u));
+    }
+
+    // An invalid predicate
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        const GEOSGeometry* points[1];
+        points[0] = geom("POINT(1 1)");
+        ensure_equals(GEOSSpatialJoin(points, 1, points, 1, 99,
+                                      collect, this), -1);
+        ensure(pairs_.empty());
+    }
+
+} // namespace tut
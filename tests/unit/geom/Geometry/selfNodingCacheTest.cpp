@@ -0,0 +1,152 @@
+//
+// Test Suite for Geometry's self-noding cache
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/IntersectionMatrix.h>
+#include <geos/geomgraph/GeometryGraph.h>
+#include <geos/geomgraph/SelfNodingCache.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <string>
+
+namespace tut {
+
+//
+// Test Group
+//
+
+struct test_selfnodingcache_data
+{
+	typedef std::auto_ptr<geos::geom::Geometry> GeomAutoPtr;
+	geos::geom::GeometryFactory factory;
+	geos::io::WKTReader reader;
+
+	test_selfnodingcache_data()
+	    : reader(&factory)
+	{}
+
+	// Tells whether a self-noding is cached for g with the given mode
+	bool isCached(const geos::geom::Geometry& g, bool testAllSegments)
+	{
+		using geos::geomgraph::GeometryGraph;
+		using geos::geomgraph::index::SegmentIntersector;
+
+		GeometryGraph graph(0, &g);
+		geos::algorithm::LineIntersector li;
+		SegmentIntersector si(&li, true, false);
+		return g.getSelfNodingCache()->restore(*graph.getEdges(), li,
+		                                       testAllSegments, si);
+	}
+};
+
+typedef test_group<test_selfnodingcache_data> group;
+typedef group::object object;
+
+group test_selfnodingcache_group("geos::geom::Geometry::selfNodingCache");
+
+//
+// Test Cases
+//
+
+// 1 - Disabled by default, enabling and disabling
+template<>
+template<>
+void object::test<1>()
+{
+	GeomAutoPtr g(reader.read("LINESTRING (0 0, 10 10, 10 0, 0 10)"));
+
+	ensure(0 == g->getSelfNodingCache());
+	g->setSelfNodingCacheEnabled(true);
+	ensure(0 != g->getSelfNodingCache());
+	ensure(!isCached(*g, true));
+	g->setSelfNodingCacheEnabled(false);
+	ensure(0 == g->getSelfNodingCache());
+}
+
+// 2 - Validity is the same when computed from the cache
+template<>
+template<>
+void object::test<2>()
+{
+	GeomAutoPtr g(reader.read(
+		"POLYGON ((0 0, 10 10, 10 0, 0 10, 0 0))"
+	));
+	g->setSelfNodingCacheEnabled(true);
+
+	ensure(!g->isValid());
+	ensure(isCached(*g, true));
+	ensure(!isCached(*g, false));
+	ensure(!g->isValid());
+}
+
+// 3 - Simplicity is the same when computed from the cache
+template<>
+template<>
+void object::test<3>()
+{
+	GeomAutoPtr crossing(reader.read("LINESTRING (0 0, 10 10, 10 0, 0 10)"));
+	GeomAutoPtr simple(reader.read("LINESTRING (0 0, 10 10, 20 0)"));
+	crossing->setSelfNodingCacheEnabled(true);
+	simple->setSelfNodingCacheEnabled(true);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		ensure(!crossing->isSimple());
+		ensure(simple->isSimple());
+	}
+}
+
+// 4 - Relate and overlay match the results with no cache
+template<>
+template<>
+void object::test<4>()
+{
+	using geos::geom::IntersectionMatrix;
+
+	GeomAutoPtr a(reader.read(
+		"POLYGON ((0 0, 0 10, 4 10, 4 6, 6 6, 6 10, 10 10, 10 0, 0 0))"
+	));
+	GeomAutoPtr b(reader.read(
+		"POLYGON ((2 2, 2 8, 8 8, 8 2, 2 2))"
+	));
+	GeomAutoPtr plain(a->clone());
+	ensure(0 == plain->getSelfNodingCache());
+
+	a->setSelfNodingCacheEnabled(true);
+	std::auto_ptr<IntersectionMatrix> expectedIM(plain->relate(b.get()));
+	GeomAutoPtr expected(plain->intersection(b.get()));
+
+	for (int i = 0; i < 2; ++i)
+	{
+		std::auto_ptr<IntersectionMatrix> im(a->relate(b.get()));
+		ensure_equals(im->toString(), expectedIM->toString());
+		GeomAutoPtr result(a->intersection(b.get()));
+		ensure(result->equalsExact(expected.get()));
+	}
+	ensure(isCached(*a, false));
+}
+
+// 5 - geometryChanged() drops the cache contents
+template<>
+template<>
+void object::test<5>()
+{
+	GeomAutoPtr g(reader.read("LINESTRING (0 0, 10 10, 10 0, 0 10)"));
+	g->setSelfNodingCacheEnabled(true);
+
+	ensure(!g->isSimple());
+	ensure(isCached(*g, true));
+	g->geometryChanged();
+	ensure(0 != g->getSelfNodingCache());
+	ensure(!isCached(*g, true));
+}
+
+} // namespace tut
+
@@ -0,0 +1,190 @@
+//
+// Test Suite for geos::geomgraph::index::STRtreeEdgeSetIntersector class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/geomgraph/index/STRtreeEdgeSetIntersector.h>
+#include <geos/geomgraph/index/SimpleMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/geomgraph/GeometryGraph.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/EdgeIntersection.h>
+#include <geos/geomgraph/EdgeIntersectionList.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/IntersectionMatrix.h>
+#include <geos/operation/relate/RelateOp.h>
+#include <geos/operation/overlay/OverlayOp.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <string>
+#include <vector>
+#include <iterator>
+
+namespace tut {
+
+//
+// Test Group
+//
+
+struct test_strtreeedgesetintersector_data
+{
+	typedef std::auto_ptr<geos::geom::Geometry> GeomAutoPtr;
+	typedef std::vector<geos::geomgraph::Edge*> EdgeVect;
+
+	geos::geom::GeometryFactory factory;
+	geos::io::WKTReader reader;
+
+	test_strtreeedgesetintersector_data()
+	    : reader(&factory)
+	{}
+
+	// The intersections on the edges and the findings of si
+	// must be the same with both
+	void ensureSameResults(const EdgeVect& edges0,
+	                       geos::geomgraph::index::SegmentIntersector& si0,
+	                       const EdgeVect& edges1,
+	                       geos::geomgraph::index::SegmentIntersector& si1)
+	{
+		using geos::geomgraph::EdgeIntersectionList;
+
+		ensure_equals(si0.hasIntersection(), si1.hasIntersection());
+		ensure_equals(si0.hasProperIntersection(),
+		              si1.hasProperIntersection());
+		ensure_equals(si0.hasProperInteriorIntersection(),
+		              si1.hasProperInteriorIntersection());
+
+		ensure_equals(edges0.size(), edges1.size());
+		for (std::size_t i = 0; i < edges0.size(); ++i)
+		{
+			EdgeIntersectionList& l0 = edges0[i]->getEdgeIntersectionList();
+			EdgeIntersectionList& l1 = edges1[i]->getEdgeIntersectionList();
+			ensure_equals(std::distance(l0.begin(), l0.end()),
+			              std::distance(l1.begin(), l1.end()));
+			EdgeIntersectionList::const_iterator it0 = l0.begin();
+			EdgeIntersectionList::const_iterator it1 = l1.begin();
+			for (; it0 != l0.end(); ++it0, ++it1)
+			{
+				ensure_equals((*it0)->segmentIndex, (*it1)->segmentIndex);
+				ensure((*it0)->coord.equals2D((*it1)->coord));
+			}
+		}
+	}
+
+	void ensureSameSelfNodes(const std::string& wkt, bool testAllSegments)
+	{
+		using geos::geomgraph::GeometryGraph;
+		using geos::geomgraph::index::SegmentIntersector;
+		using namespace geos::geomgraph::index;
+
+		GeomAutoPtr g(reader.read(wkt));
+		geos::algorithm::LineIntersector li;
+
+		GeometryGraph graph0(0, g.get());
+		SegmentIntersector si0(&li, true, false);
+		SimpleMCSweepLineIntersector sweep;
+		sweep.computeIntersections(graph0.getEdges(), &si0, testAllSegments);
+
+		GeometryGraph graph1(0, g.get());
+		SegmentIntersector si1(&li, true, false);
+		STRtreeEdgeSetIntersector tree(2);
+		tree.computeIntersections(graph1.getEdges(), &si1, testAllSegments);
+
+		ensureSameResults(*graph0.getEdges(), si0, *graph1.getEdges(), si1);
+	}
+};
+
+typedef test_group<test_strtreeedgesetintersector_data> group;
+typedef group::object object;
+
+group test_strtreeedgesetintersector_group("geos::geomgraph::index::STRtreeEdgeSetIntersector");
+
+//
+// Test Cases
+//
+
+// 1 - Self intersections match the sweep line ones
+template<>
+template<>
+void object::test<1>()
+{
+	ensureSameSelfNodes("LINESTRING (0 0, 10 10, 10 0, 0 10, 5 -5, 5 15)", true);
+	ensureSameSelfNodes("LINESTRING (0 0, 10 10, 10 0, 0 10, 5 -5, 5 15)", false);
+	ensureSameSelfNodes("MULTILINESTRING ((0 0, 100 1, 0 2, 100 3, 0 4), "
+	                    "(50 -1, 51 5, 52 -1, 53 5), (0 0, 0 4))", true);
+	ensureSameSelfNodes("POLYGON ((0 0, 0 10, 10 10, 10 0, 0 0), "
+	                    "(1 1, 9 9, 9 1, 1 9, 1 1))", false);
+	ensureSameSelfNodes("POINT (1 1)", true);
+}
+
+// 2 - Mutual intersections match the sweep line ones
+template<>
+template<>
+void object::test<2>()
+{
+	using geos::geomgraph::GeometryGraph;
+	using namespace geos::geomgraph::index;
+
+	GeomAutoPtr a(reader.read(
+		"MULTILINESTRING ((0 0, 100 1, 0 2, 100 3, 0 4), (0 0, 0 4))"));
+	GeomAutoPtr b(reader.read(
+		"POLYGON ((10 -1, 90 -1, 90 5, 10 5, 10 -1), "
+		"(20 0, 80 0, 80 4, 20 4, 20 0))"));
+	geos::algorithm::LineIntersector li;
+
+	GeometryGraph a0(0, a.get()), b0(1, b.get());
+	SegmentIntersector si0(&li, true, true);
+	SimpleMCSweepLineIntersector sweep;
+	sweep.computeIntersections(a0.getEdges(), b0.getEdges(), &si0);
+
+	GeometryGraph a1(0, a.get()), b1(1, b.get());
+	SegmentIntersector si1(&li, true, true);
+	STRtreeEdgeSetIntersector tree;
+	tree.computeIntersections(a1.getEdges(), b1.getEdges(), &si1);
+
+	ensure(si1.hasIntersection());
+	ensureSameResults(*a0.getEdges(), si0, *a1.getEdges(), si1);
+	ensureSameResults(*b0.getEdges(), si0, *b1.getEdges(), si1);
+}
+
+// 3 - Operations give the same results when selected for their graphs
+template<>
+template<>
+void object::test<3>()
+{
+	using geos::geomgraph::GeometryGraph;
+	using geos::geom::IntersectionMatrix;
+	using geos::operation::relate::RelateOp;
+	using geos::operation::overlay::OverlayOp;
+
+	GeomAutoPtr a(reader.read(
+		"POLYGON ((0 0, 0 10, 4 10, 4 6, 6 6, 6 10, 10 10, 10 0, 0 0))"));
+	GeomAutoPtr b(reader.read(
+		"POLYGON ((2 2, 2 8, 8 8, 8 2, 2 2))"));
+
+	GeometryGraph graph(0, a.get());
+	ensure_equals(graph.getEdgeSetIntersectorType(),
+	              GeometryGraph::SWEEPLINE_INTERSECTOR);
+	graph.setEdgeSetIntersectorType(GeometryGraph::STRTREE_INTERSECTOR);
+	ensure_equals(graph.getEdgeSetIntersectorType(),
+	              GeometryGraph::STRTREE_INTERSECTOR);
+
+	std::auto_ptr<IntersectionMatrix> expectedIM(a->relate(b.get()));
+	GeomAutoPtr expected(a->symDifference(b.get()));
+
+	RelateOp relate(a.get(), b.get());
+	relate.setEdgeSetIntersectorType(GeometryGraph::STRTREE_INTERSECTOR);
+	std::auto_ptr<IntersectionMatrix> im(relate.getIntersectionMatrix());
+
+	OverlayOp overlay(a.get(), b.get());
+	overlay.setEdgeSetIntersectorType(GeometryGraph::STRTREE_INTERSECTOR);
+	GeomAutoPtr result(overlay.getResultGeometry(OverlayOp::opSYMDIFFERENCE));
+
+	ensure_equals(im->toString(), expectedIM->toString());
+	ensure(result->equalsExact(expected.get()));
+}
+
+} // namespace tut
@@ -0,0 +1,158 @@
+//
+// Test Suite for geos::index::intervalrtree::SortedPackedIntervalRTree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/intervalrtree/SortedPackedIntervalRTree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/util/UnsupportedOperationException.h>
+// std
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+using geos::index::intervalrtree::SortedPackedIntervalRTree;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_sortedpackedintervalrtree_data : public RandomValues
+	{
+		struct Interval
+		{
+			double min, max;
+		};
+
+		struct Collector : public geos::index::ItemVisitor
+		{
+			std::vector<void*> found;
+			void visitItem(void* item) { found.push_back(item); }
+			void operator()(void* item) { found.push_back(item); }
+		};
+
+		std::vector<Interval> intervals;
+
+		void addRandomIntervals(std::size_t n, double size)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				Interval interval;
+				interval.min = random() * 1000;
+				interval.max = interval.min + random() * size;
+				intervals.push_back(interval);
+			}
+		}
+
+		void insertAll(SortedPackedIntervalRTree& tree)
+		{
+			for (std::size_t i = 0; i < intervals.size(); ++i)
+				tree.insert(intervals[i].min, intervals[i].max, &intervals[i]);
+		}
+
+		// Checks the tree finds the intervals a brute force search finds
+		void checkQuery(SortedPackedIntervalRTree& tree, double min, double max)
+		{
+			std::vector<void*> expected;
+			for (std::size_t i = 0; i < intervals.size(); ++i)
+			{
+				if ( intervals[i].min <= max && intervals[i].max >= min )
+					expected.push_back(&intervals[i]);
+			}
+
+			Collector visitor;
+			tree.query(min, max, &visitor);
+			std::sort(visitor.found.begin(), visitor.found.end());
+			ensure(visitor.found == expected);
+
+			Collector inlined;
+			tree.query(min, max, inlined);
+			std::sort(inlined.found.begin(), inlined.found.end());
+			ensure(inlined.found == expected);
+		}
+	};
+
+	typedef test_group<test_sortedpackedintervalrtree_data> group;
+	typedef group::object object;
+
+	group test_sortedpackedintervalrtree_group("geos::index::intervalrtree::SortedPackedIntervalRTree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Queries on random intervals, for several tree sizes
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		std::size_t sizes[] = { 1, 2, 3, 5, 8, 100, 1001, 4096 };
+		for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+		{
+			intervals.clear();
+			addRandomIntervals(sizes[s], 20);
+			SortedPackedIntervalRTree tree;
+			insertAll(tree);
+
+			for (int q = 0; q < 50; ++q)
+			{
+				double min = random() * 1000;
+				checkQuery(tree, min, min);
+				checkQuery(tree, min, min + random() * 50);
+			}
+			checkQuery(tree, -1, 2000);
+			checkQuery(tree, 2000, 3000);
+		}
+	}
+
+	// 2 - Empty tree, duplicates and touching intervals
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		SortedPackedIntervalRTree empty;
+		Collector visitor;
+		empty.query(0, 1, &visitor);
+		ensure(visitor.found.empty());
+
+		for (int i = 0; i < 10; ++i)
+		{
+			Interval interval = { 5, 5 };
+			intervals.push_back(interval);
+			Interval unit = { double(i), double(i + 1) };
+			intervals.push_back(unit);
+		}
+		SortedPackedIntervalRTree tree;
+		insertAll(tree);
+		checkQuery(tree, 5, 5);
+		checkQuery(tree, 3, 3);
+		checkQuery(tree, 10, 11);
+		checkQuery(tree, 10.5, 11);
+	}
+
+	// 3 - No inserts once queried
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		SortedPackedIntervalRTree tree;
+		int item;
+		tree.insert(0, 1, &item);
+		Collector visitor;
+		tree.query(0, 0, &visitor);
+		ensure_equals(visitor.found.size(), 1u);
+
+		try
+		{
+			tree.insert(2, 3, &item);
+			fail("UnsupportedOperationException expected");
+		}
+		catch (const geos::util::UnsupportedOperationException&)
+		{
+		}
+	}
+
+} // namespace tut
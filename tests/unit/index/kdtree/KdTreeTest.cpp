@@ -0,0 +1,181 @@
+//
+// Test Suite for geos::index::kdtree::KdTree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/kdtree/KdTree.h>
+#include <geos/index/kdtree/KdNode.h>
+#include <geos/index/kdtree/KdNodeVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+// std
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+using geos::geom::Coordinate;
+using geos::geom::Envelope;
+using geos::index::kdtree::KdTree;
+using geos::index::kdtree::KdNode;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_kdtree_data : public RandomValues
+	{
+		struct Counter : public geos::index::kdtree::KdNodeVisitor
+		{
+			std::size_t count;
+			Counter() : count(0) {}
+			void visit(KdNode*) { ++count; }
+		};
+
+		// The depth of the deepest node under node
+		static std::size_t depth(const KdNode* node)
+		{
+			if ( ! node ) return 0;
+			return 1 + std::max(depth(node->getLeft()),
+			                    depth(node->getRight()));
+		}
+
+		// Checks the tree finds the points a brute force search finds
+		void checkQuery(const KdTree& tree, const std::vector<Coordinate>& pts,
+		                const Envelope& env)
+		{
+			std::vector<KdNode*> found;
+			tree.query(env, found);
+			std::vector<Coordinate> coords;
+			KdTree::toCoordinates(found, coords);
+			std::sort(coords.begin(), coords.end());
+
+			std::vector<Coordinate> expected;
+			for (std::size_t i = 0; i < pts.size(); ++i)
+			{
+				if ( env.covers(pts[i].x, pts[i].y) )
+					expected.push_back(pts[i]);
+			}
+			std::sort(expected.begin(), expected.end());
+			ensure(coords == expected);
+
+			Counter counter;
+			tree.query(env, counter);
+			ensure_equals(counter.count, expected.size());
+		}
+	};
+
+	typedef test_group<test_kdtree_data> group;
+	typedef group::object object;
+
+	group test_kdtree_group("geos::index::kdtree::KdTree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Queries on random points with duplicates
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		KdTree tree;
+		std::vector<Coordinate> pts;
+		for (int i = 0; i < 5000; ++i)
+		{
+			Coordinate p(double(int(random() * 200)), double(int(random() * 200)));
+			KdNode* node = tree.insert(p, &pts);
+			if ( node->getCount() == 1 ) pts.push_back(p);
+			ensure(node->getCoordinate().equals2D(p));
+			ensure(node->getData() == &pts);
+		}
+		ensure_equals(tree.size(), pts.size());
+		ensure(tree.size() < 5000);
+
+		for (int q = 0; q < 100; ++q)
+		{
+			double x = random() * 200;
+			double y = random() * 200;
+			checkQuery(tree, pts, Envelope(x, x + 20, y, y + 20));
+		}
+		checkQuery(tree, pts, Envelope(10, 10, 0, 200));
+
+		std::vector<KdNode*> all;
+		tree.query(Envelope(0, 200, 0, 200), all);
+		std::vector<Coordinate> coords;
+		KdTree::toCoordinates(all, coords, true);
+		ensure_equals(coords.size(), 5000u);
+	}
+
+	// 2 - Snapping within the tolerance, to the nearest node
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		KdTree tree(1.0);
+		int a, b;
+		KdNode* n1 = tree.insert(Coordinate(0, 0), &a);
+		KdNode* n2 = tree.insert(Coordinate(3, 0), &b);
+		ensure(n1 != n2);
+
+		ensure(tree.insert(Coordinate(0.5, 0.5), &b) == n1);
+		ensure(tree.insert(Coordinate(2.2, 0), &a) == n2);
+		ensure(tree.insert(Coordinate(1, 0)) == n1);
+		ensure(tree.insert(Coordinate(1.5, 0)) != n1);
+		ensure_equals(tree.size(), 3u);
+
+		ensure_equals(n1->getCount(), 3u);
+		ensure(n1->isRepeated());
+		ensure(n1->getData() == &a);
+		ensure(n1->getCoordinate().equals2D(Coordinate(0, 0)));
+		ensure_equals(n2->getCount(), 2u);
+	}
+
+	// 3 - Points inserted in order stay in a tree of logarithmic depth
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		KdTree tree;
+		std::vector<Coordinate> pts;
+		for (int i = 0; i < 20000; ++i)
+		{
+			pts.push_back(Coordinate(i * 0.5, i * 0.25));
+			tree.insert(pts.back());
+		}
+		// a vertical line, whose points all have the same x
+		for (int i = 0; i < 2000; ++i)
+		{
+			pts.push_back(Coordinate(-1, i));
+			tree.insert(pts.back());
+		}
+		ensure_equals(tree.size(), pts.size());
+		ensure(depth(tree.getRoot()) < 80);
+
+		checkQuery(tree, pts, Envelope(100, 2000, 0, 600));
+		checkQuery(tree, pts, Envelope(-1, -1, 10, 20));
+		checkQuery(tree, pts, Envelope(-10, 20000, -10, 20000));
+	}
+
+	// 4 - Empty tree and null query envelopes
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		KdTree tree;
+		ensure(tree.isEmpty());
+		ensure(tree.getRoot() == 0);
+		std::vector<KdNode*> found;
+		tree.query(Envelope(0, 1, 0, 1), found);
+		ensure(found.empty());
+
+		tree.insert(Coordinate(0.5, 0.5));
+		tree.query(Envelope(), found);
+		ensure(found.empty());
+		tree.query(Envelope(0, 1, 0, 1), found);
+		ensure_equals(found.size(), 1u);
+	}
+
+} // namespace tut
@@ -0,0 +1,237 @@
+//
+// Test Suite for geos::index::quadtree::Quadtree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/quadtree/Quadtree.h>
+#include <geos/index/quadtree/Node.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/index/IndexStatistics.h>
+#include <geos/index/QueryStatistics.h>
+#include <geos/geom/Envelope.h>
+// std
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::quadtree::Quadtree;
+using geos::index::quadtree::Node;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_quadtree_data : public RandomValues
+	{
+		struct Collector : public geos::index::ItemVisitor
+		{
+			std::vector<void*> items;
+			void visitItem(void* item) { items.push_back(item); }
+		};
+
+		// Queries the tree again for each item visited
+		struct NestedQuerier : public geos::index::ItemVisitor
+		{
+			Quadtree& tree;
+			std::size_t numItems;
+			std::size_t numNestedItems;
+
+			NestedQuerier(Quadtree& tree)
+				: tree(tree), numItems(0), numNestedItems(0)
+			{}
+
+			void visitItem(void* item)
+			{
+				++numItems;
+				Collector collector;
+				tree.query(static_cast<Envelope*>(item), collector);
+				numNestedItems += collector.items.size();
+			}
+		};
+
+		std::vector<Envelope> envs;
+
+		// Inserts n small envelopes, some of them points,
+		// with their index in envs as item
+		void fill(Quadtree& tree, std::size_t n)
+		{
+			envs.clear();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				double x = random() * 1000 - 500;
+				double y = random() * 1000 - 500;
+				double w = ( i % 5 == 0 ) ? 0 : random() * 10;
+				envs.push_back(Envelope(x, x + w, y, y + w));
+			}
+			for (std::size_t i = 0; i < n; ++i)
+				tree.insert(&envs[i], &envs[i]);
+		}
+
+		// Checks the tree returns at least the items intersecting env,
+		// the same way with a vector and a visitor
+		void checkQuery(Quadtree& tree, const Envelope& env,
+		                const std::vector<bool>& removed)
+		{
+			std::vector<void*> found;
+			tree.query(&env, found);
+			Collector collector;
+			tree.query(&env, collector);
+			ensure(found == collector.items);
+
+			std::sort(found.begin(), found.end());
+			for (std::size_t i = 0; i < envs.size(); ++i)
+			{
+				bool isFound = std::binary_search(found.begin(), found.end(),
+				                                  (void*)&envs[i]);
+				if ( removed[i] ) ensure(! isFound);
+				else if ( envs[i].intersects(env) ) ensure(isFound);
+			}
+		}
+	};
+
+	typedef test_group<test_quadtree_data> group;
+	typedef group::object object;
+
+	group test_quadtree_group("geos::index::quadtree::Quadtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Queries and removals
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		Quadtree tree;
+		fill(tree, 5000);
+		ensure_equals(tree.size(), 5000);
+
+		std::vector<bool> removed(envs.size(), false);
+		for (int q = 0; q < 100; ++q)
+		{
+			double x = random() * 1000 - 500;
+			double y = random() * 1000 - 500;
+			checkQuery(tree, Envelope(x, x + 50, y, y + 50), removed);
+		}
+
+		for (std::size_t i = 0; i < envs.size(); i += 2)
+		{
+			ensure(tree.remove(&envs[i], &envs[i]));
+			removed[i] = true;
+		}
+		ensure(! tree.remove(&envs[0], &envs[0]));
+		ensure_equals(tree.size(), 2500);
+		checkQuery(tree, Envelope(-500, 500, -500, 500), removed);
+
+		std::auto_ptr< std::vector<void*> > all(tree.queryAll());
+		ensure_equals(all->size(), 2500u);
+	}
+
+	// 2 - Reuse after clear
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		Quadtree tree;
+		for (int round = 0; round < 3; ++round)
+		{
+			fill(tree, 2000);
+			ensure_equals(tree.size(), 2000);
+			std::vector<bool> removed(envs.size(), false);
+			checkQuery(tree, Envelope(-100, 100, -100, 100), removed);
+
+			tree.clear();
+			ensure_equals(tree.size(), 0);
+			std::vector<void*> found;
+			Envelope all(-500, 500, -500, 500);
+			tree.query(&all, found);
+			ensure(found.empty());
+		}
+	}
+
+	// 3 - Shape of the tree and work of the queries
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		Quadtree tree;
+		fill(tree, 2000);
+
+		geos::index::IndexStatistics stats = tree.getStatistics();
+		ensure_equals(stats.numItems, 2000u);
+		ensure(stats.numNodes > 1);
+		ensure(stats.depth > 1);
+		ensure_equals(stats.depth, std::size_t(tree.depth()));
+		ensure(stats.fillFactor > 0 && stats.fillFactor < 1);
+		ensure_equals(stats.overlapArea, 0.0);
+		ensure(stats.memorySize > 2000 * sizeof(void*));
+
+		Envelope searchEnv(-100, 100, -100, 100);
+		geos::index::QueryStatistics queryStats;
+		Collector collector;
+		tree.query(&searchEnv, collector, queryStats);
+		std::vector<void*> found;
+		tree.query(&searchEnv, found);
+		ensure(found == collector.items);
+		ensure_equals(queryStats.numItemsReturned, found.size());
+		ensure(queryStats.numLeavesTested > 0);
+		ensure(queryStats.numNodesVisited >= queryStats.numLeavesTested);
+		ensure(queryStats.numNodesVisited < stats.numNodes);
+	}
+
+	// 4 - Queries from the visitor of a query
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		Quadtree tree;
+		fill(tree, 2000);
+
+		Envelope searchEnv(-100, 100, -100, 100);
+		NestedQuerier querier(tree);
+		tree.query(&searchEnv, querier);
+
+		std::vector<void*> found;
+		tree.query(&searchEnv, found);
+		ensure_equals(querier.numItems, found.size());
+
+		std::size_t numNestedItems = 0;
+		for (std::size_t i = 0; i < found.size(); ++i)
+		{
+			std::vector<void*> nested;
+			tree.query(static_cast<Envelope*>(found[i]), nested);
+			numNestedItems += nested.size();
+		}
+		ensure_equals(querier.numNestedItems, numNestedItems);
+	}
+
+	// 5 - Nodes created on their own own their subnodes
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		std::auto_ptr<Node> node(Node::createNode(Envelope(0, 1, 0, 1)));
+		Envelope itemEnv(0.1, 0.2, 0.1, 0.2);
+		Node* subnode = node->getNode(&itemEnv);
+		ensure(subnode != node.get());
+		ensure(subnode->getEnvelope()->contains(itemEnv));
+		int item = 0;
+		subnode->add(&item);
+		ensure_equals(node->size(), 1u);
+
+		std::auto_ptr<Node> larger(
+			Node::createExpanded(node, Envelope(5, 6, 5, 6)));
+		ensure(larger->getEnvelope()->contains(Envelope(0, 6, 0, 6)));
+		ensure_equals(larger->size(), 1u);
+		ensure(larger->remove(&itemEnv, &item));
+		ensure_equals(larger->size(), 0u);
+		ensure(! larger->remove(&itemEnv, &item));
+	}
+
+} // namespace tut
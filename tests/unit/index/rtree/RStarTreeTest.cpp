@@ -0,0 +1,226 @@
+//
+// Test Suite for geos::index::rtree::RStarTree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/rtree/RStarTree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::rtree::RStarTree;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_rstartree_data : public RandomEnvelopes
+	{
+		struct Counter : public geos::index::ItemVisitor
+		{
+			std::size_t count;
+			Counter() : count(0) {}
+			void visitItem(void*) { ++count; }
+		};
+
+		// whether envs[i] is in the tree
+		std::vector<bool> inTree;
+
+		void addRandomEnvelopes(std::size_t n, double size)
+		{
+			RandomEnvelopes::addRandomEnvelopes(n, size);
+			inTree.resize(envs.size(), false);
+		}
+
+		void insert(RStarTree& tree, std::size_t i)
+		{
+			tree.insert(&envs[i], &envs[i]);
+			inTree[i] = true;
+		}
+
+		// Checks the tree finds the items in it a brute force
+		// search finds
+		void checkQueries(RStarTree& tree, std::size_t nQueries)
+		{
+			for (std::size_t q = 0; q < nQueries; ++q)
+			{
+				double x = random() * 1000;
+				double y = random() * 1000;
+				Envelope searchEnv(x, x + 50, y, y + 50);
+
+				std::vector<void*> found;
+				tree.query(&searchEnv, found);
+				std::sort(found.begin(), found.end());
+
+				std::vector<void*> expected;
+				for (std::size_t i = 0; i < envs.size(); ++i)
+				{
+					if ( inTree[i] && envs[i].intersects(searchEnv) )
+						expected.push_back(&envs[i]);
+				}
+				std::sort(expected.begin(), expected.end());
+				ensure(found == expected);
+			}
+		}
+	};
+
+	typedef test_group<test_rstartree_data> group;
+	typedef group::object object;
+
+	group test_rstartree_group("geos::index::rtree::RStarTree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Queries on random items, as they are inserted
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		RStarTree tree(8);
+		addRandomEnvelopes(3000, 20);
+		for (std::size_t i = 0; i < envs.size(); ++i)
+		{
+			insert(tree, i);
+			if ( i % 500 == 0 ) checkQueries(tree, 20);
+		}
+		ensure_equals(tree.size(), envs.size());
+		checkQueries(tree, 100);
+
+		// the nodes are at least 40% full, but for the root
+		ensure(tree.depth() <= 8);
+
+		Envelope all(0, 2000, 0, 2000);
+		Counter counter;
+		tree.query(&all, counter);
+		ensure_equals(counter.count, envs.size());
+	}
+
+	// 2 - Queries between random inserts and removes,
+	// the tree shrinking back to empty
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		RStarTree tree(6);
+		addRandomEnvelopes(2000, 20);
+		std::size_t numInTree = 0;
+		for (int round = 0; round < 20000; ++round)
+		{
+			std::size_t i = std::size_t(random() * envs.size());
+			if ( inTree[i] )
+			{
+				ensure(tree.remove(&envs[i], &envs[i]));
+				inTree[i] = false;
+				--numInTree;
+			}
+			else
+			{
+				insert(tree, i);
+				++numInTree;
+			}
+			if ( round % 2000 == 0 ) checkQueries(tree, 20);
+		}
+		ensure_equals(tree.size(), numInTree);
+		checkQueries(tree, 100);
+
+		for (std::size_t i = 0; i < envs.size(); ++i)
+		{
+			if ( ! inTree[i] ) continue;
+			ensure(tree.remove(&envs[i], &envs[i]));
+			inTree[i] = false;
+		}
+		ensure_equals(tree.size(), 0u);
+		ensure_equals(tree.depth(), 1u);
+
+		Envelope all(0, 2000, 0, 2000);
+		std::vector<void*> found;
+		tree.query(&all, found);
+		ensure(found.empty());
+	}
+
+	// 3 - Removing items not in the tree, duplicates, null envelopes
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		RStarTree tree(4);
+		Envelope env(0, 1, 0, 1);
+		Envelope other(5, 6, 5, 6);
+		int a, b;
+
+		ensure(! tree.remove(&env, &a));
+
+		tree.insert(&env, &a);
+		tree.insert(&env, &a);
+		tree.insert(&env, &b);
+		ensure_equals(tree.size(), 3u);
+
+		ensure(! tree.remove(&other, &a));
+		ensure(tree.remove(&env, &a));
+		ensure(tree.remove(&env, &a));
+		ensure(! tree.remove(&env, &a));
+		ensure_equals(tree.size(), 1u);
+
+		Envelope null;
+		tree.insert(&null, &a);
+		ensure_equals(tree.size(), 1u);
+
+		std::vector<void*> found;
+		tree.query(&null, found);
+		ensure(found.empty());
+		tree.query(&env, found);
+		ensure_equals(found.size(), 1u);
+		ensure(found[0] == &b);
+
+		try
+		{
+			RStarTree bad(1);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+	}
+
+	// 4 - Many items at the same place, and along a line
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		RStarTree tree;
+		for (int i = 0; i < 500; ++i)
+		{
+			envs.push_back(Envelope(10, 10, 10, 10));
+			inTree.push_back(false);
+			envs.push_back(Envelope(i, i, 0, 0));
+			inTree.push_back(false);
+		}
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			insert(tree, i);
+		checkQueries(tree, 50);
+
+		Envelope point(10, 10, 10, 10);
+		std::vector<void*> found;
+		tree.query(&point, found);
+		ensure_equals(found.size(), 500u);
+
+		for (std::size_t i = 0; i < envs.size(); i += 2)
+		{
+			ensure(tree.remove(&envs[i], &envs[i]));
+			inTree[i] = false;
+		}
+		checkQueries(tree, 50);
+		ensure_equals(tree.size(), 500u);
+	}
+
+} // namespace tut
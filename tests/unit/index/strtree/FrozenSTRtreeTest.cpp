@@ -0,0 +1,218 @@
+// 
+// Test Suite for geos::index::strtree::FrozenSTRtree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/index/IndexStatistics.h>
+#include <geos/geom/Envelope.h>
+// std
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::strtree::STRtree;
+using geos::index::strtree::FrozenSTRtree;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_frozenstrtree_data : public RandomEnvelopes
+	{
+		struct Counter : public geos::index::ItemVisitor
+		{
+			std::size_t count;
+			Counter() : count(0) {}
+			void visitItem(void*) { ++count; }
+		};
+
+		void insertAll(STRtree& tree)
+		{
+			for (std::size_t i = 0; i < envs.size(); ++i)
+				tree.insert(&envs[i], &envs[i]);
+		}
+
+		// Both trees must find the same items, in the same order
+		void ensureSameQuery(STRtree& tree, const FrozenSTRtree& frozen,
+		                     const Envelope& query)
+		{
+			std::vector<void*> expected, found;
+			tree.query(&query, expected);
+			frozen.query(&query, found);
+			ensure_equals(found.size(), expected.size());
+			for (std::size_t i = 0; i < found.size(); ++i)
+				ensure(found[i] == expected[i]);
+
+			Counter counter;
+			frozen.query(&query, counter);
+			ensure_equals(counter.count, expected.size());
+		}
+	};
+
+	typedef test_group<test_frozenstrtree_data> group;
+	typedef group::object object;
+
+	group test_frozenstrtree_group("geos::index::strtree::FrozenSTRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Queries match the ones of the STRtree
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		addRandomEnvelopes(5000, 10);
+		// a null envelope, as for an empty geometry,
+		// which STRtree leaves out
+		envs.push_back(Envelope());
+
+		STRtree tree(4);
+		insertAll(tree);
+		FrozenSTRtree frozen(tree);
+		ensure_equals(frozen.size(), envs.size() - 1);
+		ensure(frozen.getNumNodes() > envs.size() / 4);
+
+		for (int q = 0; q < 50; ++q)
+		{
+			double x = random() * 1000;
+			double y = random() * 1000;
+			double size = random() * 100;
+			ensureSameQuery(tree, frozen, Envelope(x, x + size, y, y + size));
+		}
+		ensureSameQuery(tree, frozen, Envelope(-1, 1, -1, 1));
+		ensureSameQuery(tree, frozen, Envelope(-10, 1010, -10, 1010));
+		ensureSameQuery(tree, frozen, Envelope());
+	}
+
+	// 2 - The frozen tree outlives the STRtree
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		addRandomEnvelopes(1000, 10);
+		std::auto_ptr<STRtree> tree(new STRtree());
+		insertAll(*tree);
+		FrozenSTRtree frozen(*tree);
+		tree.reset();
+
+		Envelope world(-10, 1010, -10, 1010);
+		std::vector<void*> found;
+		frozen.query(&world, found);
+		ensure_equals(found.size(), envs.size());
+	}
+
+	// 3 - Empty and single node trees
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		Envelope world(-10, 1010, -10, 1010);
+		std::vector<void*> found;
+
+		STRtree empty;
+		FrozenSTRtree frozenEmpty(empty);
+		ensure_equals(frozenEmpty.size(), 0u);
+		ensure_equals(frozenEmpty.getNumNodes(), 0u);
+		frozenEmpty.query(&world, found);
+		ensure(found.empty());
+
+		addRandomEnvelopes(3, 1);
+		STRtree tree;
+		insertAll(tree);
+		FrozenSTRtree frozen(tree);
+		ensure_equals(frozen.getNumNodes(), 1u);
+		ensureSameQuery(tree, frozen, world);
+		ensureSameQuery(tree, frozen, envs[1]);
+	}
+
+	// 4 - Bulk-loaded trees find the same items as STRtree
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		typedef std::vector< std::pair<Envelope, void*> > Entries;
+
+		addRandomEnvelopes(3000, 10);
+		envs.push_back(Envelope());
+		STRtree tree;
+		insertAll(tree);
+
+		Entries entries;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			entries.push_back(std::make_pair(envs[i], &envs[i]));
+
+		for (std::size_t capacity = 2; capacity <= 16; capacity *= 2)
+		{
+			FrozenSTRtree frozen(entries, capacity);
+			ensure_equals(frozen.size(), envs.size() - 1);
+			ensure(frozen.getNumNodes() >= envs.size() / capacity);
+
+			for (int q = 0; q < 20; ++q)
+			{
+				double x = random() * 1000;
+				double y = random() * 1000;
+				double size = random() * 100;
+				Envelope query(x, x + size, y, y + size);
+
+				std::vector<void*> expected, found;
+				tree.query(&query, expected);
+				frozen.query(&query, found);
+				std::sort(expected.begin(), expected.end());
+				std::sort(found.begin(), found.end());
+				ensure(found == expected);
+			}
+		}
+
+		FrozenSTRtree empty((Entries()));
+		ensure_equals(empty.size(), 0u);
+		Envelope world(-10, 1010, -10, 1010);
+		std::vector<void*> found;
+		empty.query(&world, found);
+		ensure(found.empty());
+
+		FrozenSTRtree single(Entries(entries.begin(), entries.begin() + 1));
+		ensure_equals(single.getNumNodes(), 1u);
+		single.query(&world, found);
+		ensure_equals(found.size(), 1u);
+		ensure(found[0] == &envs[0]);
+	}
+
+	// 5 - Bulk-loaded trees have as many nodes as STRtree
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		addRandomEnvelopes(1001, 5);
+
+		const std::size_t sizes[] = { 2, 17, 100, 101, 1001 };
+		for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+		{
+			std::vector< std::pair<Envelope, void*> > entries;
+			for (std::size_t i = 0; i < sizes[s]; ++i)
+				entries.push_back(std::make_pair(envs[i], &envs[i]));
+
+			for (std::size_t capacity = 2; capacity <= 16; capacity += 2)
+			{
+				STRtree tree(capacity);
+				for (std::size_t i = 0; i < entries.size(); ++i)
+					tree.insert(&envs[i], &envs[i]);
+
+				FrozenSTRtree frozen(entries, capacity);
+				ensure_equals(frozen.getNumNodes(),
+				              tree.getStatistics().numNodes);
+			}
+		}
+	}
+
+} // namespace tut
@@ -0,0 +1,151 @@
+//
+// Test Suite for geos::index::strtree::HilbertPackedRtree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/strtree/HilbertPackedRtree.h>
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/geom/Envelope.h>
+// std
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::strtree::HilbertPackedRtree;
+using geos::index::strtree::FrozenSTRtree;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_hilbertpackedrtree_data : public RandomEnvelopes
+	{
+		void insertAll(HilbertPackedRtree& tree)
+		{
+			for (std::size_t i = 0; i < envs.size(); ++i)
+				tree.insert(&envs[i], &envs[i]);
+		}
+
+		// Checks the tree finds the items a brute force search finds
+		void checkQueries(HilbertPackedRtree& tree, std::size_t nQueries)
+		{
+			for (std::size_t q = 0; q < nQueries; ++q)
+			{
+				double x = random() * 1000;
+				double y = random() * 1000;
+				Envelope searchEnv(x, x + 50, y, y + 50);
+
+				std::vector<void*> found;
+				tree.query(&searchEnv, found);
+				std::sort(found.begin(), found.end());
+
+				std::vector<void*> expected;
+				for (std::size_t i = 0; i < envs.size(); ++i)
+				{
+					if ( envs[i].intersects(searchEnv) )
+						expected.push_back(&envs[i]);
+				}
+				ensure(found == expected);
+			}
+		}
+	};
+
+	typedef test_group<test_hilbertpackedrtree_data> group;
+	typedef group::object object;
+
+	group test_hilbertpackedrtree_group("geos::index::strtree::HilbertPackedRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Consecutive indexes are neighbouring cells
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		ensure_equals(HilbertPackedRtree::hilbertIndex(0, 0), 0u);
+		ensure_equals(HilbertPackedRtree::hilbertIndex(65535, 0),
+		              4294967295u);
+
+		const unsigned int n = 64;
+		std::vector<unsigned int> cells(n * n);
+		for (unsigned int x = 0; x < n; ++x)
+			for (unsigned int y = 0; y < n; ++y)
+			{
+				unsigned int d = HilbertPackedRtree::hilbertIndex(x, y);
+				ensure(d < n * n);
+				cells[d] = x * n + y;
+			}
+		for (unsigned int d = 1; d < n * n; ++d)
+		{
+			int dx = int(cells[d] / n) - int(cells[d - 1] / n);
+			int dy = int(cells[d] % n) - int(cells[d - 1] % n);
+			ensure_equals(dx * dx + dy * dy, 1);
+		}
+	}
+
+	// 2 - Random, clustered and elongated items
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		addRandomEnvelopes(1500, 10);
+		for (int i = 0; i < 1500; ++i)
+		{
+			double x = 400 + random() * 20;
+			double y = 600 + random() * 20;
+			envs.push_back(Envelope(x, x, y, y));
+		}
+		for (int i = 0; i < 500; ++i)
+		{
+			double x = random() * 1000;
+			double y = random() * 1000;
+			if ( i % 2 )
+				envs.push_back(Envelope(x, x + 300, y, y + 1));
+			else
+				envs.push_back(Envelope(x, x + 1, y, y + 300));
+		}
+
+		HilbertPackedRtree tree(8);
+		insertAll(tree);
+		checkQueries(tree, 200);
+
+		FrozenSTRtree frozen(tree);
+		Envelope all(-1, 2000, -1, 2000);
+		std::vector<void*> found;
+		frozen.query(&all, found);
+		ensure_equals(found.size(), envs.size());
+	}
+
+	// 3 - Empty trees, a single item, items at one place
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		Envelope searchEnv(0, 10, 0, 10);
+		std::vector<void*> found;
+
+		HilbertPackedRtree empty;
+		empty.query(&searchEnv, found);
+		ensure(found.empty());
+
+		envs.push_back(Envelope(1, 2, 1, 2));
+		HilbertPackedRtree single;
+		insertAll(single);
+		single.query(&searchEnv, found);
+		ensure_equals(found.size(), 1u);
+
+		envs.assign(100, Envelope(5, 5, 5, 5));
+		HilbertPackedRtree same(4);
+		insertAll(same);
+		found.clear();
+		same.query(&searchEnv, found);
+		ensure_equals(found.size(), 100u);
+	}
+
+} // namespace tut
@@ -0,0 +1,254 @@
+// 
+// Test Suite for geos::index::strtree::MappedSTRtree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/strtree/MappedSTRtree.h>
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/io/ByteOrderValues.h>
+#include <geos/util/GEOSException.h>
+#include <geos/geom/Envelope.h>
+#include <geos/platform.h>
+// std
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <cstdio>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::strtree::STRtree;
+using geos::index::strtree::FrozenSTRtree;
+using geos::index::strtree::MappedSTRtree;
+using geos::io::ByteOrderValues;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_mappedstrtree_data : public RandomEnvelopes
+	{
+		// Ids are offsets in envs, from a large base
+		struct OffsetIdentifier : public MappedSTRtree::ItemIdentifier
+		{
+			const Envelope* base;
+			OffsetIdentifier(const Envelope* b) : base(b) {}
+			int64 getId(void* item)
+			{
+				return int64(static_cast<Envelope*>(item) - base)
+				       + (int64(1) << 40);
+			}
+		};
+
+		std::string filename;
+
+		test_mappedstrtree_data()
+			: filename("mappedstrtree_test.bin")
+		{}
+
+		~test_mappedstrtree_data()
+		{
+			std::remove(filename.c_str());
+		}
+
+		void insertAll(STRtree& tree)
+		{
+			for (std::size_t i = 0; i < envs.size(); ++i)
+				tree.insert(&envs[i], &envs[i]);
+		}
+
+		static bool rejects(const char* data, std::size_t size)
+		{
+			try
+			{
+				MappedSTRtree mapped(data, size);
+			}
+			catch (const geos::util::GEOSException&)
+			{
+				return true;
+			}
+			return false;
+		}
+
+		// The mapped tree must find the ids of the items
+		// found by the frozen one, in the same order
+		void ensureSameQuery(const FrozenSTRtree& frozen,
+		                     const MappedSTRtree& mapped,
+		                     const Envelope& query)
+		{
+			OffsetIdentifier ids(&envs[0]);
+			std::vector<void*> expected;
+			std::vector<int64> found;
+			frozen.query(&query, expected);
+			mapped.query(&query, found);
+			ensure_equals(found.size(), expected.size());
+			for (std::size_t i = 0; i < found.size(); ++i)
+				ensure(found[i] == ids.getId(expected[i]));
+		}
+	};
+
+	typedef test_group<test_mappedstrtree_data> group;
+	typedef group::object object;
+
+	group test_mappedstrtree_group("geos::index::strtree::MappedSTRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - A tree written to a file finds the same items
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		addRandomEnvelopes(5000, 10);
+		STRtree tree(6);
+		insertAll(tree);
+		FrozenSTRtree frozen(tree);
+
+		OffsetIdentifier ids(&envs[0]);
+		MappedSTRtree::write(frozen, ids, filename);
+		MappedSTRtree mapped(filename);
+		ensure_equals(mapped.size(), frozen.size());
+		ensure_equals(mapped.getNumNodes(), frozen.getNumNodes());
+
+		for (int q = 0; q < 50; ++q)
+		{
+			double x = random() * 1000;
+			double y = random() * 1000;
+			double size = random() * 100;
+			ensureSameQuery(frozen, mapped, Envelope(x, x + size, y, y + size));
+		}
+		ensureSameQuery(frozen, mapped, Envelope(-10, 1010, -10, 1010));
+		ensureSameQuery(frozen, mapped, Envelope());
+	}
+
+	// 2 - Images in memory, and the empty tree
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		addRandomEnvelopes(100, 10);
+		STRtree tree;
+		insertAll(tree);
+		FrozenSTRtree frozen(tree);
+		OffsetIdentifier ids(&envs[0]);
+
+		std::ostringstream os;
+		MappedSTRtree::write(frozen, ids, os);
+		std::string image = os.str();
+		// copied to storage aligned for doubles
+		std::vector<double> aligned(image.size() / 8);
+		ensure_equals(aligned.size() * 8, image.size());
+		image.copy(reinterpret_cast<char*>(&aligned[0]), image.size());
+
+		MappedSTRtree mapped(&aligned[0], image.size());
+		ensure(!mapped.isMapped());
+		ensureSameQuery(frozen, mapped, Envelope(100, 600, 200, 900));
+
+		STRtree empty;
+		FrozenSTRtree frozenEmpty(empty);
+		MappedSTRtree::write(frozenEmpty, ids, filename);
+		MappedSTRtree mappedEmpty(filename);
+		ensure_equals(mappedEmpty.size(), 0u);
+		std::vector<int64> found;
+		mappedEmpty.query(&envs[0], found);
+		ensure(found.empty());
+	}
+
+	// 3 - Invalid images are rejected
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		addRandomEnvelopes(100, 10);
+		STRtree tree(4);
+		insertAll(tree);
+		FrozenSTRtree frozen(tree);
+		OffsetIdentifier ids(&envs[0]);
+
+		std::ostringstream os;
+		MappedSTRtree::write(frozen, ids, os);
+		const std::string image = os.str();
+		std::vector<double> aligned(image.size() / 8 + 1);
+		char* data = reinterpret_cast<char*>(&aligned[0]);
+
+		const std::size_t size = image.size();
+		const std::size_t childStartOffset =
+			32 + 8 * 4 * (frozen.getNumNodes() + frozen.size());
+
+		// truncated
+		image.copy(data, size);
+		ensure(rejects(data, size - 8));
+
+		// bad magic
+		image.copy(data, size);
+		data[0] = 'X';
+		ensure(rejects(data, size));
+
+		// bad version
+		image.copy(data, size);
+		data[8] = 2;
+		ensure(rejects(data, size));
+
+		// a node with its children before it
+		image.copy(data, size);
+		std::fill(data + childStartOffset + 8, data + childStartOffset + 16, 0);
+		ensure(rejects(data, size));
+
+		image.copy(data, size);
+		ensure(!rejects(data, size));
+
+		bool thrown = false;
+		try
+		{
+			MappedSTRtree mapped("no/such/file");
+		}
+		catch (const geos::util::GEOSException&)
+		{
+			thrown = true;
+		}
+		ensure(thrown);
+	}
+
+	// 4 - Leaves at unequal depths are rejected when opened
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		// The root has two nodes as children, the first of which has
+		// a node with one item as child, the second two items: the
+		// items are at depths 2 and 3
+		const int64 childStart[] = { 1, 3, 4, 6, 7 };
+		const int numNodes = 4;
+		const int numItems = 3;
+		const int numEntries = numNodes + numItems;
+
+		std::vector<double> aligned(4 + 4 * numEntries + numEntries + 1);
+		unsigned char* data = reinterpret_cast<unsigned char*>(&aligned[0]);
+		const int order = ByteOrderValues::ENDIAN_LITTLE;
+		std::copy("GEOSSTRT", "GEOSSTRT" + 8, data);
+		ByteOrderValues::putInt(MappedSTRtree::VERSION, data + 8, order);
+		ByteOrderValues::putInt(0, data + 12, order);
+		ByteOrderValues::putLong(numNodes, data + 16, order);
+		ByteOrderValues::putLong(numItems, data + 24, order);
+
+		unsigned char* p = data + 32;
+		for (int i = 0; i < 4 * numEntries; ++i, p += 8)
+			ByteOrderValues::putDouble(i % 4 < 2 ? 0 : 1, p, order);
+		for (int i = 0; i <= numNodes; ++i, p += 8)
+			ByteOrderValues::putLong(childStart[i], p, order);
+		for (int i = 0; i < numItems; ++i, p += 8)
+			ByteOrderValues::putLong(i, p, order);
+
+		const std::size_t size = std::size_t(p - data);
+		ensure(rejects(reinterpret_cast<const char*>(data), size));
+
+	}
+
+} // namespace tut
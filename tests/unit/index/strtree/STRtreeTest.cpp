@@ -0,0 +1,437 @@
+// 
+// Test Suite for geos::index::strtree::STRtree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/strtree/ItemPairVisitor.h>
+#include <geos/index/strtree/BatchQueryVisitor.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/index/IndexStatistics.h>
+#include <geos/index/QueryStatistics.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalStateException.h>
+// std
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::strtree::STRtree;
+using geos::index::strtree::ItemBoundable;
+using geos::index::strtree::ItemDistance;
+using geos::index::strtree::ItemPairVisitor;
+using geos::index::strtree::BatchQueryVisitor;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_strtree_data : public RandomEnvelopes
+	{
+		// Distance between the envelopes of two items,
+		// counting the calls
+		struct EnvelopeDistance : public ItemDistance
+		{
+			std::size_t count;
+			EnvelopeDistance() : count(0) {}
+			double distance(const ItemBoundable* item1,
+			                const ItemBoundable* item2)
+			{
+				++count;
+				const Envelope* e1 =
+					static_cast<const Envelope*>(item1->getBounds());
+				const Envelope* e2 =
+					static_cast<const Envelope*>(item2->getBounds());
+				return e1->distance(e2);
+			}
+		};
+
+		struct PairCollector : public ItemPairVisitor
+		{
+			std::vector< std::pair<void*, void*> > pairs;
+			void visitPair(void* item1, void* item2)
+			{
+				pairs.push_back(std::make_pair(item1, item2));
+			}
+		};
+
+		struct ItemCounter : public geos::index::ItemVisitor
+		{
+			std::size_t count;
+			ItemCounter() : count(0) {}
+			void visitItem(void*) { ++count; }
+		};
+
+		struct BatchCollector : public BatchQueryVisitor
+		{
+			std::vector< std::pair<std::size_t, void*> > found;
+			void visitItem(std::size_t queryIndex, void* item)
+			{
+				found.push_back(std::make_pair(queryIndex, item));
+			}
+		};
+
+		EnvelopeDistance itemDist;
+
+		void insertAll(STRtree& tree, std::vector<Envelope>& e)
+		{
+			for (std::size_t i = 0; i < e.size(); ++i)
+				tree.insert(&e[i], &e[i]);
+		}
+
+		// The k-th smallest distance from env to the envelopes
+		double kthDistance(const Envelope& env, std::size_t k)
+		{
+			std::vector<double> d;
+			for (std::size_t i = 0; i < envs.size(); ++i)
+				d.push_back(env.distance(&envs[i]));
+			std::sort(d.begin(), d.end());
+			return d[k - 1];
+		}
+	};
+
+	typedef test_group<test_strtree_data> group;
+	typedef group::object object;
+
+	group test_strtree_group("geos::index::strtree::STRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Nearest neighbours are found nearest first
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		addRandomEnvelopes(1000, 5);
+		STRtree tree(4);
+		insertAll(tree, envs);
+
+		for (int q = 0; q < 20; ++q)
+		{
+			double x = random() * 1000;
+			double y = random() * 1000;
+			Envelope query(x, x, y, y);
+
+			std::vector<void*> result;
+			tree.nearestNeighbour(&query, 0, 10, itemDist, result);
+			ensure_equals(result.size(), 10u);
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				const Envelope* e = static_cast<Envelope*>(result[i]);
+				ensure_equals(query.distance(e), kthDistance(query, i + 1));
+			}
+		}
+
+		// pruning leaves most items out
+		ensure(itemDist.count < 20 * envs.size() / 4);
+	}
+
+	// 2 - Empty trees and fewer items than asked for
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		Envelope query(0, 0, 0, 0);
+		std::vector<void*> result;
+
+		STRtree empty;
+		empty.nearestNeighbour(&query, 0, 3, itemDist, result);
+		ensure(result.empty());
+
+		addRandomEnvelopes(2, 1);
+		STRtree tree;
+		insertAll(tree, envs);
+		tree.nearestNeighbour(&query, 0, 3, itemDist, result);
+		ensure_equals(result.size(), 2u);
+
+		std::vector< std::pair<void*, void*> > pairs;
+		tree.nearestNeighbour(empty, 1, itemDist, pairs);
+		ensure(pairs.empty());
+	}
+
+	// 3 - Nearest pairs of items between two trees
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		addRandomEnvelopes(300, 2);
+		std::vector<Envelope> others;
+		others.swap(envs);
+		addRandomEnvelopes(200, 2);
+
+		STRtree tree1(4), tree2(6);
+		insertAll(tree1, envs);
+		insertAll(tree2, others);
+
+		std::vector<double> d;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			for (std::size_t j = 0; j < others.size(); ++j)
+				d.push_back(envs[i].distance(&others[j]));
+		std::sort(d.begin(), d.end());
+
+		std::vector< std::pair<void*, void*> > pairs;
+		tree1.nearestNeighbour(tree2, 5, itemDist, pairs);
+		ensure_equals(pairs.size(), 5u);
+		for (std::size_t i = 0; i < pairs.size(); ++i)
+		{
+			const Envelope* e1 = static_cast<Envelope*>(pairs[i].first);
+			const Envelope* e2 = static_cast<Envelope*>(pairs[i].second);
+			ensure(e1 >= &envs.front() && e1 <= &envs.back());
+			ensure(e2 >= &others.front() && e2 <= &others.back());
+			ensure_equals(e1->distance(e2), d[i]);
+		}
+	}
+
+	// 4 - Intersecting pairs of items between two trees,
+	// whole or in parts
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		addRandomEnvelopes(400, 30);
+		std::vector<Envelope> others;
+		others.swap(envs);
+		addRandomEnvelopes(300, 30);
+
+		STRtree tree1(4), tree2(6);
+		insertAll(tree1, envs);
+		insertAll(tree2, others);
+
+		std::vector< std::pair<void*, void*> > expected;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			for (std::size_t j = 0; j < others.size(); ++j)
+				if ( envs[i].intersects(others[j]) )
+					expected.push_back(std::make_pair(
+						(void*)&envs[i], (void*)&others[j]));
+		std::sort(expected.begin(), expected.end());
+		ensure(! expected.empty());
+
+		PairCollector all;
+		tree1.intersectingPairs(tree2, all);
+		std::sort(all.pairs.begin(), all.pairs.end());
+		ensure(all.pairs == expected);
+
+		for (std::size_t numParts = 2; numParts <= 64; numParts *= 4)
+		{
+			PairCollector parts;
+			for (std::size_t part = 0; part < numParts; ++part)
+				tree1.intersectingPairs(tree2, parts, part, numParts);
+			std::sort(parts.pairs.begin(), parts.pairs.end());
+			ensure(parts.pairs == expected);
+		}
+
+		STRtree empty;
+		PairCollector none;
+		tree1.intersectingPairs(empty, none);
+		empty.intersectingPairs(tree1, none, 1, 3);
+		ensure(none.pairs.empty());
+	}
+
+	// 5 - Const queries of a built tree
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		addRandomEnvelopes(2000, 20);
+		STRtree tree(5);
+		insertAll(tree, envs);
+		const STRtree& constTree = tree;
+		Envelope searchEnv(300, 500, 300, 500);
+
+		std::vector<void*> found;
+		try
+		{
+			constTree.query(&searchEnv, found);
+			fail("IllegalStateException expected");
+		}
+		catch (const geos::util::IllegalStateException&)
+		{
+		}
+
+		tree.build();
+		tree.build();
+		ensure(tree.isBuilt());
+		constTree.query(&searchEnv, found);
+		std::sort(found.begin(), found.end());
+
+		std::vector<void*> expected;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			if ( envs[i].intersects(searchEnv) )
+				expected.push_back(&envs[i]);
+		ensure(! expected.empty());
+		ensure(found == expected);
+
+		Envelope null;
+		found.clear();
+		constTree.query(&null, found);
+		ensure(found.empty());
+
+		STRtree empty;
+		empty.build();
+		static_cast<const STRtree&>(empty).query(&searchEnv, found);
+		ensure(found.empty());
+	}
+
+	// 6 - Slices are cut in the order of x, then sorted by y
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		// a 4 x 4 grid of points, inserted row by row
+		for (int y = 0; y < 4; ++y)
+		{
+			for (int x = 0; x < 4; ++x)
+				envs.push_back(Envelope(x, x, y, y));
+		}
+		STRtree tree(4);
+		insertAll(tree, envs);
+
+		// two slices of two columns, each cut into 2 x 2 leaves
+		Envelope all(0, 3, 0, 3);
+		std::vector<void*> found;
+		tree.query(&all, found);
+		ensure_equals(found.size(), 16u);
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			const Envelope* e = static_cast<Envelope*>(found[i]);
+			ensure(e->getMinX() <= 1 && e->getMinY() <= 1);
+		}
+	}
+
+	// 7 - Queries and removals on an empty tree
+	template<>
+	template<>
+	void object::test<7>()
+	{
+		STRtree empty;
+		Envelope searchEnv(0, 10, 0, 10);
+		std::vector<void*> found;
+		empty.query(&searchEnv, found);
+		ensure(found.empty());
+
+		struct Failer : public geos::index::ItemVisitor
+		{
+			void visitItem(void*) { fail("no item expected"); }
+		} failer;
+		empty.query(&searchEnv, failer);
+
+		ensure(! empty.remove(&searchEnv, 0));
+	}
+
+	// 8 - Batches of queries
+	template<>
+	template<>
+	void object::test<8>()
+	{
+		addRandomEnvelopes(3000, 20);
+		std::vector<Envelope> queries;
+		queries.swap(envs);
+		addRandomEnvelopes(5000, 10);
+		queries.push_back(Envelope());
+		queries.push_back(Envelope(5000, 6000, 5000, 6000));
+
+		STRtree tree(6);
+		insertAll(tree, envs);
+
+		std::vector< std::pair<std::size_t, void*> > expected;
+		for (std::size_t q = 0; q < queries.size(); ++q)
+		{
+			std::vector<void*> found;
+			tree.query(&queries[q], found);
+			for (std::size_t i = 0; i < found.size(); ++i)
+				expected.push_back(std::make_pair(q, found[i]));
+		}
+		std::sort(expected.begin(), expected.end());
+		ensure(! expected.empty());
+
+		BatchCollector all;
+		tree.queryMany(&queries[0], queries.size(), all);
+		std::sort(all.found.begin(), all.found.end());
+		ensure(all.found == expected);
+
+		BatchCollector parts;
+		for (std::size_t part = 0; part < 7; ++part)
+			tree.queryMany(&queries[0], queries.size(), parts, part, 7);
+		std::sort(parts.found.begin(), parts.found.end());
+		ensure(parts.found == expected);
+
+		STRtree empty;
+		BatchCollector none;
+		empty.queryMany(&queries[0], queries.size(), none);
+		tree.queryMany(&queries[0], 0, none);
+		ensure(none.found.empty());
+	}
+
+	// 9 - Shape of the tree and work of the queries
+	template<>
+	template<>
+	void object::test<9>()
+	{
+		addRandomEnvelopes(1000, 5);
+		STRtree tree(4);
+		insertAll(tree, envs);
+
+		geos::index::IndexStatistics stats = tree.getStatistics();
+		ensure(tree.isBuilt());
+		ensure_equals(stats.numItems, 1000u);
+		// 250 leaves, 63 nodes above them, then 16, 4 and the root
+		ensure_equals(stats.numNodes, 334u);
+		ensure_equals(stats.depth, 5u);
+		ensure(stats.fillFactor > 0.9 && stats.fillFactor <= 1);
+		ensure(stats.overlapArea > 0);
+		ensure(stats.memorySize > 1000 * sizeof(void*));
+
+		Envelope searchEnv(100, 200, 100, 200);
+		geos::index::QueryStatistics queryStats;
+		ItemCounter counter;
+		const STRtree& builtTree = tree;
+		builtTree.query(&searchEnv, counter, queryStats);
+		ensure_equals(queryStats.numItemsReturned, counter.count);
+		ensure(counter.count > 0);
+		ensure(queryStats.numLeavesTested > 0);
+		ensure(queryStats.numNodesVisited > queryStats.numLeavesTested);
+		ensure(queryStats.numNodesVisited < stats.numNodes);
+
+		std::vector<void*> found;
+		builtTree.query(&searchEnv, found);
+		ensure_equals(found.size(), counter.count);
+
+		// counts add up
+		builtTree.query(&searchEnv, counter, queryStats);
+		ensure_equals(queryStats.numItemsReturned, 2 * found.size());
+		queryStats.reset();
+		ensure_equals(queryStats.numNodesVisited, 0u);
+
+		STRtree empty;
+		stats = empty.getStatistics();
+		ensure_equals(stats.numNodes, 1u);
+		ensure_equals(stats.numItems, 0u);
+		ensure_equals(stats.overlapArea, 0.0);
+	}
+
+	// 10 - The slices hold whole nodes
+	template<>
+	template<>
+	void object::test<10>()
+	{
+		addRandomEnvelopes(1001, 5);
+		STRtree tree(10);
+		insertAll(tree, envs);
+
+		// 101 leaves, the last one holding a single item, then
+		// 11, 2 and the root
+		geos::index::IndexStatistics stats = tree.getStatistics();
+		ensure_equals(stats.numNodes, 115u);
+		ensure_equals(stats.depth, 4u);
+	}
+
+} // namespace tut
@@ -0,0 +1,371 @@
+//
+// Test Suite for geos::index::strtree::TemplateSTRtree class.
+
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/index/strtree/TemplateSTRtree.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/IndexStatistics.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/UnsupportedOperationException.h>
+#include <geos/platform.h> // for DoubleMax
+// std
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+using geos::geom::Envelope;
+using geos::index::strtree::STRtree;
+using geos::index::strtree::TemplateSTRtree;
+using geos::index::strtree::TemplateSTRtreeSpatialIndex;
+
+namespace {
+
+// One-dimensional bounds, to check other bounds types
+struct Range
+{
+	Range() : min(1), max(0) {}
+	Range(double a, double b) : min(a), max(b) {}
+	double min, max;
+};
+
+} // anonymous namespace
+
+namespace geos {
+namespace index {
+namespace strtree {
+
+template <>
+struct BoundsTraits<Range>
+{
+	static bool isNull(const Range& r) { return r.min > r.max; }
+	static bool intersects(const Range& a, const Range& b)
+	{
+		return a.min <= b.max && a.max >= b.min;
+	}
+	static void expandToInclude(Range& a, const Range& b)
+	{
+		if ( b.min < a.min ) a.min = b.min;
+		if ( b.max > a.max ) a.max = b.max;
+	}
+	static double getCentreX(const Range& r) { return r.min + r.max; }
+	static double getCentreY(const Range&) { return 0; }
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_templatestrtree_data : public RandomEnvelopes
+	{
+		struct Counter
+		{
+			std::size_t count;
+			Counter() : count(0) {}
+			void operator()(int) { ++count; }
+		};
+
+		struct ItemCounter : public geos::index::ItemVisitor
+		{
+			std::size_t count;
+			ItemCounter() : count(0) {}
+			void visitItem(void*) { ++count; }
+		};
+
+		// The distances from a point to envelopes, and to items
+		// taken as indices in envs
+		struct PointDistance
+		{
+			PointDistance(const std::vector<Envelope>& e, double px, double py)
+				: envs(e), x(px), y(py)
+			{}
+			double boundsDistance(const Envelope& env) const
+			{
+				Envelope p(x, x, y, y);
+				return env.distance(&p);
+			}
+			double itemDistance(int item) const
+			{
+				return boundsDistance(envs[item]);
+			}
+			const std::vector<Envelope>& envs;
+			double x, y;
+		};
+
+		// The distances between envelopes, and between items
+		// taken as indices in envs
+		struct EnvelopeDistance
+		{
+			EnvelopeDistance(const std::vector<Envelope>& e) : envs(e) {}
+			double boundsDistance(const Envelope& a, const Envelope& b) const
+			{
+				return a.distance(&b);
+			}
+			double itemDistance(int a, int b) const
+			{
+				return boundsDistance(envs[a], envs[b]);
+			}
+			const std::vector<Envelope>& envs;
+		};
+	};
+
+	typedef test_group<test_templatestrtree_data> group;
+	typedef group::object object;
+
+	group test_templatestrtree_group("geos::index::strtree::TemplateSTRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Items by value found as by a brute force search
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		addRandomEnvelopes(5000, 20);
+		TemplateSTRtree<int> tree(6);
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			tree.insert(envs[i], int(i));
+		ensure_equals(tree.size(), envs.size());
+
+		for (int q = 0; q < 200; ++q)
+		{
+			double x = random() * 1000;
+			double y = random() * 1000;
+			Envelope searchEnv(x, x + 50, y, y + 50);
+
+			std::vector<int> found;
+			tree.query(searchEnv, found);
+			std::sort(found.begin(), found.end());
+
+			std::vector<int> expected;
+			for (std::size_t i = 0; i < envs.size(); ++i)
+			{
+				if ( envs[i].intersects(searchEnv) )
+					expected.push_back(int(i));
+			}
+			ensure(found == expected);
+
+			Counter counter;
+			tree.query(searchEnv, counter);
+			ensure_equals(counter.count, expected.size());
+		}
+
+		Counter all;
+		tree.iterate(all);
+		ensure_equals(all.count, envs.size());
+	}
+
+	// 2 - Empty trees, a single item, null bounds
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		TemplateSTRtree<int> empty;
+		std::vector<int> found;
+		empty.query(Envelope(0, 1, 0, 1), found);
+		ensure(found.empty());
+		ensure(empty.isEmpty());
+		ensure_equals(empty.getNumNodes(), 0u);
+
+		TemplateSTRtree<int> tree;
+		tree.insert(Envelope(), 1);
+		tree.insert(Envelope(0, 1, 0, 1), 2);
+		ensure_equals(tree.size(), 1u);
+
+		tree.query(Envelope(), found);
+		ensure(found.empty());
+		tree.query(Envelope(1, 2, 1, 2), found);
+		ensure_equals(found.size(), 1u);
+		ensure_equals(found[0], 2);
+		ensure_equals(tree.getNumNodes(), 1u);
+	}
+
+	// 3 - Other bounds types
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		TemplateSTRtree<int, Range> tree(4);
+		for (int i = 0; i < 100; ++i)
+			tree.insert(Range(i, i + 1.5), i);
+		tree.insert(Range(), -1);
+		ensure_equals(tree.size(), 100u);
+
+		std::vector<int> found;
+		tree.query(Range(10.2, 12.8), found);
+		std::sort(found.begin(), found.end());
+		ensure_equals(found.size(), 4u);
+		ensure_equals(found[0], 9);
+		ensure_equals(found[3], 12);
+	}
+
+	// 4 - Seen as a SpatialIndex
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		addRandomEnvelopes(500, 20);
+		TemplateSTRtree<Envelope*> tree;
+		TemplateSTRtreeSpatialIndex<Envelope> index(tree);
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			index.insert(&envs[i], &envs[i]);
+
+		Envelope searchEnv(200, 600, 200, 600);
+		std::vector<void*> found;
+		index.query(&searchEnv, found);
+		ItemCounter counter;
+		index.query(&searchEnv, counter);
+
+		std::size_t expected = 0;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+		{
+			if ( envs[i].intersects(searchEnv) ) ++expected;
+		}
+		ensure_equals(found.size(), expected);
+		ensure_equals(counter.count, expected);
+		ensure(found[0] >= static_cast<void*>(&envs[0]) &&
+		       found[0] <= static_cast<void*>(&envs.back()));
+
+		try
+		{
+			index.remove(&envs[0], &envs[0]);
+			fail("UnsupportedOperationException expected");
+		}
+		catch (const geos::util::UnsupportedOperationException&)
+		{
+		}
+	}
+
+	// 5 - Nearest items found as by a brute force search
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		addRandomEnvelopes(1000, 5);
+		TemplateSTRtree<int> tree;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			tree.insert(envs[i], int(i));
+
+		for (int q = 0; q < 50; ++q)
+		{
+			PointDistance metric(envs, random() * 1200 - 100,
+			                     random() * 1200 - 100);
+			double expected = metric.itemDistance(0);
+			for (std::size_t i = 1; i < envs.size(); ++i)
+				expected = std::min(expected, metric.itemDistance(int(i)));
+
+			double distance;
+			const int* found = tree.nearest(metric, distance);
+			ensure(found != 0);
+			ensure_equals(distance, expected);
+			ensure_equals(metric.itemDistance(*found), expected);
+
+			found = tree.nearest(metric, distance, expected);
+			ensure(found != 0);
+			ensure_equals(distance, expected);
+			if ( expected > 0 )
+				ensure(tree.nearest(metric, distance, expected / 2) == 0);
+
+			// any item no farther than the stop distance may be found
+			found = tree.nearest(metric, distance,
+			                     expected + 100, expected + 50);
+			ensure(found != 0);
+			ensure(distance <= expected + 50);
+			ensure_equals(metric.itemDistance(*found), distance);
+		}
+
+		TemplateSTRtree<int> empty;
+		PointDistance metric(envs, 0, 0);
+		double distance;
+		ensure(empty.nearest(metric, distance) == 0);
+	}
+
+	// 6 - Nearest pairs found as by a brute force search
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		for (int round = 0; round < 5; ++round)
+		{
+			envs.clear();
+			addRandomEnvelopes(300, 3);
+			std::size_t n0 = envs.size();
+			for (std::size_t i = 0; i < 300; ++i)
+			{
+				double x = random() * 1000 + 1005;
+				double y = random() * 1000 + round * 100;
+				envs.push_back(Envelope(x, x + random() * 3, y, y + random() * 3));
+			}
+
+			TemplateSTRtree<int> tree0;
+			TemplateSTRtree<int> tree1;
+			for (std::size_t i = 0; i < envs.size(); ++i)
+			{
+				if ( i < n0 ) tree0.insert(envs[i], int(i));
+				else tree1.insert(envs[i], int(i));
+			}
+
+			EnvelopeDistance metric(envs);
+			double expected = DoubleMax;
+			for (std::size_t i = 0; i < n0; ++i)
+			{
+				for (std::size_t j = n0; j < envs.size(); ++j)
+					expected = std::min(expected, metric.itemDistance(int(i), int(j)));
+			}
+
+			double distance;
+			std::pair<const int*, const int*> found =
+				tree0.nearestPair(tree1, metric, distance);
+			ensure(found.first != 0 && found.second != 0);
+			ensure(*found.first < int(n0) && *found.second >= int(n0));
+			ensure_equals(distance, expected);
+			ensure_equals(metric.itemDistance(*found.first, *found.second), expected);
+
+			found = tree0.nearestPair(tree1, metric, distance, expected / 2);
+			ensure(found.first == 0 && found.second == 0);
+
+			found = tree0.nearestPair(tree1, metric, distance,
+			                          DoubleMax, expected + 10);
+			ensure(found.first != 0);
+			ensure(distance <= expected + 10);
+		}
+	}
+
+	// 7 - As many nodes as STRtree
+	template<>
+	template<>
+	void object::test<7>()
+	{
+		addRandomEnvelopes(1001, 5);
+
+		const std::size_t sizes[] = { 2, 17, 100, 101, 1001 };
+		for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+		{
+			for (std::size_t capacity = 2; capacity <= 16; capacity += 2)
+			{
+				STRtree expected(capacity);
+				TemplateSTRtree<int> tree(capacity);
+				for (std::size_t i = 0; i < sizes[s]; ++i)
+				{
+					expected.insert(&envs[i], &envs[i]);
+					tree.insert(envs[i], int(i));
+				}
+				tree.build();
+				ensure_equals(tree.getNumNodes(),
+				              expected.getStatistics().numNodes);
+			}
+		}
+	}
+
+} // namespace tut
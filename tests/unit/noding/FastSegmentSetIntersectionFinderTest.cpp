@@ -0,0 +1,210 @@
+//
+// Test Suite for geos::noding::FastSegmentSetIntersectionFinder class.
+
+#include <tut.hpp>
+// geos
+#include <geos/noding/FastSegmentSetIntersectionFinder.h>
+#include <geos/noding/SegmentStringUtil.h>
+#include <geos/noding/SegmentString.h>
+#include <geos/noding/SegmentIntersector.h>
+#include <geos/noding/MCIndexSegmentSetMutualIntersector.h>
+#include <geos/index/chain/MonotoneChain.h>
+#include <geos/util/GEOSException.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/io/WKTReader.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+// std
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used by all tests
+    struct test_fastsegsetintfinder_data
+    {
+        typedef geos::geom::Geometry::AutoPtr GeomPtr;
+        typedef geos::noding::SegmentString::ConstVect SegStrVect;
+
+        geos::geom::GeometryFactory gf;
+        geos::io::WKTReader reader;
+        SegStrVect segStrings;
+
+        // Throws on the first pair of overlapping chains
+        struct ThrowingIntersector : public geos::noding::SegmentIntersector
+        {
+            void processIntersections(geos::noding::SegmentString*, int,
+                                      geos::noding::SegmentString*, int)
+            {
+                throw geos::util::GEOSException("overlap");
+            }
+        };
+
+        test_fastsegsetintfinder_data()
+            : gf(), reader(&gf)
+        {}
+
+        ~test_fastsegsetintfinder_data()
+        {
+            for (std::size_t i = 0; i < segStrings.size(); ++i)
+                delete segStrings[i];
+        }
+
+        // Segment strings for the given WKT are appended to out,
+        // and kept in segStrings for release at teardown
+        void addSegmentStrings(const std::string& wkt, SegStrVect& out)
+        {
+            GeomPtr g(reader.read(wkt));
+            std::size_t first = segStrings.size();
+            geos::noding::SegmentStringUtil::extractSegmentStrings(g.get(),
+                                                                 segStrings);
+            out.insert(out.end(), segStrings.begin() + first,
+                       segStrings.end());
+        }
+    };
+
+    typedef test_group<test_fastsegsetintfinder_data> group;
+    typedef group::object object;
+
+    group test_fastsegsetintfinder_group("geos::noding::FastSegmentSetIntersectionFinder");
+
+    //
+    // Test Cases
+    //
+
+    // Batched results match one query per string
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        using geos::noding::FastSegmentSetIntersectionFinder;
+
+        SegStrVect base;
+        addSegmentStrings("LINESTRING(0 0, 10 0, 10 10, 0 10, 0 0)", base);
+        FastSegmentSetIntersectionFinder finder(&base);
+
+        SegStrVect tests;
+        addSegmentStrings("LINESTRING(-5 5, 5 5)", tests);   // crosses
+        addSegmentStrings("LINESTRING(2 2, 8 8)", tests);    // inside
+        addSegmentStrings("LINESTRING(20 0, 20 10)", tests); // outside
+        addSegmentStrings("LINESTRING(10 10, 20 20)", tests);// touches
+        addSegmentStrings("LINESTRING(5 5, 6 6, 5 7, 6 8, 5 9, 6 11)", tests);
+
+        std::vector<bool> results;
+        finder.intersects(tests, results);
+
+        ensure_equals(results.size(), tests.size());
+        ensure(results[0]);
+        ensure(!results[1]);
+        ensure(!results[2]);
+        ensure(results[3]);
+        ensure(results[4]);
+
+        for (std::size_t i = 0; i < tests.size(); ++i)
+        {
+            SegStrVect single(1, tests[i]);
+            ensure_equals(finder.intersects(&single), bool(results[i]));
+        }
+    }
+
+    // Empty batch
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        using geos::noding::FastSegmentSetIntersectionFinder;
+
+        SegStrVect base;
+        addSegmentStrings("LINESTRING(0 0, 10 0)", base);
+        FastSegmentSetIntersectionFinder finder(&base);
+
+        SegStrVect tests;
+        std::vector<bool> results(3, true);
+        finder.intersects(tests, results);
+        ensure(results.empty());
+    }
+
+    // A throwing SegmentIntersector leaves the chain buffer empty
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        using geos::noding::MCIndexSegmentSetMutualIntersector;
+
+        SegStrVect base;
+        addSegmentStrings("LINESTRING(0 0, 10 0, 10 10, 0 10, 0 0)", base);
+        MCIndexSegmentSetMutualIntersector intersector;
+        intersector.setBaseSegments(&base);
+
+        SegStrVect tests;
+        addSegmentStrings("LINESTRING(-5 5, 5 5, 15 5)", tests);
+
+        ThrowingIntersector si;
+        std::vector<geos::index::chain::MonotoneChain*> chainBuf;
+        std::vector<void*> overlapBuf;
+        for (int i = 0; i < 2; ++i)
+        {
+            try
+            {
+                intersector.process(
+                    const_cast<geos::noding::SegmentString*>(tests[0]),
+                    si, chainBuf, overlapBuf);
+                fail("GEOSException expected");
+            }
+            catch (const geos::util::GEOSException&)
+            {
+            }
+            ensure(chainBuf.empty());
+        }
+    }
+
+    // Parts together give the results of the whole batch
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        using geos::noding::FastSegmentSetIntersectionFinder;
+
+        SegStrVect base;
+        addSegmentStrings("LINESTRING(0 0, 10 0, 10 10, 0 10, 0 0)", base);
+        FastSegmentSetIntersectionFinder finder(&base);
+
+        SegStrVect tests;
+        addSegmentStrings("LINESTRING(-5 5, 5 5)", tests);
+        addSegmentStrings("LINESTRING(2 2, 8 8)", tests);
+        addSegmentStrings("LINESTRING(20 0, 20 10)", tests);
+        addSegmentStrings("LINESTRING(10 10, 20 20)", tests);
+        addSegmentStrings("LINESTRING(5 5, 6 6, 5 7, 6 8, 5 9, 6 11)", tests);
+
+        std::vector<bool> whole;
+        finder.intersects(tests, whole);
+
+        for (std::size_t numParts = 1; numParts <= 7; ++numParts)
+        {
+            std::vector<bool> joined;
+            for (std::size_t part = 0; part < numParts; ++part)
+            {
+                std::vector<bool> results;
+                finder.intersects(tests, results, part, numParts);
+                joined.insert(joined.end(), results.begin(), results.end());
+            }
+            ensure(joined == whole);
+        }
+
+        std::vector<bool> results;
+        try
+        {
+            finder.intersects(tests, results, 2, 2);
+            fail("IllegalArgumentException expected");
+        }
+        catch (const geos::util::IllegalArgumentException&)
+        {
+        }
+    }
+
+} // namespace tut
@@ -3,6 +3,7 @@
 
 // tut
 #include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
 // geos
 #include <geos/operation/distance/DistanceOp.h>
 #include <geos/platform.h>
@@ -14,10 +15,18 @@
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/util/LinearComponentExtracter.h>
+#include <geos/geom/util/PointExtracter.h>
+#include <geos/algorithm/CGAlgorithms.h>
 // std
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
+#include <cstddef>
 
 namespace tut
 {
@@ -26,7 +35,7 @@ namespace tut
 	//
 
 	// Common data used by tests
-	struct test_distanceop_data
+	struct test_distanceop_data : public RandomValues
 	{
 		geos::geom::GeometryFactory gf;
 		geos::io::WKTReader wktreader;
@@ -37,6 +46,69 @@ namespace tut
 		test_distanceop_data()
             : gf(), wktreader(&gf)
 		{}
+
+		// The WKT of a random walk of n steps from x y
+		std::string randomWalk(int n, double x, double y)
+		{
+			std::ostringstream wkt;
+			wkt.precision(17);
+			wkt << "(" << x << " " << y;
+			for (int i = 0; i < n; ++i)
+			{
+				x += random() * 10 - 5;
+				y += random() * 10 - 5;
+				wkt << ", " << x << " " << y;
+			}
+			wkt << ")";
+			return wkt.str();
+		}
+
+		// The segments of the lines of g, and its points as
+		// zero-length segments
+		static void getSegments(const geos::geom::Geometry& g,
+		                        std::vector<geos::geom::Coordinate>& segs)
+		{
+			using namespace geos::geom;
+			LineString::ConstVect lines;
+			util::LinearComponentExtracter::getLines(g, lines);
+			for (std::size_t i = 0; i < lines.size(); ++i)
+			{
+				const CoordinateSequence* cs = lines[i]->getCoordinatesRO();
+				for (std::size_t j = 1; j < cs->size(); ++j)
+				{
+					segs.push_back(cs->getAt(j - 1));
+					segs.push_back(cs->getAt(j));
+				}
+			}
+			Point::ConstVect points;
+			util::PointExtracter::getPoints(g, points);
+			for (std::size_t i = 0; i < points.size(); ++i)
+			{
+				segs.push_back(*points[i]->getCoordinate());
+				segs.push_back(*points[i]->getCoordinate());
+			}
+		}
+
+		// The distance between the facets of g0 and g1, comparing
+		// all pairs of segments
+		static double bruteForceDistance(const geos::geom::Geometry& g0,
+		                                 const geos::geom::Geometry& g1)
+		{
+			std::vector<geos::geom::Coordinate> segs0, segs1;
+			getSegments(g0, segs0);
+			getSegments(g1, segs1);
+			double minDist = DoubleMax;
+			for (std::size_t i = 0; i < segs0.size(); i += 2)
+			{
+				for (std::size_t j = 0; j < segs1.size(); j += 2)
+				{
+					minDist = std::min(minDist,
+						geos::algorithm::CGAlgorithms::distanceLineLine(
+							segs0[i], segs0[i + 1], segs1[j], segs1[j + 1]));
+				}
+			}
+			return minDist;
+		}
 	};
 
 	typedef test_group<test_distanceop_data> group;
@@ -478,6 +550,82 @@ namespace tut
         ensure_equals(g1->distance(g2.get()), 0);
     }
 
+	// 20 - Large lines and points, searched in STRtrees
+	template<>
+	template<>
+	void object::test<20>()
+	{
+		using geos::operation::distance::DistanceOp;
+		using geos::geom::Coordinate;
+
+		for (int i = 0; i < 10; ++i)
+		{
+			GeomPtr g0(wktreader.read("MULTILINESTRING (" +
+				randomWalk(300, 0, 0) + ", " + randomWalk(200, 100, 0) + ")"));
+			std::string wkt1 = "GEOMETRYCOLLECTION (LINESTRING " +
+				randomWalk(400, 20 * i, 60) + ", MULTIPOINT " +
+				randomWalk(50, 50, -40) + ")";
+			GeomPtr g1(wktreader.read(wkt1));
+
+			double expected = bruteForceDistance(*g0, *g1);
+			DistanceOp dist(*g0, *g1);
+			ensure_equals(dist.distance(), expected);
+
+			CSPtr cs(dist.nearestPoints());
+			ensure_distance(cs->getAt(0).distance(cs->getAt(1)), expected, 1e-9);
+			GeomPtr p0(gf.createPoint(cs->getAt(0)));
+			GeomPtr p1(gf.createPoint(cs->getAt(1)));
+			ensure(p0->distance(g0.get()) < 1e-9);
+			ensure(p1->distance(g1.get()) < 1e-9);
+
+			ensure(DistanceOp::isWithinDistance(*g0, *g1, expected));
+			if ( expected > 0 )
+				ensure(! DistanceOp::isWithinDistance(*g0, *g1, expected * 0.99));
+		}
+	}
+
+	// 21 - Within distance tests agreeing with the distance
+	template<>
+	template<>
+	void object::test<21>()
+	{
+		using geos::operation::distance::DistanceOp;
+
+		for (int i = 0; i < 10; ++i)
+		{
+			GeomPtr g0(wktreader.read("LINESTRING " + randomWalk(500, 0, 0)));
+			GeomPtr g1(wktreader.read("LINESTRING " + randomWalk(500, 30 + 10 * i, 0)));
+			GeomPtr poly(g1->buffer(2));
+			const geos::geom::Geometry* others[] = { g1.get(), poly.get() };
+			for (int j = 0; j < 2; ++j)
+			{
+				double d = DistanceOp::distance(*g0, *others[j]);
+				double thresholds[] = { 0, d * 0.5, d * 0.999, d, d * 1.001, d + 50 };
+				for (std::size_t k = 0; k < 6; ++k)
+				{
+					double t = thresholds[k];
+					ensure_equals(DistanceOp::isWithinDistance(*g0, *others[j], t), d <= t);
+					ensure_equals(others[j]->isWithinDistance(g0.get(), t), d <= t);
+				}
+			}
+		}
+
+		// containment, and envelopes farther apart
+		GeomPtr poly(wktreader.read("POLYGON((0 0, 100 0, 100 100, 0 100, 0 0))"));
+		GeomPtr inside(wktreader.read("MULTIPOINT((50 50), (200 200))"));
+		ensure(DistanceOp::isWithinDistance(*poly, *inside, 0));
+		GeomPtr far(wktreader.read("LINESTRING(300 0, 300 100)"));
+		ensure(! DistanceOp::isWithinDistance(*poly, *far, 199));
+		ensure(DistanceOp::isWithinDistance(*poly, *far, 200));
+
+		// empty geometries are within no distance of anything
+		GeomPtr empty(wktreader.read("POLYGON EMPTY"));
+		ensure(! DistanceOp::isWithinDistance(*poly, *empty, 1000));
+		ensure(! DistanceOp::isWithinDistance(*empty, *poly, 1000));
+		ensure(! DistanceOp::isWithinDistance(*empty, *empty, 0));
+		ensure(! poly->isWithinDistance(empty.get(), 1000));
+	}
+
 	// TODO: finish the tests by adding:
 	// 	LINESTRING - *all*
 	// 	MULTILINESTRING - *all*
@@ -0,0 +1,232 @@
+//
+// Test Suite for geos::operation::predicate::SpatialJoin class.
+
+// tut
+#include <tut.hpp>
+#include <utility/RandomEnvelopes.h>
+// geos
+#include <geos/operation/predicate/SpatialJoin.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_spatialjoin_data : public RandomValues
+	{
+		typedef geos::operation::predicate::SpatialJoin SpatialJoin;
+		typedef geos::geom::Geometry Geometry;
+		typedef std::vector< std::pair<std::size_t, std::size_t> > PairList;
+
+		struct PairCollector : public SpatialJoin::PairVisitor
+		{
+			PairList pairs;
+			void visitPair(std::size_t index1, std::size_t index2)
+			{
+				pairs.push_back(std::make_pair(index1, index2));
+			}
+		};
+
+		geos::geom::GeometryFactory gf;
+		geos::io::WKTReader reader;
+		std::vector<Geometry*> owned;
+
+		test_spatialjoin_data() : gf(), reader(&gf) {}
+
+		~test_spatialjoin_data()
+		{
+			for (std::size_t i = 0; i < owned.size(); ++i)
+				delete owned[i];
+		}
+
+		// Small integers, so that boundaries often touch
+		int randomInt(int n)
+		{
+			return int(random() * n);
+		}
+
+		const Geometry* read(const std::string& wkt)
+		{
+			owned.push_back(reader.read(wkt));
+			return owned.back();
+		}
+
+		// Points, lines, rectangles and polygons with more points
+		void addRandomGeometries(std::vector<const Geometry*>& geoms,
+		                         std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				int x = randomInt(100);
+				int y = randomInt(100);
+				int w = 1 + randomInt(15);
+				int h = 1 + randomInt(15);
+				std::ostringstream wkt;
+				switch (i % 4)
+				{
+				case 0:
+					wkt << "POINT(" << x << " " << y << ")";
+					break;
+				case 1:
+					wkt << "LINESTRING(" << x << " " << y << ", "
+					    << x + w << " " << y + h << ")";
+					break;
+				case 2:
+					wkt << "POLYGON((" << x << " " << y << ", "
+					    << x + w << " " << y << ", "
+					    << x + w << " " << y + h << ", "
+					    << x << " " << y + h << ", "
+					    << x << " " << y << "))";
+					break;
+				default:
+					wkt << "POLYGON((" << x << " " << y << ", "
+					    << x + w << " " << y << ", "
+					    << x + w + 2 << " " << y + h / 2 << ", "
+					    << x + w << " " << y + h << ", "
+					    << x + w / 2 << " " << y + h + 2 << ", "
+					    << x << " " << y + h << ", "
+					    << x - 2 << " " << y + h / 2 << ", "
+					    << x << " " << y << "))";
+				}
+				geoms.push_back(read(wkt.str()));
+			}
+		}
+
+		static bool holds(SpatialJoin::Predicate predicate,
+		                  const Geometry* g1, const Geometry* g2)
+		{
+			switch (predicate)
+			{
+			case SpatialJoin::INTERSECTS: return g1->intersects(g2);
+			case SpatialJoin::CONTAINS: return g1->contains(g2);
+			case SpatialJoin::COVERS: return g1->covers(g2);
+			case SpatialJoin::WITHIN: return g1->within(g2);
+			case SpatialJoin::COVERED_BY: return g2->covers(g1);
+			case SpatialJoin::TOUCHES: return g1->touches(g2);
+			case SpatialJoin::CROSSES: return g1->crosses(g2);
+			case SpatialJoin::OVERLAPS: return g1->overlaps(g2);
+			}
+			return false;
+		}
+
+		static PairList bruteForce(SpatialJoin::Predicate predicate,
+		                           const std::vector<const Geometry*>& geoms1,
+		                           const std::vector<const Geometry*>& geoms2)
+		{
+			PairList pairs;
+			for (std::size_t i = 0; i < geoms1.size(); ++i)
+				for (std::size_t j = 0; j < geoms2.size(); ++j)
+					if ( holds(predicate, geoms1[i], geoms2[j]) )
+						pairs.push_back(std::make_pair(i, j));
+			return pairs;
+		}
+
+	private:
+		// noncopyable
+		test_spatialjoin_data(test_spatialjoin_data const& other);
+		test_spatialjoin_data& operator=(test_spatialjoin_data const& rhs);
+	};
+
+	typedef test_group<test_spatialjoin_data> group;
+	typedef group::object object;
+
+	group test_spatialjoin_group("geos::operation::predicate::SpatialJoin");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Each predicate gives the pairs a brute force search finds
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		std::vector<const Geometry*> geoms1, geoms2;
+		addRandomGeometries(geoms1, 200);
+		addRandomGeometries(geoms2, 150);
+		SpatialJoin join(geoms1, geoms2);
+
+		for (int p = SpatialJoin::INTERSECTS; p <= SpatialJoin::OVERLAPS; ++p)
+		{
+			SpatialJoin::Predicate predicate =
+				static_cast<SpatialJoin::Predicate>(p);
+			PairList expected = bruteForce(predicate, geoms1, geoms2);
+
+			PairCollector collector;
+			std::size_t count = join.join(predicate, collector);
+			std::sort(collector.pairs.begin(), collector.pairs.end());
+			ensure_equals(count, expected.size());
+			ensure(collector.pairs == expected);
+		}
+	}
+
+	// 2 - The same pairs found in parts
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		std::vector<const Geometry*> geoms1, geoms2;
+		addRandomGeometries(geoms1, 300);
+		addRandomGeometries(geoms2, 300);
+		SpatialJoin join(geoms1, geoms2);
+
+		PairList expected =
+			bruteForce(SpatialJoin::INTERSECTS, geoms1, geoms2);
+		ensure(! expected.empty());
+
+		PairCollector collector;
+		std::size_t count = 0;
+		for (std::size_t part = 0; part < 5; ++part)
+			count += join.join(SpatialJoin::INTERSECTS, collector, part, 5);
+		std::sort(collector.pairs.begin(), collector.pairs.end());
+		ensure_equals(count, expected.size());
+		ensure(collector.pairs == expected);
+	}
+
+	// 3 - Null and empty geometries, empty collections, bad arguments
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		std::vector<const Geometry*> geoms1, geoms2, none;
+		geoms1.push_back(0);
+		geoms1.push_back(read("POLYGON EMPTY"));
+		geoms1.push_back(read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"));
+		geoms2.push_back(read("POINT(5 5)"));
+		geoms2.push_back(0);
+		geoms2.push_back(read("POINT EMPTY"));
+		geoms2.push_back(read("POINT(20 20)"));
+
+		SpatialJoin join(geoms1, geoms2);
+		PairCollector collector;
+		ensure_equals(join.join(SpatialJoin::CONTAINS, collector), 1u);
+		ensure(collector.pairs[0] == std::make_pair(std::size_t(2),
+		                                            std::size_t(0)));
+
+		SpatialJoin emptyJoin(geoms1, none);
+		ensure_equals(emptyJoin.join(SpatialJoin::INTERSECTS, collector), 0u);
+
+		try
+		{
+			join.join(SpatialJoin::INTERSECTS, collector, 2, 2);
+			fail("IllegalArgumentException expected");
+		}
+		catch (const geos::util::IllegalArgumentException&)
+		{
+		}
+	}
+
+} // namespace tut
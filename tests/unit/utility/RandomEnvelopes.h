@@ -0,0 +1,56 @@
+// 
+// Deterministic pseudo-random values and envelopes for the unit tests
+//
+#ifndef GEOS_TUT_RANDOMENVELOPES_H_INCLUDED
+#define GEOS_TUT_RANDOMENVELOPES_H_INCLUDED
+
+// geos
+#include <geos/geom/Envelope.h>
+// std
+#include <vector>
+#include <cstddef>
+
+namespace tut
+{
+
+//
+// Values of a linear congruential generator, the same on every
+// platform, so that a failing test fails everywhere
+//
+struct RandomValues
+{
+	unsigned int seed;
+
+	RandomValues() : seed(1) {}
+
+	// Deterministic values in [0, 1)
+	double random()
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return (seed >> 8) / 16777216.0;
+	}
+};
+
+//
+// Envelopes with their lower left corner in [0, 1000) x [0, 1000)
+//
+struct RandomEnvelopes : public RandomValues
+{
+	std::vector<geos::geom::Envelope> envs;
+
+	// Appends n envelopes with sides in [0, size)
+	void addRandomEnvelopes(std::size_t n, double size)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			double x = random() * 1000;
+			double y = random() * 1000;
+			envs.push_back(geos::geom::Envelope(x, x + random() * size,
+			                                    y, y + random() * size));
+		}
+	}
+};
+
+} // namespace tut
+
+#endif // #ifndef GEOS_TUT_RANDOMENVELOPES_H_INCLUDED